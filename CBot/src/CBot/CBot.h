@@ -25,8 +25,11 @@
 
 #include "CBot/CBotFileUtils.h"
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
+#include "CBot/CBotProfiler.h"
 #include "CBot/CBotToken.h"
 #include "CBot/CBotProgram.h"
+#include "CBot/CBotSnapshot.h"
 #include "CBot/CBotTypResult.h"
 
 #include "CBot/CBotVar/CBotVar.h"
@@ -21,6 +21,7 @@
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotToken.h"
 #include "CBot/CBotExternalCall.h"
 
@@ -164,13 +165,12 @@ void CBotCStack::SetType(CBotTypResult& type)
 CBotVar* CBotCStack::FindVar(CBotToken* &pToken)
 {
     CBotCStack*    p = this;
-    const auto&    name = pToken->GetString();
 
     while (p != nullptr)
     {
         if (p->m_bBlock) for (auto& var : p->m_listVar)
         {
-            if (name == var->GetName()) return var.get();
+            if (var->GetToken()->HasSameName(*pToken)) return var.get();
         }
         p = p->m_prev;
     }
@@ -353,14 +353,13 @@ void CBotCStack::CreateMemberVars(CBotClass* pClass, bool setDefined)
 bool CBotCStack::CheckVarLocal(CBotToken* &pToken)
 {
     CBotCStack*    p = this;
-    const auto&    name = pToken->GetString();
 
     // find the level of the current block
     while (p != nullptr && p->m_bBlock == 0) p = p->m_prev;
 
     if (p != nullptr) for (auto& var : p->m_listVar)
     {
-        if (name == var->GetName()) return true;
+        if (var->GetToken()->HasSameName(*pToken)) return true;
     }
     return false;
 }
@@ -406,7 +405,7 @@ bool CBotCStack::CheckCall(CBotToken* &pToken, CBotDefParam* pParam, const std::
         }
     }
 
-    for (CBotFunction* pp : CBotFunction::m_publicFunctions)
+    for (CBotFunction* pp : CBotContext::GetCurrent().GetPublicFunctions())
     {
         if ( name == pp->GetName() )
         {
@@ -32,6 +32,7 @@ namespace CBot
 {
 
 class CBotCallMethode;
+class CBotContext;
 class CBotFunction;
 class CBotProgram;
 class CBotStack;
@@ -196,7 +197,7 @@ public:
     static CBotClass* Find(CBotToken* &pToken);
 
     /*!
-     * \brief Find
+     * \brief Find a class by name in the current context, see CBotContext::FindClass()
      * \param name
      * \return
      */
@@ -332,12 +333,12 @@ public:
     void Purge();
 
     /*!
-     * \brief Free
+     * \brief Deletes all classes of the current context
      */
     static void ClearPublic();
 
     /*!
-     * \brief Save all static variables from each public class
+     * \brief Save all static variables from each public class of the current context
      * \param ostr Output stream
      * \return true on success
      */
@@ -364,7 +365,7 @@ public:
     void Unlock();
 
     /**
-     * \brief Release all locks in all classes held by this program
+     * \brief Release all locks in all classes of the current context held by this program
      * \param prog Program to release the locks from
      */
     static void FreeLock(CBotProgram* prog);
@@ -381,8 +382,8 @@ public:
     void Update(CBotVar* var, void* user);
 
 private:
-    //! List of all public classes
-    static std::set<CBotClass*> m_publicClasses;
+    //! Context the class is defined in
+    CBotContext* m_context;
 
 
     //! true if this class is fully compiled, false if only precompiled
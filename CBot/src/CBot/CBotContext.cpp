@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotContext.h"
+
+#include "CBot/CBotClass.h"
+#include "CBot/CBotToken.h"
+
+#include "CBot/CBotVar/CBotVarClass.h"
+
+#include "CBot/stdlib/stdlib_public.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace CBot
+{
+
+namespace
+{
+thread_local CBotContext* g_currentContext = nullptr;
+} // namespace
+
+CBotContext::CBotContext(GlobalTag)
+    : m_symbols(CBotToken::GetWordKeywords())
+{
+}
+
+CBotContext::CBotContext()
+    : m_parent(&GetGlobal()),
+      m_symbols(CBotToken::GetWordKeywords())
+{
+    // identifiers must not collide with the ones of global classes
+    m_identCounter = m_parent->m_identCounter;
+}
+
+CBotContext::~CBotContext()
+{
+    Scope scope(*this);
+    ClearClasses();
+}
+
+CBotContext& CBotContext::GetGlobal()
+{
+    static CBotContext global{GlobalTag()};
+    return global;
+}
+
+CBotContext& CBotContext::GetCurrent()
+{
+    if (g_currentContext != nullptr) return *g_currentContext;
+    return GetGlobal();
+}
+
+CBotContext::Scope::Scope(CBotContext& context)
+    : m_previous(g_currentContext)
+{
+    g_currentContext = &context;
+}
+
+CBotContext::Scope::~Scope()
+{
+    g_currentContext = m_previous;
+}
+
+long CBotContext::NextUniqNum()
+{
+    if (++m_identCounter < 10000) m_identCounter = 10000;
+    return m_identCounter;
+}
+
+long CBotContext::GetLastUniqNum() const
+{
+    return m_identCounter;
+}
+
+void CBotContext::SkipUniqNums(long last)
+{
+    m_identCounter = std::max(m_identCounter, last);
+}
+
+void CBotContext::AddClass(CBotClass* pClass)
+{
+    m_classes.insert(pClass);
+}
+
+void CBotContext::RemoveClass(CBotClass* pClass)
+{
+    m_classes.erase(pClass);
+}
+
+CBotClass* CBotContext::FindClass(const std::string& name)
+{
+    for (CBotClass* p : m_classes)
+    {
+        if ( p->GetName() == name ) return p;
+    }
+
+    if (m_parent != nullptr) return m_parent->FindClass(name);
+    return nullptr;
+}
+
+const std::set<CBotClass*>& CBotContext::GetClasses()
+{
+    return m_classes;
+}
+
+void CBotContext::ClearClasses()
+{
+    while ( !m_classes.empty() )
+    {
+        delete *m_classes.begin(); // calling destructor removes the class from the list
+    }
+}
+
+void CBotContext::AddPublicFunction(CBotFunction* func)
+{
+    m_publicFunctions.insert(func);
+}
+
+void CBotContext::RemovePublicFunction(CBotFunction* func)
+{
+    m_publicFunctions.erase(func);
+}
+
+const std::set<CBotFunction*>& CBotContext::GetPublicFunctions()
+{
+    return m_publicFunctions;
+}
+
+void CBotContext::AddInstance(CBotVarClass* instance)
+{
+    m_instances.emplace(instance->m_ItemIdent, instance);
+}
+
+void CBotContext::RemoveInstance(CBotVarClass* instance)
+{
+    auto range = m_instances.equal_range(instance->m_ItemIdent);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == instance)
+        {
+            m_instances.erase(it);
+            return;
+        }
+    }
+}
+
+CBotVarClass* CBotContext::FindInstance(long id)
+{
+    auto it = m_instances.find(id);
+    return it != m_instances.end() ? it->second : nullptr;
+}
+
+bool CBotContext::DefineNum(const std::string& name, long val)
+{
+    long existing;
+    if (FindDefineNum(name, existing))
+    {
+        // TODO: No access to the logger from CBot library :(
+        printf("CBOT WARNING: %s redefined\n", name.c_str());
+        return false;
+    }
+
+    m_defineNum[m_symbols.Intern(name)] = val;
+    return true;
+}
+
+bool CBotContext::FindDefineNum(std::string_view name, long& val)
+{
+    int symbol = m_symbols.Find(name);
+    if (symbol != CBotSymbolTable::NO_SYMBOL)
+    {
+        auto it = m_defineNum.find(symbol);
+        if (it != m_defineNum.end())
+        {
+            val = it->second;
+            return true;
+        }
+    }
+
+    if (m_parent != nullptr) return m_parent->FindDefineNum(name, val);
+    return false;
+}
+
+bool CBotContext::FindDefineNum(int symbol, long& val)
+{
+    auto it = m_defineNum.find(symbol);
+    if (it != m_defineNum.end())
+    {
+        val = it->second;
+        return true;
+    }
+
+    // the global context has a table of its own
+    if (m_parent != nullptr) return m_parent->FindDefineNum(m_symbols.GetText(symbol), val);
+    return false;
+}
+
+void CBotContext::ClearDefineNum()
+{
+    m_defineNum.clear();
+}
+
+CBotSymbolTable& CBotContext::GetSymbols()
+{
+    return m_symbols;
+}
+
+void CBotContext::SetFileAccessHandler(std::unique_ptr<CBotFileAccessHandler> fileHandler)
+{
+    m_fileHandler = std::move(fileHandler);
+}
+
+CBotFileAccessHandler* CBotContext::GetFileAccessHandler()
+{
+    if (m_fileHandler == nullptr && m_parent != nullptr) return m_parent->GetFileAccessHandler();
+    return m_fileHandler.get();
+}
+
+int CBotContext::AddFile(std::unique_ptr<CBotFile> file)
+{
+    int handle = m_nextFileId++;
+    m_files[handle] = std::move(file);
+    return handle;
+}
+
+CBotFile* CBotContext::GetFile(int handle)
+{
+    auto it = m_files.find(handle);
+    if (it == m_files.end()) return nullptr;
+    return it->second.get();
+}
+
+bool CBotContext::RemoveFile(int handle)
+{
+    return m_files.erase(handle) > 0;
+}
+
+void CBotContext::SetCompileUserPtr(void* user)
+{
+    m_compileUser = user;
+}
+
+void* CBotContext::GetCompileUserPtr()
+{
+    return m_compileUser;
+}
+
+} // namespace CBot
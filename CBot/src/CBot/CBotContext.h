@@ -0,0 +1,232 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "CBot/CBotSymbolTable.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace CBot
+{
+
+class CBotClass;
+class CBotFile;
+class CBotFileAccessHandler;
+class CBotFunction;
+class CBotVarClass;
+
+/**
+ * \brief Mutable state of the CBot runtime
+ *
+ * A context holds everything that programs share at compile and run time:
+ * public classes and functions, constants defined with CBotProgram::DefineNum(),
+ * the list of class instances (used to restore pointers from saved state), the counter
+ * of unique variable identifiers and files opened by the file class.
+ *
+ * Identifiers of programs compiled in a context are interned in its own symbol table, see GetSymbols().
+ *
+ * Programs created with a context (see CBotProgram::CBotProgram(CBotContext&, CBotVar*))
+ * only see definitions from that context, so programs in different contexts can be compiled
+ * and run concurrently on different threads. Programs sharing one context must be used from
+ * one thread at a time.
+ *
+ * Everything defined outside of a program, in particular by CBotProgram::Init() and by
+ * the application, goes to the global context. Other contexts also see classes, constants
+ * and the file access handler of the global context, so it must not be modified while they
+ * are in use.
+ */
+class CBotContext
+{
+public:
+    /**
+     * \brief Creates a new context on top of the global one
+     */
+    CBotContext();
+    /**
+     * \brief Destructor, deletes classes still defined in this context
+     *
+     * Programs using this context must be destroyed before.
+     */
+    ~CBotContext();
+
+    CBotContext(const CBotContext&) = delete;
+    CBotContext& operator=(const CBotContext&) = delete;
+
+    /**
+     * \brief Returns the global context
+     */
+    static CBotContext& GetGlobal();
+    /**
+     * \brief Returns the context of the program being compiled or run on this thread, the global context otherwise
+     */
+    static CBotContext& GetCurrent();
+
+    /**
+     * \brief Makes given context current on this thread for the lifetime of this object
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(CBotContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CBotContext* m_previous;
+    };
+
+    //! \name Unique identifiers
+    //@{
+    /**
+     * \brief Returns a new unique identifier of a variable, function or class instance
+     */
+    long NextUniqNum();
+    //! Returns the last identifier given by NextUniqNum()
+    long GetLastUniqNum() const;
+    //! Makes NextUniqNum() return identifiers greater than given one, used when restoring saved state
+    void SkipUniqNums(long last);
+    //@}
+
+    //! \name Classes
+    //@{
+    void AddClass(CBotClass* pClass);
+    void RemoveClass(CBotClass* pClass);
+    /**
+     * \brief Finds class by name in this context, then in the global context
+     */
+    CBotClass* FindClass(const std::string& name);
+    /**
+     * \brief Returns classes defined in this context only
+     */
+    const std::set<CBotClass*>& GetClasses();
+    /**
+     * \brief Deletes all classes defined in this context
+     */
+    void ClearClasses();
+    //@}
+
+    //! \name Public functions
+    //@{
+    void AddPublicFunction(CBotFunction* func);
+    void RemovePublicFunction(CBotFunction* func);
+    const std::set<CBotFunction*>& GetPublicFunctions();
+    //@}
+
+    //! \name Class instances
+    //@{
+    /**
+     * \brief Registers class instance under its current identifier
+     *
+     * The instance must be removed before its identifier changes, see CBotVarClass::SetIdent()
+     */
+    void AddInstance(CBotVarClass* instance);
+    void RemoveInstance(CBotVarClass* instance);
+    /**
+     * \brief Finds class instance by its unique identifier
+     */
+    CBotVarClass* FindInstance(long id);
+    //@}
+
+    //! \name Constants
+    //@{
+    /**
+     * \brief Defines a constant, fails if it is already defined here or in the global context
+     */
+    bool DefineNum(const std::string& name, long val);
+    /**
+     * \brief Finds a constant in this context, then in the global context
+     */
+    bool FindDefineNum(std::string_view name, long& val);
+    /**
+     * \brief Finds a constant by the symbol of its name in GetSymbols() of this context
+     */
+    bool FindDefineNum(int symbol, long& val);
+    void ClearDefineNum();
+    //@}
+
+    //! \name Symbols
+    //@{
+    /**
+     * \brief Returns table of identifiers interned by CBotToken::CompileTokens() in this context
+     */
+    CBotSymbolTable& GetSymbols();
+    //@}
+
+    //! \name Files
+    //@{
+    void SetFileAccessHandler(std::unique_ptr<CBotFileAccessHandler> fileHandler);
+    /**
+     * \brief Returns file access handler of this context or of the global context
+     */
+    CBotFileAccessHandler* GetFileAccessHandler();
+    /**
+     * \brief Stores an opened file, returns its handle
+     */
+    int AddFile(std::unique_ptr<CBotFile> file);
+    /**
+     * \brief Returns file by handle, nullptr if it is not open
+     */
+    CBotFile* GetFile(int handle);
+    /**
+     * \brief Closes the file, returns false if it was not open
+     */
+    bool RemoveFile(int handle);
+    //@}
+
+    //! \name Compilation
+    //@{
+    /**
+     * \brief Sets user pointer passed to compile functions of external calls, see CBotProgram::Compile()
+     */
+    void SetCompileUserPtr(void* user);
+    void* GetCompileUserPtr();
+    //@}
+
+private:
+    struct GlobalTag {};
+    explicit CBotContext(GlobalTag);
+
+    //! Global context, nullptr for the global context itself
+    CBotContext* m_parent = nullptr;
+
+    long m_identCounter = 0;
+
+    std::set<CBotClass*> m_classes;
+    std::set<CBotFunction*> m_publicFunctions;
+    //! Class instances by their identifier, Copy() and restoring state can give two instances the same one
+    std::unordered_multimap<long, CBotVarClass*> m_instances;
+    //! Constants by symbol of their name in m_symbols
+    std::unordered_map<int, long> m_defineNum;
+    CBotSymbolTable m_symbols;
+
+    std::unique_ptr<CBotFileAccessHandler> m_fileHandler;
+    std::unordered_map<int, std::unique_ptr<CBotFile>> m_files;
+    int m_nextFileId = 1;
+
+    void* m_compileUser = nullptr;
+};
+
+} // namespace CBot
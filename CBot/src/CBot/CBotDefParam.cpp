@@ -26,6 +26,7 @@
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotVar/CBotVarClass.h"
+#include "CBot/CBotVar/CBotVarString.h"
 
 #include <cassert>
 
@@ -102,7 +103,7 @@ CBotDefParam* CBotDefParam::Compile(CBotToken* &p, CBotCStack* pStack)
                     if (!pStack->IsOk()) break;
 
                     if ( type.Eq(CBotTypArrayPointer) ) type.SetType(CBotTypArrayBody);
-                    CBotVar*    var = CBotVar::Create(pp->GetString(), type);       // creates the variable
+                    CBotVar*    var = CBotVar::Create(*pp, type);                    // creates the variable
                     var->SetInit(CBotVar::InitType::IS_POINTER);                                    // mark initialized
                     param->m_nIdent = CBotVar::NextUniqNum();
                     var->SetUniqNum(param->m_nIdent);
@@ -162,7 +163,7 @@ bool CBotDefParam::Execute(CBotVar** ppVars, CBotStack* &pj)
         pile->SetState(1); // mark this param done
 
         // creates a local variable on the stack
-        CBotVar*    newvar = CBotVar::Create(p->m_token.GetString(), p->m_type);
+        CBotVar*    newvar = CBotVar::Create(p->m_token, p->m_type);
 
         // serves to make the transformation of types:
         if ((useDefault && pVar != nullptr) ||
@@ -199,7 +200,10 @@ bool CBotDefParam::Execute(CBotVar** ppVars, CBotStack* &pj)
                 newvar->SetInit(pVar->GetInit()); // copy nan
                 break;
             case CBotTypString:
-                newvar->SetValString(pVar->GetValString());
+                if (pVar->GetType() == CBotTypString)
+                    static_cast<CBotVarString*>(newvar)->SetValString(static_cast<CBotVarString*>(pVar));
+                else
+                    newvar->SetValString(pVar->GetValString());
                 break;
             case CBotTypBoolean:
                 newvar->SetValInt(pVar->GetValInt());
@@ -19,6 +19,7 @@
 
 #include "CBot/CBotExternalCall.h"
 
+#include "CBot/CBotContext.h"
 #include "CBot/CBotToken.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
@@ -42,13 +43,14 @@ bool CBotExternalCallList::AddFunction(const std::string& name, std::unique_ptr<
 
 CBotTypResult CBotExternalCallList::CompileCall(CBotToken*& p, CBotVar* thisVar, CBotVar** ppVar, CBotCStack* pStack)
 {
-    if (m_list.count(p->GetString()) == 0)
+    auto it = m_list.find(p->GetString());
+    if (it == m_list.end())
         return -1;
 
-    CBotExternalCall* pt = m_list[p->GetString()].get();
+    CBotExternalCall* pt = it->second.get();
 
     std::unique_ptr<CBotVar> args = std::unique_ptr<CBotVar>(MakeListVars(ppVar));
-    CBotTypResult r = pt->Compile(thisVar, args.get(), m_user);
+    CBotTypResult r = pt->Compile(thisVar, args.get(), CBotContext::GetCurrent().GetCompileUserPtr());
 
     // if a class is returned, it is actually a pointer
     if (r.GetType() == CBotTypClass) r.SetType(CBotTypPointer);
@@ -61,11 +63,6 @@ CBotTypResult CBotExternalCallList::CompileCall(CBotToken*& p, CBotVar* thisVar,
     return r;
 }
 
-void CBotExternalCallList::SetUserPtr(void* pUser)
-{
-    m_user = pUser;
-}
-
 bool CBotExternalCallList::CheckCall(const std::string& name)
 {
     return m_list.count(name) > 0;
@@ -77,10 +74,11 @@ int CBotExternalCallList::DoCall(CBotToken* token, CBotVar* thisVar, CBotVar** p
     if (token == nullptr)
         return -1;
 
-    if (m_list.count(token->GetString()) == 0)
+    auto it = m_list.find(token->GetString());
+    if (it == m_list.end())
         return -1;
 
-    CBotExternalCall* pt = m_list[token->GetString()].get();
+    CBotExternalCall* pt = it->second.get();
 
     if (thisVar == nullptr && pStack->IsCallFinished()) return true;  // only for non-method external call
 
@@ -106,10 +104,11 @@ int CBotExternalCallList::DoCall(CBotToken* token, CBotVar* thisVar, CBotVar** p
 
 bool CBotExternalCallList::RestoreCall(CBotToken* token, CBotVar* thisVar, CBotVar** ppVar, CBotStack* pStack)
 {
-    if (m_list.count(token->GetString()) == 0)
+    auto it = m_list.find(token->GetString());
+    if (it == m_list.end())
         return false;
 
-    CBotExternalCall* pt = m_list[token->GetString()].get();
+    CBotExternalCall* pt = it->second.get();
 
     // if this is a method call we need to use RestoreStack()
     CBotStack* pile = (thisVar != nullptr) ? pStack->RestoreStack() : pStack->RestoreStackEOX(pt);
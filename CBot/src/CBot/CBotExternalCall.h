@@ -155,7 +155,9 @@ public:
     /**
      * \brief Find and call compile function
      *
-     * This function sets an error in compilation stack in case of failure
+     * This function sets an error in compilation stack in case of failure.
+     * The compile function gets the user pointer given to CBotProgram::Compile(),
+     * see CBotContext::GetCompileUserPtr().
      *
      * \param p Token representing the function name
      * \param thisVar "this" variable for class calls, nullptr for normal calls
@@ -197,15 +199,6 @@ public:
      */
     bool RestoreCall(CBotToken* token, CBotVar* thisVar, CBotVar** ppVar, CBotStack* pStack);
 
-    /**
-     * \brief Set user pointer to pass to compile functions
-     *
-     * This is for compile functions only, runtime functions use CBotStack::GetUserPtr()
-     *
-     * \param pUser User pointer
-     */
-    void SetUserPtr(void* pUser);
-
     /**
      * \brief Reset the list of registered functions
      */
@@ -213,7 +206,6 @@ public:
 
 private:
     std::map<std::string, std::unique_ptr<CBotExternalCall>> m_list{};
-    void* m_user = nullptr;
 };
 
 } // namespace CBot
@@ -92,15 +92,13 @@ bool CBotCase::Execute(CBotStack* &pj)
     if (m_instr == nullptr) return true;
     CBotStack* pile = pj->AddStack(this, CBotStack::BlockVisibilityType::BLOCK);
 
-    int state = pile->GetState();
-    CBotInstr* p = m_instr;
-    while (state-- > 0) p = p->GetNext();
+    CBotInstr* p = pile->GetResumeInstr(m_instr);
 
     while (p != nullptr)
     {
         if (!p->Execute(pile)) return false;
-        pile->IncState();
         p = p->GetNext();
+        pile->IncState(p);
     }
 
     pile->Delete();
@@ -30,6 +30,7 @@
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotDefParam.h"
 #include "CBot/CBotUtils.h"
 
@@ -54,9 +55,6 @@ CBotFunction::CBotFunction()
     m_bSynchro    = false;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-std::set<CBotFunction*> CBotFunction::m_publicFunctions{};
-
 ////////////////////////////////////////////////////////////////////////////////
 CBotFunction::~CBotFunction()
 {
@@ -64,9 +62,9 @@ CBotFunction::~CBotFunction()
     delete m_block;                // the instruction block
 
     // remove public list if there is
-    if (m_bPublic)
+    if (m_publicContext != nullptr)
     {
-        m_publicFunctions.erase(this);
+        m_publicContext->RemovePublicFunction(this);
     }
 }
 
@@ -531,7 +529,7 @@ CBotFunction* CBotFunction::FindLocalOrPublic(const std::list<CBotFunction*>& lo
         }
 
         // search the list of public functions
-        for (CBotFunction* pt : m_publicFunctions)
+        for (CBotFunction* pt : CBotContext::GetCurrent().GetPublicFunctions())
         {
             if (pt->m_nFuncIdent == nIdent)
             {
@@ -641,7 +639,7 @@ void CBotFunction::SearchPublic(const std::string& name, CBotVar** ppVars, CBotT
                                 std::map<CBotFunction*, int>& funcMap, CBotClass* pClass)
 {
     {
-        for (CBotFunction* pt : m_publicFunctions)
+        for (CBotFunction* pt : CBotContext::GetCurrent().GetPublicFunctions())
         {
             if ( pt->m_token.GetString() == name )
             {
@@ -979,7 +977,7 @@ CBotFunction* CBotFunction::FindMethod(long& nIdent, const std::string& name,
         // search the list of public functions
         if (!skipPublic)
         {
-            for (CBotFunction* pt : m_publicFunctions)
+            for (CBotFunction* pt : CBotContext::GetCurrent().GetPublicFunctions())
             {
                 if (pt->m_nFuncIdent == nIdent)
                 {
@@ -1214,7 +1212,8 @@ const std::string& CBotFunction::GetClassName() const
 ////////////////////////////////////////////////////////////////////////////////
 void CBotFunction::AddPublic(CBotFunction* func)
 {
-    m_publicFunctions.insert(func);
+    func->m_publicContext = &CBotContext::GetCurrent();
+    func->m_publicContext->AddPublicFunction(func);
 }
 
 bool CBotFunction::HasReturn()
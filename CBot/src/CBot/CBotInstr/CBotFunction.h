@@ -26,6 +26,8 @@
 namespace CBot
 {
 
+class CBotContext;
+
 /**
  * \brief A function declaration in the code
  *
@@ -254,7 +256,7 @@ public:
     bool CheckParam(CBotDefParam* pParam);
 
     /*!
-     * \brief AddPublic
+     * \brief Adds function to public functions of the current context
      * \param pfunc
      */
     static void AddPublic(CBotFunction* pfunc);
@@ -358,8 +360,8 @@ private:
     CBotToken m_openblk;
     CBotToken m_closeblk;
 
-    //! List of public functions
-    static std::set<CBotFunction*> m_publicFunctions;
+    //! Context the function was made public in, see AddPublic()
+    CBotContext* m_publicContext = nullptr;
 
     friend class CBotProgram;
     friend class CBotClass;
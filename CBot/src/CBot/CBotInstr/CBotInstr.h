@@ -307,14 +307,15 @@ protected:
     CBotInstr* m_next3b;
 
     //! Counter of nested loops, to determine the break and continue valid.
-    static int m_LoopLvl;
+    //! Only used during compilation, which may run on several threads, see CBotContext.
+    static thread_local int m_LoopLvl;
     friend class CBotDefClass;
     friend class CBotDefInt;
     friend class CBotListArray;
 
 private:
     //! List of labels used.
-    static std::vector<std::string> m_labelLvl;
+    static thread_local std::vector<std::string> m_labelLvl;
 };
 
 } // namespace CBot
@@ -85,17 +85,14 @@ CBotInstr* CBotListExpression::Compile(CBotToken* &p, CBotCStack* pStack)
 bool CBotListExpression::Execute(CBotStack* &pj)
 {
     CBotStack*  pile = pj->AddStack();                          // essential
-    CBotInstr*  p = m_expr;                                     // the first expression
-
-    int     state = pile->GetState();
-    while (state-->0) p = p->GetNext();                         // returns to the interrupted operation
+    CBotInstr*  p = pile->GetResumeInstr(m_expr);              // returns to the interrupted operation
 
     if ( p != nullptr ) while (true)
     {
         if ( !p->Execute(pile) ) return false;
         p = p->GetNext();
         if ( p == nullptr ) break;
-        if (!pile->IncState()) return false;                    // ready for next
+        if (!pile->IncState(p)) return false;                   // ready for next
     }
     return pj->Return(pile);
 }
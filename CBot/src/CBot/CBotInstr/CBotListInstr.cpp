@@ -81,17 +81,14 @@ bool CBotListInstr::Execute(CBotStack* &pj)
     if (pile->StackOver() ) return pj->Return( pile);
 
 
-    CBotInstr*    p = m_instr;                                    // the first expression
-
-    int        state = pile->GetState();
-    while (state-->0) p = p->GetNext();                            // returns to the interrupted operation
+    CBotInstr*    p = pile->GetResumeInstr(m_instr);            // returns to the interrupted operation
 
     if (p != nullptr) while (true)
     {
         if (!p->Execute(pile)) return false;
         p = p->GetNext();
         if (p == nullptr) break;
-        (void)pile->IncState();                                  // ready for next
+        (void)pile->IncState(p);                                 // ready for next
     }
 
     return pj->Return(pile);
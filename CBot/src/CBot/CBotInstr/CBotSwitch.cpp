@@ -160,15 +160,13 @@ bool CBotSwitch :: Execute(CBotStack* &pj)
 
     auto it = m_labels.find(pile1->GetVar()->GetValLong());
 
-    CBotInstr* p = (it != m_labels.end()) ? it->second : m_default;
-
-    while (--state > 0) p = p->GetNext();
+    CBotInstr* p = pile1->GetResumeInstr((it != m_labels.end()) ? it->second : m_default, 1);
 
     while( p != nullptr )
     {
         if ( !p->Execute(pile1) ) return pj->BreakReturn(pile1);
-        if ( !pile1->IncState() ) return false;
         p = p->GetNext();
+        if ( !pile1->IncState(p) ) return false;
     }
     return pj->Return(pile1);
 }
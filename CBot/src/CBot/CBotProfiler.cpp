@@ -0,0 +1,234 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotProfiler.h"
+
+#include "CBot/CBotStack.h"
+#include "CBot/CBotToken.h"
+
+#include "CBot/CBotInstr/CBotInstr.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace CBot
+{
+
+thread_local CBotProfiler* CBotProfiler::m_active = nullptr;
+std::atomic<int> CBotProfiler::m_running{0};
+
+namespace
+{
+
+void SortByInstructions(std::vector<CBotProfileEntry>& entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const CBotProfileEntry& a, const CBotProfileEntry& b)
+    {
+        if (a.instructions != b.instructions) return a.instructions > b.instructions;
+        return a.start < b.start;
+    });
+}
+
+//! Writes position in the program text as line:column
+void DumpLocation(std::ostream& ostr, const std::string& source, int position)
+{
+    position = std::clamp(position, 0, static_cast<int>(source.size()));
+    int line = 1 + static_cast<int>(std::count(source.begin(), source.begin() + position, '\n'));
+    auto lineStart = source.rfind('\n', position > 0 ? position - 1 : 0);
+    int column = lineStart == std::string::npos || position == 0 ? position + 1 : position - static_cast<int>(lineStart);
+    ostr << line << ":" << column;
+}
+
+void DumpEntry(std::ostream& ostr, const CBotProfileEntry& entry, const CBotProfileEntry& total)
+{
+    float percent = total.instructions > 0 ? 100.0f * entry.instructions / total.instructions : 0.0f;
+    ostr << std::setw(12) << entry.instructions
+         << std::setw(7) << std::fixed << std::setprecision(1) << percent << "%"
+         << std::setw(11) << std::setprecision(3) << entry.time / 1e6 << " ms"
+         << std::setw(10) << entry.allocations << "  ";
+}
+
+} // namespace
+
+void CBotProfiler::Clear()
+{
+    m_positions.clear();
+    m_last = nullptr;
+    m_pendingAllocations = 0;
+}
+
+void CBotProfiler::Begin()
+{
+    m_last = nullptr;
+    m_lastTime = Clock::now();
+    if (m_active == nullptr) ++m_running;
+    m_active = this;
+}
+
+void CBotProfiler::End()
+{
+    if (m_last != nullptr)
+    {
+        m_last->entry.time += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_lastTime).count();
+        m_last = nullptr;
+    }
+    if (m_active == this)
+    {
+        m_active = nullptr;
+        --m_running;
+    }
+}
+
+void CBotProfiler::CountInstruction(CBotStack* stack)
+{
+    CBotInstr* instr = nullptr;
+    CBotInstr* function = nullptr;
+    stack->GetCurrentInstr(instr, function);
+
+    Position& position = GetPosition(instr, function);
+    Clock::time_point now = Clock::now();
+    position.entry.instructions++;
+    position.entry.time += std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastTime).count();
+    position.entry.allocations += m_pendingAllocations;
+    m_pendingAllocations = 0;
+    m_lastTime = now;
+    m_last = &position;
+}
+
+void CBotProfiler::CountActiveAllocation()
+{
+    CBotProfiler* profiler = m_active;
+    if (profiler == nullptr) return;
+
+    if (profiler->m_last != nullptr)
+        profiler->m_last->entry.allocations++;
+    else
+        profiler->m_pendingAllocations++;
+}
+
+CBotProfiler::Position& CBotProfiler::GetPosition(CBotInstr* instr, CBotInstr* function)
+{
+    auto it = m_positions.find(instr);
+    if (it != m_positions.end()) return it->second;
+
+    Position& position = m_positions[instr];
+    position.function = function;
+    if (function != nullptr)
+    {
+        position.entry.function = function->GetToken()->GetString();
+        position.functionStart = function->GetToken()->GetStart();
+        position.functionEnd = function->GetToken()->GetEnd();
+    }
+    if (instr != nullptr)
+    {
+        position.entry.start = instr->GetToken()->GetStart();
+        position.entry.end = instr->GetToken()->GetEnd();
+    }
+    return position;
+}
+
+CBotProfileEntry CBotProfiler::GetTotal() const
+{
+    CBotProfileEntry total;
+    for (const auto& [instr, position] : m_positions)
+    {
+        total.instructions += position.entry.instructions;
+        total.time += position.entry.time;
+        total.allocations += position.entry.allocations;
+    }
+    total.allocations += m_pendingAllocations;
+    return total;
+}
+
+std::vector<CBotProfileEntry> CBotProfiler::GetFunctions() const
+{
+    std::unordered_map<CBotInstr*, CBotProfileEntry> functions;
+    for (const auto& [instr, position] : m_positions)
+    {
+        auto it = functions.find(position.function);
+        if (it == functions.end())
+        {
+            it = functions.emplace(position.function, CBotProfileEntry()).first;
+            it->second.function = position.entry.function;
+            it->second.start = position.functionStart;
+            it->second.end = position.functionEnd;
+        }
+        it->second.instructions += position.entry.instructions;
+        it->second.time += position.entry.time;
+        it->second.allocations += position.entry.allocations;
+    }
+
+    std::vector<CBotProfileEntry> result;
+    result.reserve(functions.size());
+    for (auto& [function, entry] : functions)
+        result.push_back(std::move(entry));
+    SortByInstructions(result);
+    return result;
+}
+
+std::vector<CBotProfileEntry> CBotProfiler::GetPositions() const
+{
+    std::vector<CBotProfileEntry> result;
+    result.reserve(m_positions.size());
+    for (const auto& [instr, position] : m_positions)
+        result.push_back(position.entry);
+    SortByInstructions(result);
+    return result;
+}
+
+void CBotProfiler::Dump(std::ostream& ostr, const std::string& source, std::size_t maxPositions) const
+{
+    CBotProfileEntry total = GetTotal();
+    auto describe = [&](const CBotProfileEntry& entry)
+    {
+        ostr << (entry.function.empty() ? "?" : entry.function);
+        if (!source.empty())
+        {
+            ostr << ":";
+            DumpLocation(ostr, source, entry.start);
+        }
+        else
+            ostr << " @" << entry.start;
+        ostr << "\n";
+    };
+
+    ostr << "Instructions: " << total.instructions
+         << ", time: " << std::fixed << std::setprecision(3) << total.time / 1e6 << " ms"
+         << ", allocations: " << total.allocations << "\n";
+
+    ostr << "\nFunctions:\n";
+    ostr << std::setw(12) << "instr" << std::setw(8) << "%" << std::setw(14) << "time" << std::setw(10) << "allocs" << "\n";
+    for (const auto& entry : GetFunctions())
+    {
+        DumpEntry(ostr, entry, total);
+        describe(entry);
+    }
+
+    ostr << "\nHottest instructions:\n";
+    ostr << std::setw(12) << "instr" << std::setw(8) << "%" << std::setw(14) << "time" << std::setw(10) << "allocs" << "\n";
+    auto positions = GetPositions();
+    if (positions.size() > maxPositions) positions.resize(maxPositions);
+    for (const auto& entry : positions)
+    {
+        DumpEntry(ostr, entry, total);
+        describe(entry);
+    }
+}
+
+} // namespace CBot
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CBot
+{
+
+class CBotInstr;
+class CBotStack;
+
+/**
+ * \brief Execution statistics of a function or a source position, see CBotProfiler
+ */
+struct CBotProfileEntry
+{
+    //! Name of the function
+    std::string function;
+    //! Start of the source range in the program text, for functions the position of the function name
+    int start = 0;
+    //! End of the source range in the program text
+    int end = 0;
+    //! Number of instructions ("timer ticks") executed
+    long instructions = 0;
+    //! Wall time spent, in nanoseconds
+    long long time = 0;
+    //! Number of CBotVar instances created
+    long allocations = 0;
+};
+
+/**
+ * \brief Opt-in execution profiler of a CBotProgram
+ *
+ * When enabled with CBotProgram::SetProfiling(), every instruction tick of CBotStack
+ * (see CBotStack::SetState()) is attributed to the instruction being executed and to
+ * the function it belongs to. Wall time between two ticks is added to the instruction
+ * of the second one, and CBotVar instances created during Run() are added to the
+ * instruction executed last.
+ *
+ * Statistics are kept until Clear() or until the program is recompiled.
+ */
+class CBotProfiler
+{
+public:
+    /**
+     * \brief Resets all statistics
+     */
+    void Clear();
+
+    /**
+     * \brief Starts measuring, called at the beginning of CBotProgram::Run()
+     */
+    void Begin();
+    /**
+     * \brief Stops measuring, called at the end of CBotProgram::Run()
+     */
+    void End();
+
+    /**
+     * \brief Counts one instruction tick on the given stack level
+     */
+    void CountInstruction(CBotStack* stack);
+    /**
+     * \brief Counts creation of a CBotVar in the profiler currently running on this thread, if any
+     *
+     * When no profiler runs on any thread, this only reads a global counter.
+     */
+    static void CountAllocation()
+    {
+        if (m_running.load(std::memory_order_relaxed) != 0)
+            CountActiveAllocation();
+    }
+
+    /**
+     * \brief Returns totals of the whole program
+     */
+    CBotProfileEntry GetTotal() const;
+    /**
+     * \brief Returns statistics of every function executed, sorted by the number of instructions
+     */
+    std::vector<CBotProfileEntry> GetFunctions() const;
+    /**
+     * \brief Returns statistics of every instruction executed, sorted by the number of instructions
+     */
+    std::vector<CBotProfileEntry> GetPositions() const;
+
+    /**
+     * \brief Writes a text report of the statistics
+     * \param ostr Output stream
+     * \param source Program text, used to translate positions to line numbers if given
+     * \param maxPositions Maximum number of the hottest instructions to list
+     */
+    void Dump(std::ostream& ostr, const std::string& source = "", std::size_t maxPositions = 20) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Position
+    {
+        CBotProfileEntry entry;
+        //! Function the instruction belongs to, only used as a key
+        CBotInstr* function = nullptr;
+        int functionStart = 0;
+        int functionEnd = 0;
+    };
+
+    Position& GetPosition(CBotInstr* instr, CBotInstr* function);
+    static void CountActiveAllocation();
+
+    //! Instructions are only used as keys, so that functions of other programs may be recompiled meanwhile
+    std::unordered_map<CBotInstr*, Position> m_positions;
+    //! Position of the last counted instruction, receives allocations and remaining time
+    Position* m_last = nullptr;
+    Clock::time_point m_lastTime;
+    //! Allocations made before the first instruction of a Run() call
+    long m_pendingAllocations = 0;
+    //! Profiler of the program being run on this thread
+    static thread_local CBotProfiler* m_active;
+    //! Number of threads with an active profiler
+    static std::atomic<int> m_running;
+};
+
+} // namespace CBot
@@ -20,9 +20,11 @@
 #include "CBot/CBotVar/CBotVar.h"
 
 #include "CBot/CBotExternalCall.h"
+#include "CBot/CBotProfiler.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotUtils.h"
 
 #include "CBot/CBotInstr/CBotFunction.h"
@@ -37,16 +39,24 @@ namespace CBot
 std::unique_ptr<CBotExternalCallList> CBotProgram::m_externalCalls;
 
 CBotProgram::CBotProgram()
+: m_context(&CBotContext::GetCurrent())
 {
 }
 
 CBotProgram::CBotProgram(CBotVar* thisVar)
-: m_thisVar(thisVar)
+: m_context(&CBotContext::GetCurrent()), m_thisVar(thisVar)
+{
+}
+
+CBotProgram::CBotProgram(CBotContext& context, CBotVar* thisVar)
+: m_context(&context), m_thisVar(thisVar)
 {
 }
 
 CBotProgram::~CBotProgram()
 {
+    CBotContext::Scope scope(*m_context);
+
 //  delete  m_classes;
     for (CBotClass* c : m_classes)
         c->Purge();
@@ -60,6 +70,8 @@ CBotProgram::~CBotProgram()
 
 bool CBotProgram::Compile(const std::string& program, std::vector<std::string>& externFunctions, void* pUser)
 {
+    CBotContext::Scope scope(*m_context);
+
     // Cleanup the previously compiled program
     Stop();
 
@@ -71,6 +83,8 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
     for (CBotFunction* f : m_functions) delete f;
     m_functions.clear();
 
+    if (m_profiler != nullptr) m_profiler->Clear();
+
     externFunctions.clear();
     m_error = CBotNoErr;
 
@@ -82,7 +96,7 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
     CBotToken* p = tokens.get()->GetNext();                 // skips the first token (separator)
 
     pStack->SetProgram(this);                               // defined used routines
-    m_externalCalls->SetUserPtr(pUser);
+    m_context->SetCompileUserPtr(pUser);
 
     // Step 2. Find all function and class definitions
     while ( pStack->IsOk() && p != nullptr && p->GetType() != 0)
@@ -149,6 +163,8 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
 
 bool CBotProgram::Start(const std::string& name)
 {
+    CBotContext::Scope scope(*m_context);
+
     Stop();
 
     auto it = std::find_if(m_functions.begin(), m_functions.end(), [&name](CBotFunction* x) { return x->GetName() == name; });
@@ -182,6 +198,8 @@ bool CBotProgram::Run(void* pUser, int timer)
         return true;
     }
 
+    CBotContext::Scope scope(*m_context);
+
     m_error = CBotNoErr;
 
     m_stack->SetUserPtr(pUser);
@@ -190,6 +208,9 @@ bool CBotProgram::Run(void* pUser, int timer)
 
     m_stack->SetProgram(this);                     // bases for routines
 
+    m_stack->SetProfiler(m_profiler.get());
+    if (m_profiler != nullptr) m_profiler->Begin();
+
     // resumes execution on the top of the stack
     bool ok = m_stack->Execute();
     if (ok)
@@ -198,6 +219,10 @@ bool CBotProgram::Run(void* pUser, int timer)
         ok = m_entryPoint->Execute(nullptr, m_stack, m_thisVar);
     }
 
+    if (m_profiler != nullptr) m_profiler->End();
+
+    m_timerUsed = m_stack->GetTimerUsed();
+
     // completed on a mistake?
     if (ok || !m_stack->IsOk())
     {
@@ -212,8 +237,15 @@ bool CBotProgram::Run(void* pUser, int timer)
     return ok;
 }
 
+int CBotProgram::GetTimerUsed()
+{
+    return m_timerUsed;
+}
+
 void CBotProgram::Stop()
 {
+    CBotContext::Scope scope(*m_context);
+
     if (m_stack != nullptr)
     {
         m_stack->Delete();
@@ -223,6 +255,29 @@ void CBotProgram::Stop()
     CBotClass::FreeLock(this);
 }
 
+void CBotProgram::SetProfiling(bool enabled)
+{
+    if (!enabled)
+    {
+        m_profiler.reset();
+        if (m_stack != nullptr) m_stack->SetProfiler(nullptr);
+    }
+    else if (m_profiler == nullptr)
+    {
+        m_profiler = std::make_unique<CBotProfiler>();
+    }
+}
+
+bool CBotProgram::GetProfiling()
+{
+    return m_profiler != nullptr;
+}
+
+CBotProfiler* CBotProgram::GetProfiler()
+{
+    return m_profiler.get();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotProgram::GetRunPos(std::string& functionName, int& start, int& end)
 {
@@ -273,6 +328,11 @@ const std::list<CBotFunction*>& CBotProgram::GetFunctions()
     return m_functions;
 }
 
+CBotContext& CBotProgram::GetContext()
+{
+    return *m_context;
+}
+
 bool CBotProgram::ClassExists(std::string name)
 {
     for (CBotClass* p : m_classes)
@@ -326,6 +386,8 @@ bool CBotProgram::DefineNum(const std::string& name, long val)
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotProgram::SaveState(std::ostream &ostr)
 {
+    CBotContext::Scope scope(*m_context);
+
     if (!WriteLong(ostr, CBOTVERSION)) return false;
 
 
@@ -347,6 +409,8 @@ bool CBotProgram::RestoreState(std::istream &istr)
     unsigned short  w;
     std::string      s;
 
+    CBotContext::Scope scope(*m_context);
+
     Stop();
 
     long version;
@@ -31,6 +31,8 @@ namespace CBot
 
 class CBotFunction;
 class CBotClass;
+class CBotContext;
+class CBotProfiler;
 class CBotStack;
 class CBotTypResult;
 class CBotVar;
@@ -97,6 +99,13 @@ public:
      */
     CBotProgram(CBotVar* thisVar);
 
+    /**
+     * \brief Constructor
+     * \param context Context in which the program is compiled and run, see CBotContext
+     * \param thisVar Variable to pass to the program as "this"
+     */
+    CBotProgram(CBotContext& context, CBotVar* thisVar = nullptr);
+
     /**
      * \brief Destructor
      */
@@ -180,6 +189,13 @@ public:
      */
     bool Run(void* pUser = nullptr, int timer = -1);
 
+    /**
+     * \brief Returns the number of "timer ticks" used by the last call to Run()
+     *
+     * Lets the caller share a budget of ticks between many programs, see CBotStack::SetTimer()
+     */
+    int GetTimerUsed();
+
     /**
      * \brief Gives the current position in the executing program
      * \param[out] functionName Name of the currently executed function
@@ -189,6 +205,23 @@ public:
      */
     bool GetRunPos(std::string& functionName, int& start, int& end);
 
+    /**
+     * \brief Enables or disables collecting execution statistics in Run()
+     *
+     * Disabling discards statistics collected so far.
+     *
+     * \see CBotProfiler
+     */
+    void SetProfiling(bool enabled);
+    /**
+     * \brief Checks if execution statistics are collected
+     */
+    bool GetProfiling();
+    /**
+     * \brief Returns execution statistics collected so far, nullptr if profiling is disabled
+     */
+    CBotProfiler* GetProfiler();
+
     /**
      * \brief Provides the pointer to the variables on the execution stack
      * \param[out] functionName Name of the function that this stack is part of
@@ -326,6 +359,11 @@ public:
      */
     bool ClassExists(std::string name);
 
+    /**
+     * \brief Returns context in which this program is compiled and run
+     */
+    CBotContext& GetContext();
+
     /**
      * \brief Returns static list of all registered external calls
      */
@@ -334,6 +372,8 @@ public:
 private:
     //! All external calls
     static std::unique_ptr<CBotExternalCallList> m_externalCalls;
+    //! Context of this program
+    CBotContext* m_context;
     //! All user-defined functions
     std::list<CBotFunction*> m_functions{};
     //! The entry point function
@@ -344,10 +384,14 @@ private:
     CBotStack* m_stack = nullptr;
     //! "this" variable
     CBotVar* m_thisVar = nullptr;
+    //! Execution statistics, only if profiling is enabled
+    std::unique_ptr<CBotProfiler> m_profiler;
     friend class CBotFunction;
     friend class CBotDebug;
 
     CBotError m_error = CBotNoErr;
+    //! Ticks used by the last Run()
+    int m_timerUsed = 0;
     int m_errorStart = 0;
     int m_errorEnd = 0;
 };
@@ -0,0 +1,223 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotSnapshot.h"
+
+#include "CBot/CBotContext.h"
+#include "CBot/CBotProgram.h"
+
+#include <cstring>
+#include <streambuf>
+
+namespace CBot
+{
+
+namespace
+{
+
+const char SNAPSHOT_MAGIC[4] = { 'C', 'B', 'S', 'S' };
+const uint32_t SNAPSHOT_VERSION = 1;
+
+//! Size of the record header: key and data length
+const std::size_t RECORD_HEADER_SIZE = 8;
+
+void PutUInt32(char* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+uint32_t GetUInt32(const char* in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+bool WriteUInt32LE(std::ostream& ostr, uint32_t value)
+{
+    char bytes[4];
+    PutUInt32(bytes, value);
+    return static_cast<bool>(ostr.write(bytes, 4));
+}
+
+bool ReadUInt32LE(std::istream& istr, uint32_t& value)
+{
+    char bytes[4];
+    if (!istr.read(bytes, 4)) return false;
+    value = GetUInt32(bytes);
+    return true;
+}
+
+//! Reads a part of a buffer without copying it
+class InputBuffer : public std::streambuf
+{
+public:
+    InputBuffer(const char* data, std::size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+} // namespace
+
+//! Appends everything written to the snapshot's buffer
+class CBotSnapshot::OutputBuffer : public std::streambuf
+{
+public:
+    explicit OutputBuffer(CBotSnapshot& snapshot) : m_snapshot(snapshot) {}
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        m_snapshot.m_data.push_back(traits_type::to_char_type(c));
+        return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+        m_snapshot.m_data.insert(m_snapshot.m_data.end(), s, s + count);
+        return count;
+    }
+
+private:
+    CBotSnapshot& m_snapshot;
+};
+
+bool CBotSnapshot::Record::IsEmpty() const
+{
+    return !m_found;
+}
+
+bool CBotSnapshot::Record::Read(const std::function<bool(std::istream&)>& read) const
+{
+    if (!m_found) return false;
+
+    InputBuffer buffer(m_data.data(), m_data.size());
+    std::istream istr(&buffer);
+    return read(istr) && !istr.fail();
+}
+
+CBotSnapshot::CBotSnapshot()
+    : m_buffer(std::make_unique<OutputBuffer>(*this)),
+      m_stream(m_buffer.get())
+{
+}
+
+CBotSnapshot::~CBotSnapshot()
+{
+}
+
+void CBotSnapshot::Clear()
+{
+    m_data.clear();
+    m_records.clear();
+}
+
+std::ostream& CBotSnapshot::BeginRecord(long key)
+{
+    m_recordStart = m_data.size();
+    m_recordKey = key;
+    m_data.resize(m_recordStart + RECORD_HEADER_SIZE);
+    m_stream.clear();
+    return m_stream;
+}
+
+void CBotSnapshot::EndRecord()
+{
+    std::size_t start = m_recordStart + RECORD_HEADER_SIZE;
+    std::size_t length = m_data.size() - start;
+    PutUInt32(m_data.data() + m_recordStart, static_cast<uint32_t>(m_recordKey));
+    PutUInt32(m_data.data() + m_recordStart + 4, static_cast<uint32_t>(length));
+    m_records[m_recordKey] = { start, length };
+}
+
+void CBotSnapshot::CancelRecord()
+{
+    m_data.resize(m_recordStart);
+}
+
+bool CBotSnapshot::Write(std::ostream& ostr) const
+{
+    if (!ostr.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC))) return false;
+    if (!WriteUInt32LE(ostr, SNAPSHOT_VERSION)) return false;
+    if (!WriteUInt32LE(ostr, CBotProgram::GetVersion())) return false;
+    if (!WriteUInt32LE(ostr, CBotContext::GetCurrent().GetLastUniqNum())) return false;
+    if (!WriteUInt32LE(ostr, m_data.size())) return false;
+    return static_cast<bool>(ostr.write(m_data.data(), m_data.size()));
+}
+
+bool CBotSnapshot::Read(std::istream& istr)
+{
+    Clear();
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    if (!istr.read(magic, sizeof(magic))) return false;
+    if (std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0) return false;
+
+    uint32_t version, cbotVersion, lastUniqNum, size;
+    if (!ReadUInt32LE(istr, version) || version != SNAPSHOT_VERSION) return false;
+    if (!ReadUInt32LE(istr, cbotVersion) || cbotVersion != static_cast<uint32_t>(CBotProgram::GetVersion())) return false;
+    if (!ReadUInt32LE(istr, lastUniqNum)) return false;
+    if (!ReadUInt32LE(istr, size)) return false;
+
+    m_data.resize(size);
+    if (!istr.read(m_data.data(), size))
+    {
+        m_data.clear();
+        return false;
+    }
+
+    for (std::size_t position = 0; position < size;)
+    {
+        std::size_t length = 0;
+        if (size - position >= RECORD_HEADER_SIZE)
+            length = GetUInt32(m_data.data() + position + 4);
+
+        if (size - position < RECORD_HEADER_SIZE || length > size - position - RECORD_HEADER_SIZE)
+        {
+            Clear();
+            return false;
+        }
+
+        long key = static_cast<int32_t>(GetUInt32(m_data.data() + position));
+        m_records[key] = { position + RECORD_HEADER_SIZE, length };
+        position += RECORD_HEADER_SIZE + length;
+    }
+
+    CBotContext::GetCurrent().SkipUniqNums(lastUniqNum);
+    return true;
+}
+
+CBotSnapshot::Record CBotSnapshot::GetRecord(long key) const
+{
+    Record record;
+    auto it = m_records.find(key);
+    if (it == m_records.end()) return record;
+
+    auto begin = m_data.begin() + it->second.first;
+    record.m_data.assign(begin, begin + it->second.second);
+    record.m_found = true;
+    return record;
+}
+
+} // namespace CBot
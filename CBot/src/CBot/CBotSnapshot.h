@@ -0,0 +1,139 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace CBot
+{
+
+/**
+ * \brief Binary snapshot of the execution state of many programs, for saving and loading games
+ *
+ * The snapshot is a list of records, each one identified by a key (e.g. id of the robot
+ * running the program) and holding data written with the CBotFileUtils functions,
+ * usually by CBotProgram::SaveState(). Records are written one after another into
+ * a single buffer, which is kept between saves, so saving doesn't allocate once the buffer
+ * has grown to its working size.
+ *
+ * Format written by Write(), integers are 32-bit little-endian:
+ * \code
+ * "CBSS" | format version | CBot version | last instance identifier | size of records
+ * { key | data length | data } ...
+ * \endcode
+ *
+ * Read() loads the whole snapshot at once and checks the record headers. GetRecord() copies
+ * the data of one record out of the buffer, and the program's state is restored from it
+ * right away with Record::Read().
+ */
+class CBotSnapshot
+{
+public:
+    /**
+     * \brief Copy of the data of one record of a loaded snapshot
+     */
+    class Record
+    {
+    public:
+        Record() = default;
+
+        //! Returns true for records not found in the snapshot
+        bool IsEmpty() const;
+
+        /**
+         * \brief Reads the data of the record with given function
+         * \return false if the function fails or reads past the end of the record
+         */
+        bool Read(const std::function<bool(std::istream&)>& read) const;
+
+    private:
+        friend class CBotSnapshot;
+
+        std::vector<char> m_data;
+        bool m_found = false;
+    };
+
+    CBotSnapshot();
+    ~CBotSnapshot();
+
+    CBotSnapshot(const CBotSnapshot&) = delete;
+    CBotSnapshot& operator=(const CBotSnapshot&) = delete;
+
+    /**
+     * \brief Removes all records, keeping the buffer's memory for the next snapshot
+     */
+    void Clear();
+
+    /**
+     * \brief Starts a new record
+     * \param key Key of the record, unique in the snapshot
+     * \return Stream writing the data of the record, valid until EndRecord() or CancelRecord()
+     */
+    std::ostream& BeginRecord(long key);
+    /**
+     * \brief Finishes the record started with BeginRecord()
+     */
+    void EndRecord();
+    /**
+     * \brief Drops the record started with BeginRecord(), e.g. when saving the program failed
+     */
+    void CancelRecord();
+
+    /**
+     * \brief Writes the snapshot to given stream
+     */
+    bool Write(std::ostream& ostr) const;
+    /**
+     * \brief Replaces content of the snapshot with one read from the stream
+     *
+     * Identifiers of new class instances are moved past the ones used in the snapshot,
+     * so that restoring a record later doesn't link its pointers to instances created since.
+     * \return false if the stream doesn't hold a snapshot written by this version of CBot
+     */
+    bool Read(std::istream& istr);
+
+    /**
+     * \brief Returns the record with given key, an empty record if there is none
+     */
+    Record GetRecord(long key) const;
+
+private:
+    class OutputBuffer;
+
+    //! Buffer with the headers and data of all records
+    std::vector<char> m_data;
+    //! Position of each record's data in m_data, by key
+    std::unordered_map<long, std::pair<std::size_t, std::size_t>> m_records;
+    //! Start of the header of the record being written
+    std::size_t m_recordStart = 0;
+    long m_recordKey = 0;
+
+    std::unique_ptr<OutputBuffer> m_buffer;
+    std::ostream m_stream;
+};
+
+} // namespace CBot
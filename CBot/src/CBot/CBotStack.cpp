@@ -20,6 +20,7 @@
 #include "CBot/CBotStack.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotProfiler.h"
 
 #include "CBot/CBotInstr/CBotFunction.h"
 
@@ -54,6 +55,7 @@ struct CBotStack::Data
     CBotProgram* baseProg   = nullptr;
     CBotStack*   topStack   = nullptr;
     void*        pUser      = nullptr;
+    CBotProfiler* profiler  = nullptr;
 
     std::unique_ptr<CBotVar> retvar;
 };
@@ -141,6 +143,7 @@ CBotStack* CBotStack::AddStack(CBotInstr* instr, BlockVisibilityType bBlock)
     p->m_step   = 0;
     p->m_prev   = this;
     p->m_state  = 0;
+    p->m_resumeInstr = nullptr;
     p->m_call   = nullptr;
     p->m_func   = IsFunction::NO;
     p->m_callFinished = false;
@@ -348,14 +351,13 @@ bool CBotStack::GetRetVar(bool bRet)
 CBotVar* CBotStack::FindVar(CBotToken*& pToken, bool bUpdate)
 {
     CBotStack*    p = this;
-    const auto&   name = pToken->GetString();
 
     while (p != nullptr)
     {
         CBotVar*    pp = p->m_listVar;
         while ( pp != nullptr)
         {
-            if (pp->GetName() == name)
+            if (pp->GetToken()->HasSameName(*pToken))
             {
                 if ( bUpdate )
                     pp->Update(m_data->pUser);
@@ -436,6 +438,7 @@ bool CBotStack::SetState(int n, int limite)
 {
     m_state = n;
 
+    if (m_data->profiler != nullptr) m_data->profiler->CountInstruction(this);
     m_data->timer--;                              // decrement the timer
     return (m_data->timer > limite);                // interrupted if timer pass
 }
@@ -445,10 +448,34 @@ bool CBotStack::IncState(int limite)
 {
     m_state++;
 
+    if (m_data->profiler != nullptr) m_data->profiler->CountInstruction(this);
     m_data->timer--;                              // decrement the timer
     return (m_data->timer > limite);                // interrupted if timer pass
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotStack::IncState(CBotInstr* next, int limite)
+{
+    m_resumeInstr = next;
+    m_resumeState = m_state + 1;
+    return IncState(limite);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotInstr* CBotStack::GetResumeInstr(CBotInstr* first, int offset)
+{
+    if (m_resumeInstr != nullptr && m_resumeState == m_state) return m_resumeInstr;
+
+    // no position remembered for this state, walk the list
+    CBotInstr* p = first;
+    for (int state = m_state; p != nullptr && state > offset; --state)
+        p = p->GetNext();
+
+    m_resumeInstr = p;
+    m_resumeState = m_state;
+    return p;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::SetError(CBotError n, CBotToken* token)
 {
@@ -487,6 +514,16 @@ int CBotStack::GetTimer()
     return m_data->initimer;
 }
 
+int CBotStack::GetTimerUsed()
+{
+    return m_data->initimer - m_data->timer;
+}
+
+void CBotStack::SetProfiler(CBotProfiler* profiler)
+{
+    m_data->profiler = profiler;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotStack::Execute()
 {
@@ -658,6 +695,23 @@ void CBotStack::GetRunPos(std::string& functionName, int& start, int& end)
     end   = t->GetEnd();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CBotStack::GetCurrentInstr(CBotInstr*& instr, CBotInstr*& function)
+{
+    instr = nullptr;
+    function = nullptr;
+
+    for (CBotStack* p = this; p != nullptr; p = p->m_prev)
+    {
+        if (instr == nullptr) instr = p->m_instr;
+        if (p->m_func == IsFunction::YES && p->m_instr != nullptr)
+        {
+            function = p->m_instr;
+            return;
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotStack::GetStackVars(std::string& functionName, int level)
 {
@@ -34,6 +34,7 @@ class CBotInstr;
 class CBotExternalCall;
 class CBotVar;
 class CBotProgram;
+class CBotProfiler;
 class CBotToken;
 
 /**
@@ -312,6 +313,28 @@ public:
      * \return false if timer requests interruption (timer <= limit)
      */
     bool            IncState(int lim = -10);
+    /**
+     * \brief Increase the execution state by one and remember the instruction of a list that is executed next
+     *
+     * Used by instructions executing a list of instructions, one state per instruction,
+     * so that resuming doesn't have to walk the list from its start, see GetResumeInstr()
+     *
+     * \param next Instruction executed in the new state
+     * \param lim See IncState(int)
+     * \return false if timer requests interruption (timer <= limit)
+     */
+    bool            IncState(CBotInstr* next, int lim = -10);
+    /**
+     * \brief Return the instruction of a list at which execution was interrupted
+     *
+     * Returns the instruction given to the last IncState(CBotInstr*) if the state didn't change since.
+     * Otherwise (for example after RestoreState()) walks the list from \a first, one instruction per state.
+     *
+     * \param first First instruction of the list
+     * \param offset State in which \a first is executed
+     * \return Instruction to continue with, nullptr if the state is past the end of the list
+     */
+    CBotInstr*      GetResumeInstr(CBotInstr* first, int offset = 0);
 
     /**
      * \brief Check if we are in step by step execution mode
@@ -445,6 +468,12 @@ public:
      * \brief Get the current configured maximum number of "timer ticks" (parts of instructions) to execute
      */
     int             GetTimer();
+    /**
+     * \brief Get the number of "timer ticks" used since the last call to Reset()
+     *
+     * Can be a little more than GetTimer(), the timer is allowed to overflow
+     */
+    int             GetTimerUsed();
 
     /**
      * \brief Get current position in the program
@@ -454,6 +483,19 @@ public:
      */
     void            GetRunPos(std::string& functionName, int& start, int& end);
 
+    /**
+     * \brief Get instruction executed on this stack level and the function it belongs to
+     * \param[out] instr Instruction of this or the closest lower level that has one, nullptr if not found
+     * \param[out] function Function of this or the closest lower level, nullptr if not found
+     */
+    void            GetCurrentInstr(CBotInstr*& instr, CBotInstr*& function);
+
+    /**
+     * \brief Set profiler counting instructions executed on this stack, nullptr to disable
+     * \see CBotProgram::SetProfiling()
+     */
+    void            SetProfiler(CBotProfiler* profiler);
+
     /**
      * \brief Get local variables at the given stack level
      * \param[out] functionName Name of instruction being executed at this level
@@ -471,6 +513,10 @@ private:
     int               m_state;
     int               m_step;
 
+    //! Instruction of a list executed in state m_resumeState, see GetResumeInstr()
+    CBotInstr*        m_resumeInstr;
+    int               m_resumeState;
+
     struct Data;
 
     CBotStack::Data* m_data;
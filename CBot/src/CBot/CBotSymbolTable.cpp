@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotSymbolTable.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace CBot
+{
+
+namespace
+{
+
+//! Size of one block of symbol text, longer identifiers get a block of their own
+constexpr std::size_t BLOCK_SIZE = 4 * 1024;
+
+//! Identifier of the next table created
+std::atomic<int> g_nextTableId{1};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+CBotSymbolTable::CBotSymbolTable(const std::vector<std::string_view>& reserved)
+    : m_id(g_nextTableId++),
+      m_texts{ std::string_view() }
+{
+    for (std::string_view text : reserved) Intern(text);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotSymbolTable::Intern(std::string_view text)
+{
+    auto it = m_symbols.find(text);
+    if (it != m_symbols.end()) return it->second;
+
+    std::string_view stored = Store(text);
+    int symbol = static_cast<int>(m_texts.size());
+    m_texts.push_back(stored);
+    m_symbols.emplace(stored, symbol);
+    return symbol;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotSymbolTable::Find(std::string_view text) const
+{
+    auto it = m_symbols.find(text);
+    return it != m_symbols.end() ? it->second : NO_SYMBOL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string_view CBotSymbolTable::GetText(int symbol) const
+{
+    if (symbol <= NO_SYMBOL || symbol >= static_cast<int>(m_texts.size())) return std::string_view();
+    return m_texts[symbol];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotSymbolTable::GetCount() const
+{
+    return static_cast<int>(m_texts.size()) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string_view CBotSymbolTable::Store(std::string_view text)
+{
+    if (text.size() > m_freeSize)
+    {
+        std::size_t size = std::max(BLOCK_SIZE, text.size());
+        m_blocks.push_back(std::make_unique<char[]>(size));
+        m_free = m_blocks.back().get();
+        m_freeSize = size;
+    }
+
+    std::copy(text.begin(), text.end(), m_free);
+    std::string_view stored(m_free, text.size());
+    m_free += text.size();
+    m_freeSize -= text.size();
+    return stored;
+}
+
+} // namespace CBot
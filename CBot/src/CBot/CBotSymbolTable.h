@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CBot
+{
+
+/**
+ * \brief Table of interned identifiers of one CBotContext
+ *
+ * Every distinct word seen by CBotToken::CompileTokens() gets a small integer symbol from the table
+ * of the current context, so that names of variables and constants can be compared and looked up
+ * without comparing strings. Symbols are numbered from 1, 0 means "no symbol".
+ *
+ * Symbols are only meaningful within their table. Every table has an identifier which is never
+ * reused, see GetId(), so symbols coming from different tables can be told apart.
+ *
+ * The text of all symbols is stored back to back in blocks and never moves, so the views returned
+ * by GetText() stay valid as long as the table. Like the rest of its context, the table must be
+ * used from one thread at a time.
+ */
+class CBotSymbolTable
+{
+public:
+    //! Symbol meaning "not interned"
+    static constexpr int NO_SYMBOL = 0;
+
+    /**
+     * \brief Creates a table, interning given texts first, so that the N-th of them gets symbol N
+     */
+    explicit CBotSymbolTable(const std::vector<std::string_view>& reserved = {});
+
+    CBotSymbolTable(const CBotSymbolTable&) = delete;
+    CBotSymbolTable& operator=(const CBotSymbolTable&) = delete;
+
+    /**
+     * \brief Returns identifier of this table, different for every table created
+     */
+    int GetId() const { return m_id; }
+
+    /**
+     * \brief Returns the symbol of given text, adding it to the table if needed
+     */
+    int Intern(std::string_view text);
+
+    /**
+     * \brief Returns the symbol of given text, or NO_SYMBOL if it was never interned
+     */
+    int Find(std::string_view text) const;
+
+    /**
+     * \brief Returns the text of given symbol, empty for NO_SYMBOL or unknown symbols
+     */
+    std::string_view GetText(int symbol) const;
+
+    /**
+     * \brief Returns number of symbols in the table
+     */
+    int GetCount() const;
+
+private:
+    std::string_view Store(std::string_view text);
+
+    const int m_id;
+    //! Text of every symbol, index is the symbol, entry 0 is NO_SYMBOL
+    std::vector<std::string_view> m_texts;
+    //! Symbol of every text, keys point into the blocks
+    std::unordered_map<std::string_view, int> m_symbols;
+    //! Storage of the text
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    //! Free space in the last block
+    char* m_free = nullptr;
+    std::size_t m_freeSize = 0;
+};
+
+} // namespace CBot
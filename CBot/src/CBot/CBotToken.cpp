@@ -19,9 +19,13 @@
 
 #include "CBot/CBotToken.h"
 
+#include "CBot/CBotContext.h"
+#include "CBot/CBotSymbolTable.h"
+
 #include <cstdarg>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 
 namespace CBot
 {
@@ -135,7 +139,6 @@ const std::string& UndefinedTokenString()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::map<std::string, long> CBotToken::m_defineNum;
 ////////////////////////////////////////////////////////////////////////////////
 CBotToken::CBotToken()
 {
@@ -156,6 +159,8 @@ CBotToken::CBotToken(const CBotToken& pSrc)
 {
     m_type      = pSrc.m_type;
     m_keywordId = pSrc.m_keywordId;
+    m_symbol    = pSrc.m_symbol;
+    m_symbolTable = pSrc.m_symbolTable;
 
     m_text      = pSrc.m_text;
     m_sep       = pSrc.m_sep;
@@ -164,22 +169,55 @@ CBotToken::CBotToken(const CBotToken& pSrc)
     m_end       = pSrc.m_end;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotToken::CBotToken(CBotToken&& src) noexcept
+{
+    m_type      = src.m_type;
+    m_keywordId = src.m_keywordId;
+    m_symbol    = src.m_symbol;
+    m_symbolTable = src.m_symbolTable;
+
+    m_text      = std::move(src.m_text);
+    m_sep       = std::move(src.m_sep);
+
+    m_start     = src.m_start;
+    m_end       = src.m_end;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotToken::~CBotToken()
 {
+    if (m_storage != nullptr) ReleaseStorage();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotToken::ReleaseStorage()
+{
+    // stored tokens must not delete each other like separately allocated ones
+    for (CBotToken& token : *m_storage)
+    {
+        token.m_next = nullptr;
+        token.m_prev = nullptr;
+    }
+    m_next = nullptr;
+    m_storage.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotToken::ClearDefineNum()
 {
-    m_defineNum.clear();
+    CBotContext::GetCurrent().ClearDefineNum();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 const CBotToken& CBotToken::operator=(const CBotToken& src)
 {
     assert(m_prev == nullptr);
-    if (m_next != nullptr)
+    if (m_storage != nullptr)
+    {
+        ReleaseStorage();
+    }
+    else if (m_next != nullptr)
     {
         m_next->m_prev = nullptr;
         delete m_next;
@@ -191,6 +229,8 @@ const CBotToken& CBotToken::operator=(const CBotToken& src)
 
     m_type      = src.m_type;
     m_keywordId = src.m_keywordId;
+    m_symbol    = src.m_symbol;
+    m_symbolTable = src.m_symbolTable;
 
     m_start     = src.m_start;
     m_end       = src.m_end;
@@ -220,6 +260,8 @@ const std::string& CBotToken::GetString()
 void CBotToken::SetString(const std::string& name)
 {
     m_text = name;
+    m_symbol = CBotSymbolTable::NO_SYMBOL;
+    m_symbolTable = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -266,12 +308,27 @@ inline int CharacterLength(const unsigned char c)
            ((c >> 4) == 0xE) ? 3:
            ((c >> 3) == 0x1E) ? 4 : 0;
 }
+
+//! Keyword id of every symbol up to the last keyword made of letters, -1 for other symbols
+const std::vector<long>& GetKeywordsBySymbol()
+{
+    static const std::vector<long> keywords = []
+    {
+        std::vector<long> result{ -1 };     // NO_SYMBOL
+        for (std::string_view text : CBotToken::GetWordKeywords())
+            result.push_back(KEYWORDS.at(std::string(text)));
+        return result;
+    }();
+    return keywords;
+}
+
 } // namespace
 
-CBotToken* CBotToken::NextToken(const char*& program, CBotToken::Data& tokendata, bool first)
+bool CBotToken::NextToken(const char*& program, CBotToken::Data& tokendata, bool first,
+                          CBotSymbolTable& symbols, CBotToken& result)
 {
 
-    if (*program == 0) return nullptr;
+    if (*program == 0) return false;
 
     char c = *(program++);                 // next character
 
@@ -295,7 +352,7 @@ CBotToken* CBotToken::NextToken(const char*& program, CBotToken::Data& tokendata
     if (!first)
     {
         NextCharacter();
-        if (token.empty()) return nullptr;
+        if (token.empty()) return false;
 
         // special case for strings
         if (token[0] == '\"' )
@@ -442,26 +499,32 @@ CBotToken* CBotToken::NextToken(const char*& program, CBotToken::Data& tokendata
 
     program--;
 
-    CBotToken* t = new CBotToken;
-
-    if (first) t->m_type = TokenTypNone;
-    else if (CharIsNum(token[0])) t->m_type = TokenTypNum;
-    else if (token[0] == '\"') t->m_type = TokenTypString;
-    else if (token[0] == '\'') t->m_type = TokenTypChar;
+    if (first) result.m_type = TokenTypNone;
+    else if (CharIsNum(token[0])) result.m_type = TokenTypNum;
+    else if (token[0] == '\"') result.m_type = TokenTypString;
+    else if (token[0] == '\'') result.m_type = TokenTypChar;
+    else if (IsTokenSeparator(token[0]))
+    {
+        result.m_keywordId = GetKeyWord(token);
+        if (result.m_keywordId > 0) result.m_type = TokenTypKeyWord;
+    }
     else
     {
-        t->m_keywordId = GetKeyWord(token);
-        if (t->m_keywordId > 0) t->m_type = TokenTypKeyWord;
+        // words are interned first, which also tells if they are keywords
+        const auto& keywords = GetKeywordsBySymbol();
+        result.m_symbol = symbols.Intern(token);
+        result.m_symbolTable = symbols.GetId();
+        if (result.m_symbol < static_cast<int>(keywords.size())) result.m_keywordId = keywords[result.m_symbol];
+        if (result.m_keywordId > 0) result.m_type = TokenTypKeyWord;
     }
 
-    token.swap(t->m_text);
-    sep.swap(t->m_sep);
-    return t;
+    token.swap(result.m_text);
+    sep.swap(result.m_sep);
+    return true;
 }
 
 CBotTokenUPtr CBotToken::CompileTokens(const std::string& program, CBotToken::Data* tokendata)
 {
-    CBotToken       *nxt, *prv, *tokenbase;
     const char*     p = program.c_str();
     int             pos = 0;
 
@@ -476,41 +539,56 @@ CBotTokenUPtr CBotToken::CompileTokens(const std::string& program, CBotToken::Da
     tokendata->currentColumnIndex = 0;
     CBot::InitCRC32(tokendata->signature);
 
-    prv = tokenbase = NextToken(p, *tokendata, true);
+    CBotSymbolTable& symbols = CBotContext::GetCurrent().GetSymbols();
 
-    if (tokenbase == nullptr) return nullptr;
+    auto tokenbase = std::make_unique<CBotToken>();
+    if (!NextToken(p, *tokendata, true, symbols, *tokenbase)) return nullptr;
 
     tokenbase->m_start  = pos;
     pos += tokenbase->m_text.length();
     tokenbase->m_end    = pos;
     pos += tokenbase->m_sep.length();
 
+    // all the other tokens are kept in one array, linked once it doesn't move anymore
+    auto storage = std::make_unique<std::vector<CBotToken>>();
+    storage->reserve(program.length() / 8 + 1);
+
     const char* pp = p;
-    while (nullptr != (nxt = NextToken(p, *tokendata, false)))
+    while (true)
     {
-        prv->m_next = nxt;              // added after
-        nxt->m_prev = prv;
-        prv = nxt;                      // advance
+        CBotToken& nxt = storage->emplace_back();
+        if (!NextToken(p, *tokendata, false, symbols, nxt))
+        {
+            storage->pop_back();
+            break;
+        }
 
-        nxt->m_start    = pos;
+        nxt.m_start     = pos;
         pos += (p - pp);                // total size
-        nxt->m_end  = pos - nxt->m_sep.length();
+        nxt.m_end   = pos - nxt.m_sep.length();
         pp = p;
 
-        if (nxt->m_type == TokenTypVar)
+        if (nxt.m_type == TokenTypVar)
         {
-           GetDefineNum(nxt->m_text, nxt);
+            GetDefineNum(&nxt);
         }
     }
 
     // terminator token
-    nxt = new CBotToken();
-    nxt->m_type = TokenTypNone;
-    nxt->m_end = nxt->m_start = pos;
-    prv->m_next = nxt;
-    nxt->m_prev = prv;
+    CBotToken& terminator = storage->emplace_back();
+    terminator.m_type = TokenTypNone;
+    terminator.m_end = terminator.m_start = pos;
+
+    CBotToken* prv = tokenbase.get();
+    for (CBotToken& nxt : *storage)
+    {
+        prv->m_next = &nxt;             // added after
+        nxt.m_prev = prv;
+        prv = &nxt;                     // advance
+    }
+    tokenbase->m_storage = std::move(storage);
 
-    return std::unique_ptr<CBotToken>(tokenbase);
+    return tokenbase;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -526,28 +604,36 @@ int CBotToken::GetKeyWord(const std::string& w)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool CBotToken::GetDefineNum(const std::string& name, CBotToken* token)
+const std::vector<std::string_view>& CBotToken::GetWordKeywords()
 {
-    if (m_defineNum.count(name) == 0)
+    static const std::vector<std::string_view> keywords = []
+    {
+        std::vector<std::string_view> result;
+        for (const auto& [text, id] : KEYWORDS)
+        {
+            if (!IsTokenSeparator(text[0])) result.push_back(text);
+        }
+        return result;
+    }();
+    return keywords;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotToken::GetDefineNum(CBotToken* token)
+{
+    long val;
+    if (!CBotContext::GetCurrent().FindDefineNum(token->m_symbol, val))
         return false;
 
     token->m_type = TokenTypDef;
-    token->m_keywordId = m_defineNum[name];
+    token->m_keywordId = val;
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotToken::DefineNum(const std::string& name, long val)
 {
-    if (m_defineNum.count(name) > 0)
-    {
-        // TODO: No access to the logger from CBot library :(
-        printf("CBOT WARNING: %s redefined\n", name.c_str());
-        return false;
-    }
-
-    m_defineNum[name] = val;
-    return true;
+    return CBotContext::GetCurrent().DefineNum(name, val);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,9 +25,12 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 namespace CBot
 {
+class CBotSymbolTable;
 class CBotToken;
 
 using CBotTokenUPtr = std::unique_ptr<CBotToken>;
@@ -77,6 +80,11 @@ using CBotTokenUPtr = std::unique_ptr<CBotToken>;
  *     token = token->GetNext();
  * }
  * \endcode
+ *
+ * \section Storage Storage
+ * The tokens returned by CompileTokens() are stored in one contiguous array owned by the first
+ * token, so they are only linked, never allocated one by one. Identifiers also carry a symbol
+ * from the CBotSymbolTable of the current context, see GetSymbol().
  */
 
 class CBotToken : public CBotDoublyLinkedList<CBotToken>
@@ -90,6 +98,10 @@ public:
      * \brief Copy constructor
      */
     CBotToken(const CBotToken& pSrc);
+    /**
+     * \brief Move constructor, doesn't take over the links to other tokens
+     */
+    CBotToken(CBotToken&& src) noexcept;
     /**
      * \brief Constructor
      *
@@ -130,6 +142,22 @@ public:
      */
     void SetString(const std::string& name);
 
+    /**
+     * \brief Return the interned symbol of an identifier or keyword, see CBotContext::GetSymbols()
+     * \return The symbol, or CBotSymbolTable::NO_SYMBOL for other tokens and tokens not created by CompileTokens()
+     */
+    int GetSymbol() const { return m_symbol; }
+
+    /**
+     * \brief Check if two tokens have the same text, comparing symbols when both come from the same table
+     */
+    bool HasSameName(const CBotToken& other) const
+    {
+        if (m_symbol != 0 && other.m_symbol != 0 && m_symbolTable == other.m_symbolTable)
+            return m_symbol == other.m_symbol;
+        return m_text == other.m_text;
+    }
+
     /**
      * \brief Return the beginning location of this token in the original program string
      */
@@ -171,7 +199,14 @@ public:
                                        CBotToken::Data* tokendata = nullptr);
 
     /**
-     * \brief Define a new constant
+     * \brief Returns keywords made of letters, interned first in every CBotSymbolTable
+     *
+     * The N-th keyword gets symbol N, so the keyword id of a word is known from its symbol.
+     */
+    static const std::vector<std::string_view>& GetWordKeywords();
+
+    /**
+     * \brief Define a new constant in the current context, see CBotContext::DefineNum()
      * \param name Name of the constant
      * \param val Value of the constant
      * \return true on success, false if already defined
@@ -179,7 +214,7 @@ public:
     static bool DefineNum(const std::string& name, long val);
 
     /**
-     * \brief Clear the list of defined constants
+     * \brief Clear the list of constants defined in the current context
      * \see DefineNum()
      */
     static void ClearDefineNum();
@@ -201,15 +236,27 @@ private:
      * \param [in, out] program The program string, modified to point at the next token
      * \param [in, out] tokendata data about the list of tokens.
      * \param first true if this is the first call (beginning of the program string)
-     * \return A processed CBotToken
+     * \param symbols Table in which identifiers and keywords are interned
+     * \param [out] result The token to fill
+     * \return false at the end of the program string
+     */
+    static bool NextToken(const char*& program, CBotToken::Data& tokendata, bool first,
+                          CBotSymbolTable& symbols, CBotToken& result);
+
+    /**
+     * \brief Unlink and free the tokens stored in m_storage
      */
-    static CBotToken* NextToken(const char*& program, CBotToken::Data& tokendata, bool first);
+    void ReleaseStorage();
 
 private:
     //! The token type
     TokenType m_type = TokenTypVar;
     //! The id of the keyword
     long m_keywordId = -1;
+    //! The interned symbol of an identifier
+    int m_symbol = 0;
+    //! Identifier of the table m_symbol comes from, see CBotSymbolTable::GetId()
+    int m_symbolTable = 0;
 
     //! The token string
     std::string m_text = "";
@@ -221,8 +268,8 @@ private:
     //! The end position of the token in the CBotProgram
     int m_end = 0;
 
-    //! Map of all defined constants (see DefineNum())
-    static std::map<std::string, long> m_defineNum;
+    //! The tokens following this one, only set on the first token returned by CompileTokens()
+    std::unique_ptr<std::vector<CBotToken>> m_storage;
 
     /**
      * \brief Check if the word is a keyword
@@ -233,11 +280,10 @@ private:
 
     /**
      * \brief Resolve a constant defined with DefineNum()
-     * \param name Constant name
      * \param token Token that we are working on, will be filled with data about found constant
      * \return true if the constant was found, false otherwise
      */
-    static bool GetDefineNum(const std::string& name, CBotToken* token);
+    static bool GetDefineNum(CBotToken* token);
 };
 
 /**
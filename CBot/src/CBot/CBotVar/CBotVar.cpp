@@ -20,6 +20,8 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
+#include "CBot/CBotContext.h"
+#include "CBot/CBotProfiler.h"
 #include "CBot/CBotStack.h"
 
 #include "CBot/CBotInstr/CBotInstr.h"
@@ -51,11 +53,11 @@ namespace CBot
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-long CBotVar::m_identcpt = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar::CBotVar( ) : m_token(nullptr)
 {
+    CBotProfiler::CountAllocation();
     m_pMyThis = nullptr;
     m_pUserPtr = nullptr;
     m_InitExpr = nullptr;
@@ -69,6 +71,7 @@ CBotVar::CBotVar( ) : m_token(nullptr)
 
 CBotVar::CBotVar(const CBotToken &name) : m_token(new CBotToken(name))
 {
+    CBotProfiler::CountAllocation();
     m_pMyThis = nullptr;
     m_pUserPtr = nullptr;
     m_InitExpr = nullptr;
@@ -122,8 +125,7 @@ void CBotVar::SetUniqNum(long n)
 ////////////////////////////////////////////////////////////////////////////////
 long CBotVar::NextUniqNum()
 {
-    if (++m_identcpt < 10000) m_identcpt = 10000;
-    return m_identcpt;
+    return CBotContext::GetCurrent().NextUniqNum();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -517,7 +519,10 @@ void CBotVar::SetVal(CBotVar* var)
         SetValDouble(var->GetValDouble());
         break;
     case CBotTypString:
-        SetValString(var->GetValString());
+        if (GetType() == CBotTypString)
+            static_cast<CBotVarString*>(this)->SetValString(static_cast<CBotVarString*>(var));   // shares the text
+        else
+            SetValString(var->GetValString());
         break;
     case CBotTypPointer:
     case CBotTypNullPointer:
@@ -703,9 +703,6 @@ protected:
      */
     long m_ident;
 
-    //! TODO: ?
-    static long m_identcpt;
-
     friend class CBotStack;
     friend class CBotCStack;
     friend class CBotInstrCall;
@@ -20,6 +20,7 @@
 #include "CBot/CBotVar/CBotVarClass.h"
 
 #include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotDefines.h"
 
@@ -30,9 +31,6 @@
 namespace CBot
 {
 
-////////////////////////////////////////////////////////////////////////////////
-std::set<CBotVarClass*> CBotVarClass::m_instances{};
-
 ////////////////////////////////////////////////////////////////////////////////
 CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type) : CBotVar(name)
 {
@@ -62,7 +60,12 @@ CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type) : C
     m_ItemIdent = type.Eq(CBotTypIntrinsic) ? 0 : CBotVar::NextUniqNum();
 
     // add to the list
-    if (m_ItemIdent != 0) m_instances.insert(this);
+    m_context = nullptr;
+    if (m_ItemIdent != 0)
+    {
+        m_context = &CBotContext::GetCurrent();
+        m_context->AddInstance(this);
+    }
 
     CBotClass* pClass = type.GetClass();
 
@@ -77,7 +80,7 @@ CBotVarClass::~CBotVarClass( )
         assert(0);
 
     // removes the class list
-    m_instances.erase(this);
+    if (m_context != nullptr) m_context->RemoveInstance(this);
 
     delete    m_pVar;
 }
@@ -108,7 +111,7 @@ void CBotVarClass::Copy(CBotVar* pSrc, bool bName)
 //    m_next        = nullptr;
     m_pUserPtr    = p->m_pUserPtr;
     m_pMyThis    = nullptr;//p->m_pMyThis;
-    m_ItemIdent = p->m_ItemIdent;
+    SetIdent(p->m_ItemIdent);
 
     // keeps indentificator the same (by default)
     if (m_ident == 0 ) m_ident     = p->m_ident;
@@ -131,7 +134,10 @@ void CBotVarClass::Copy(CBotVar* pSrc, bool bName)
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVarClass::SetIdent(long n)
 {
+    // the context finds instances by identifier, register again under the new one
+    if (m_context != nullptr) m_context->RemoveInstance(this);
     m_ItemIdent = n;
+    if (m_context != nullptr) m_context->AddInstance(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,12 +418,7 @@ CBotVarClass* CBotVarClass::GetPointer()
 ////////////////////////////////////////////////////////////////////////////////
 CBotVarClass* CBotVarClass::Find(long id)
 {
-    for (CBotVarClass* p : m_instances)
-    {
-        if (p->m_ItemIdent == id) return p;
-    }
-
-    return nullptr;
+    return CBotContext::GetCurrent().FindInstance(id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
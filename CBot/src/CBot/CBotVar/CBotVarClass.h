@@ -21,11 +21,11 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
-#include <set>
-
 namespace CBot
 {
 
+class CBotContext;
+
 /**
  * \brief CBotVar subclass for managing classes (::CBotTypClass, ::CBotTypIntrinsic)
  *
@@ -95,8 +95,8 @@ public:
     void ConstructorSet() override;
 
 private:
-    //! List of all class instances - first
-    static std::set<CBotVarClass*> m_instances;
+    //! Context the instance is registered in, see CBotContext::FindInstance()
+    CBotContext* m_context;
     //! Class definition
     CBotClass* m_pClass;
     //! Class members
@@ -110,6 +110,7 @@ private:
 
     friend class CBotVar;
     friend class CBotVarPointer;
+    friend class CBotContext;
 };
 
 } // namespace CBot
@@ -19,27 +19,119 @@
 
 #include "CBot/CBotVar/CBotVarString.h"
 
+#include <algorithm>
+
 namespace CBot
 {
 
+void CBotVarString::Copy(CBotVar* pSrc, bool bName)
+{
+    CBotVar::Copy(pSrc, bName);
+
+    CBotVarString* p = static_cast<CBotVarString*>(pSrc);
+    m_text = p->m_text;
+    m_start = p->m_start;
+    m_length = p->m_length;
+}
+
+void CBotVarString::SetValString(const std::string& val)
+{
+    // a buffer nobody else sees can be reused
+    if (m_text != nullptr && m_text.use_count() == 1)
+        m_text->assign(val);
+    else
+        m_text = std::make_shared<std::string>(val);
+
+    m_start = 0;
+    m_length = val.length();
+    m_binit = CBotVar::InitType::DEF;
+}
+
+void CBotVarString::SetValString(const CBotVarString* source, std::size_t start, std::size_t length)
+{
+    std::string_view text = source->GetStringView();
+    start = std::min(start, text.length());
+    length = std::min(length, text.length() - start);
+
+    if (source->m_binit != CBotVar::InitType::DEF)
+    {
+        SetValString(std::string(text.substr(start, length)));
+        return;
+    }
+
+    m_text = source->m_text;
+    m_start = source->m_start + start;
+    m_length = length;
+    m_binit = CBotVar::InitType::DEF;
+}
+
+std::string CBotVarString::GetValString() const
+{
+    return std::string(GetStringView());
+}
+
+std::string_view CBotVarString::GetStringView() const
+{
+    if (m_binit == CBotVar::InitType::UNDEF)
+        return UndefinedTokenString();
+
+    return GetText();
+}
+
+std::string_view CBotVarString::GetText() const
+{
+    if (m_text == nullptr) return std::string_view();
+    return std::string_view(*m_text).substr(m_start, m_length);
+}
+
+void CBotVarString::AppendString(std::string_view text)
+{
+    if (m_text != nullptr && m_start + m_length == m_text->length())
+    {
+        // other variables only see characters before the end of the buffer
+        m_text->append(text);
+    }
+    else
+    {
+        auto joined = std::make_shared<std::string>();
+        joined->reserve(m_length + text.length());
+        joined->append(GetText());
+        joined->append(text);
+        m_text = std::move(joined);
+        m_start = 0;
+    }
+    m_length += text.length();
+}
+
 void CBotVarString::Add(CBotVar* left, CBotVar* right)
 {
-    SetValString(left->GetValString() + right->GetValString());
+    if (left->GetType() == CBotTypString)
+        SetValString(static_cast<CBotVarString*>(left));
+    else
+        SetValString(left->GetValString());
+
+    if (right->GetType() == CBotTypString)
+        AppendString(static_cast<CBotVarString*>(right)->GetStringView());
+    else
+        AppendString(right->GetValString());
 }
 
 bool CBotVarString::Eq(CBotVar* left, CBotVar* right)
 {
+    if (left->GetType() == CBotTypString && right->GetType() == CBotTypString)
+        return static_cast<CBotVarString*>(left)->GetStringView() == static_cast<CBotVarString*>(right)->GetStringView();
+
     return left->GetValString() == right->GetValString();
 }
 
 bool CBotVarString::Ne(CBotVar* left, CBotVar* right)
 {
-    return left->GetValString() != right->GetValString();
+    return !Eq(left, right);
 }
 
 bool CBotVarString::Save1State(std::ostream &ostr)
 {
-    return WriteString(ostr, m_val);
+    return WriteString(ostr, std::string(GetText()));
 }
 
 } // namespace CBot
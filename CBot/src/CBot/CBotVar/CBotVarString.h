@@ -19,25 +19,59 @@
 
 #pragma once
 
-#include "CBot/CBotVar/CBotVarValue.h"
+#include "CBot/CBotVar/CBotVar.h"
+
+#include "CBot/CBotEnums.h"
+#include "CBot/CBotToken.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
 
 namespace CBot
 {
 
 /**
  * \brief CBotVar subclass for managing string values (::CBotTypString)
+ *
+ * The text is kept in a reference-counted buffer shared by all copies of the value,
+ * so assignments, parameters and substrings don't copy it. The variable sees the part
+ * [m_start, m_start + m_length) of the buffer. Characters in the buffer are never changed
+ * once written, new ones are only appended. Appending to a string whose part ends
+ * at the end of the buffer (the usual case for s += x) extends the buffer in place,
+ * other variables sharing it still see their shorter part.
  */
-class CBotVarString : public CBotVarValue<std::string, CBotTypString>
+class CBotVarString : public CBotVar
 {
 public:
-    CBotVarString(const CBotToken &name) : CBotVarValue(name) {}
-
-    void SetValString(const std::string& val) override
+    /**
+     * \brief Constructor. Do not call directly, use CBotVar::Create()
+     */
+    CBotVarString(const CBotToken &name) : CBotVar(name)
     {
-        m_val = val;
-        m_binit = CBotVar::InitType::DEF;
+        m_type = CBotTypString;
     }
 
+    void Copy(CBotVar* pSrc, bool bName = true) override;
+
+    void SetValString(const std::string& val) override;
+
+    /**
+     * \brief Sets the value to a part of another string, sharing its text instead of copying it
+     * \param source String to take the text from, can be this variable
+     * \param start Index of the first character of the part
+     * \param length Length of the part, clamped to the end of the source string
+     */
+    void SetValString(const CBotVarString* source, std::size_t start = 0, std::size_t length = std::string::npos);
+
+    std::string GetValString() const override;
+
+    /**
+     * \brief Returns the value without copying it, valid until this variable is changed or destroyed
+     */
+    std::string_view GetStringView() const;
+
     void SetValInt(int val, const std::string& s = "") override
     {
         SetValString(ToString(val));
@@ -66,6 +100,12 @@ public:
     bool Save1State(std::ostream &ostr) override;
 
 private:
+    //! Appends text at the end of the value, in place if nothing else uses the buffer past it
+    void AppendString(std::string_view text);
+
+    //! The part of the buffer seen by this variable, regardless of its init state
+    std::string_view GetText() const;
+
     template<typename T>
     static std::string ToString(T val)
     {
@@ -82,6 +122,14 @@ private:
         ss >> v;
         return v;
     }
+
+private:
+    //! Text buffer shared with copies of this value, nullptr for empty string
+    std::shared_ptr<std::string> m_text;
+    //! Index of the first character of the value in m_text
+    std::size_t m_start = 0;
+    //! Length of the value
+    std::size_t m_length = 0;
 };
 
 } // namespace CBot
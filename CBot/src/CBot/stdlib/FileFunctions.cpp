@@ -22,6 +22,7 @@
 #include "common/stringutils.h"
 
 #include "CBot/CBot.h"
+#include "CBot/CBotContext.h"
 
 #include <memory>
 #include <unordered_map>
@@ -32,10 +33,6 @@ namespace CBot
 
 namespace
 {
-std::unique_ptr<CBotFileAccessHandler> g_fileHandler;
-std::unordered_map<int, std::unique_ptr<CBotFile>> g_files;
-int g_nextFileId = 1;
-
 bool FileClassOpenFile(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception)
 {
     CBotFileAccessHandler::OpenMode openMode = CBotFileAccessHandler::OpenMode::Read;
@@ -79,14 +76,14 @@ bool FileClassOpenFile(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exc
     if ( pVar->IsDefined()) { Exception = CBotErrFileOpen; return false; }
 
     // opens the requested file
-    assert(g_fileHandler != nullptr);
+    CBotContext& context = CBotContext::GetCurrent();
+    assert(context.GetFileAccessHandler() != nullptr);
 
-    std::unique_ptr<CBotFile> file = g_fileHandler->OpenFile(filename, openMode);
+    std::unique_ptr<CBotFile> file = context.GetFileAccessHandler()->OpenFile(filename, openMode);
 
     if (!file->Opened()) { Exception = CBotErrFileOpen; return false; }
 
-    int fileHandle = g_nextFileId++;
-    g_files[fileHandle] = std::move(file);
+    int fileHandle = context.AddFile(std::move(file));
 
     // save the file handle
     pVar = pThis->GetItem("handle");
@@ -142,7 +139,7 @@ bool rfdestruct (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception
     pVar = pThis->GetItem("handle");
 
     if (!pVar->IsDefined()) return true; // file not opened
-    g_files.erase(pVar->GetValInt());
+    CBotContext::GetCurrent().RemoveFile(pVar->GetValInt());
 
     pVar->SetInit(CBotVar::InitType::UNDEF);
     return true;
@@ -205,15 +202,12 @@ bool rfclose (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    if (!CBotContext::GetCurrent().RemoveFile(fileHandle))
     {
         Exception = CBotErrNotOpen;
         return false;
     }
 
-    g_files.erase(handleIter);
-
     pVar->SetInit(CBotVar::InitType::UNDEF);
     return true;
 }
@@ -248,17 +242,17 @@ bool rfwrite (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    CBotFile* file = CBotContext::GetCurrent().GetFile(fileHandle);
+    if (file == nullptr)
     {
         Exception = CBotErrNotOpen;
         return false;
     }
 
-    handleIter->second->Write(param + "\n");
+    file->Write(param + "\n");
 
     // if an error occurs generate an exception
-    if ( handleIter->second->Errored() ) { Exception = CBotErrWrite; return false; }
+    if ( file->Errored() ) { Exception = CBotErrWrite; return false; }
 
     return true;
 }
@@ -294,17 +288,17 @@ bool rfread(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    CBotFile* file = CBotContext::GetCurrent().GetFile(fileHandle);
+    if (file == nullptr)
     {
         Exception = CBotErrNotOpen;
         return false;
     }
 
-    std::string line = handleIter->second->ReadLine();
+    std::string line = file->ReadLine();
 
     // if an error occurs generate an exception
-    if ( handleIter->second->Errored() ) { Exception = CBotErrRead; return false; }
+    if ( file->Errored() ) { Exception = CBotErrRead; return false; }
 
     pResult->SetValString( line.c_str() );
 
@@ -336,14 +330,14 @@ bool rfeof (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
-    const auto handleIter = g_files.find(fileHandle);
-    if (handleIter == g_files.end())
+    CBotFile* file = CBotContext::GetCurrent().GetFile(fileHandle);
+    if (file == nullptr)
     {
         Exception = CBotErrNotOpen;
         return false;
     }
 
-    pResult->SetValInt( handleIter->second->IsEOF() );
+    pResult->SetValInt( file->IsEOF() );
 
     return true;
 }
@@ -372,8 +366,9 @@ bool rDeleteFile(CBotVar* var, CBotVar* result, int& exception, void* user)
         exception = CBotErrFileOpen;
         return false;
     }
-    assert(g_fileHandler != nullptr);
-    return g_fileHandler->DeleteFile(filename);
+    CBotFileAccessHandler* fileHandler = CBotContext::GetCurrent().GetFileAccessHandler();
+    assert(fileHandler != nullptr);
+    return fileHandler->DeleteFile(filename);
 }
 
 } // namespace
@@ -415,7 +410,7 @@ void InitFileFunctions()
 
 void SetFileAccessHandler(std::unique_ptr<CBotFileAccessHandler> fileHandler)
 {
-    g_fileHandler = std::move(fileHandler);
+    CBotContext::GetCurrent().SetFileAccessHandler(std::move(fileHandler));
 }
 
 } // namespace CBot
@@ -23,6 +23,8 @@
 
 #include "CBot/CBotUtils.h"
 
+#include "CBot/CBotVar/CBotVarString.h"
+
 #include <common/stringutils.h>
 
 namespace CBot
@@ -42,11 +44,8 @@ bool rStrLen( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // no second parameter
     if ( pVar->GetNext() != nullptr ) { ex = CBotErrOverParam ; return true; }
 
-    // get the contents of the string
-    std::string  s = pVar->GetValString();
-
     // puts the length of the stack
-    pResult->SetValInt( s.length() );
+    pResult->SetValInt( static_cast<CBotVarString*>(pVar)->GetStringView().length() );
     return true;
 }
 
@@ -59,8 +58,9 @@ bool rStrLeft( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // to be a string
     if ( pVar->GetType() != CBotTypString ) { ex = CBotErrBadString ; return true; }
 
-    // get the contents of the string
-    std::string  s = pVar->GetValString();
+    // get the contents of the string, substrings share its text
+    CBotVarString* pString = static_cast<CBotVarString*>(pVar);
+    std::string_view s = pString->GetStringView();
 
     // it takes a second parameter
     pVar = pVar->GetNext();
@@ -78,11 +78,8 @@ bool rStrLeft( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // no third parameter
     if ( pVar->GetNext() != nullptr ) { ex = CBotErrOverParam ; return true; }
 
-    // takes the interesting part
-    s = s.substr(0, n);
-
-    // puts on the stack
-    pResult->SetValString( s );
+    // puts the interesting part on the stack
+    static_cast<CBotVarString*>(pResult)->SetValString( pString, 0, n );
     return true;
 }
 
@@ -95,8 +92,9 @@ bool rStrRight( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // to be a string
     if ( pVar->GetType() != CBotTypString ) { ex = CBotErrBadString ; return true; }
 
-    // get the contents of the string
-    std::string  s = pVar->GetValString();
+    // get the contents of the string, substrings share its text
+    CBotVarString* pString = static_cast<CBotVarString*>(pVar);
+    std::string_view s = pString->GetStringView();
 
     // it takes a second parameter
     pVar = pVar->GetNext();
@@ -114,11 +112,8 @@ bool rStrRight( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // no third parameter
     if ( pVar->GetNext() != nullptr ) { ex = CBotErrOverParam ; return true; }
 
-    // takes the interesting part
-    s = s.substr(s.length()-n, std::string::npos);
-
-    // puts on the stack
-    pResult->SetValString( s );
+    // puts the interesting part on the stack
+    static_cast<CBotVarString*>(pResult)->SetValString( pString, s.length()-n );
     return true;
 }
 
@@ -131,8 +126,9 @@ bool rStrMid( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     // to be a string
     if ( pVar->GetType() != CBotTypString ) { ex = CBotErrBadString ; return true; }
 
-    // get the contents of the string
-    std::string  s = pVar->GetValString();
+    // get the contents of the string, substrings share its text
+    CBotVarString* pString = static_cast<CBotVarString*>(pVar);
+    std::string_view s = pString->GetStringView();
 
     // it takes a second parameter
     pVar = pVar->GetNext();
@@ -164,17 +160,14 @@ bool rStrMid( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
         // but no fourth parameter
         if ( pVar->GetNext() != nullptr ){ ex = CBotErrOverParam ; return true; }
 
-        // takes the interesting part
-        s = s.substr(n, l);
+        // puts the interesting part on the stack
+        static_cast<CBotVarString*>(pResult)->SetValString( pString, n, l );
     }
     else
     {
-        // takes the interesting part
-        s = s.substr(n);
+        // puts the interesting part on the stack
+        static_cast<CBotVarString*>(pResult)->SetValString( pString, n );
     }
-
-    // puts on the stack
-    pResult->SetValString( s );
     return true;
 }
 
@@ -210,7 +203,7 @@ bool rStrFind( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     if ( pVar->GetType() != CBotTypString ) { ex = CBotErrBadString ; return true; }
 
     // get the contents of the string
-    std::string  s = pVar->GetValString();
+    std::string_view s = static_cast<CBotVarString*>(pVar)->GetStringView();
 
     // it takes a second parameter
     pVar = pVar->GetNext();
@@ -220,7 +213,7 @@ bool rStrFind( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
     if ( pVar->GetType() != CBotTypString ) { ex = CBotErrBadString ; return true; }
 
     // retrieves this number
-    std::string s2 = pVar->GetValString();
+    std::string_view s2 = static_cast<CBotVarString*>(pVar)->GetStringView();
 
     // no third parameter
     if ( pVar->GetNext() != nullptr ) { ex = CBotErrOverParam ; return true; }
@@ -50,6 +50,7 @@ public:
     virtual bool DeleteFile(const std::filesystem::path& filename) = 0;
 };
 
+//! Sets file access handler of the current context, see CBotContext
 void SetFileAccessHandler(std::unique_ptr<CBotFileAccessHandler> fileHandler);
 
 // TODO: provide default implementation of CBotFileAccessHandler
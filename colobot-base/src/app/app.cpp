@@ -35,6 +35,7 @@
 #include "common/resources/resourcemanager.h"
 
 #include "common/system/system.h"
+#include "common/thread/thread_pool.h"
 
 #include "graphics/core/device.h"
 #include "graphics/engine/engine.h"
@@ -53,11 +54,12 @@
 #include <SDL_image.h>
 
 #include <stdlib.h>
+#include <fstream>
 #include <getopt.h>
 #include <localename.h>
-#include <thread>
 
 #include <libintl.h>
+#include <thread>
 
 using TimeUtils::TimeStamp;
 using TimeUtils::TimeUnit;
@@ -109,18 +111,23 @@ struct ApplicationPrivate
 CApplication::CApplication(CSystemUtils* systemUtils)
     : m_systemUtils(systemUtils),
       m_private(std::make_unique<ApplicationPrivate>()),
+      m_threadPool(std::make_unique<CThreadPool>()),
       m_configFile(std::make_unique<CConfigFile>()),
       m_input(std::make_unique<CInput>()),
       m_pathManager(std::make_unique<CPathManager>(systemUtils)),
       m_modManager(std::make_unique<CModManager>(this, m_pathManager.get())),
       m_deviceConfig(std::make_unique<Gfx::DeviceConfig>())
 {
+    m_threadPool->SetProfilingHook(CProfiler::RecordTask);
 }
 
 CApplication::~CApplication()
 {
     m_joystickEnabled = false;
 
+    // background tasks may still use the subsystems destroyed below
+    m_threadPool->WaitIdle();
+
     m_controller.reset();
     m_sound.reset();
 
@@ -160,6 +167,8 @@ CApplication::~CApplication()
 
     if (SDL_WasInit(0))
         SDL_Quit();
+
+    m_threadPool.reset();
 }
 
 CEventQueue* CApplication::GetEventQueue()
@@ -219,7 +228,8 @@ ParseArgsStatus CApplication::ParseArguments(const std::vector<std::string>& arg
         OPT_HEADLESS,
         OPT_DEVICE,
         OPT_OPENGL_VERSION,
-        OPT_OPENGL_PROFILE
+        OPT_OPENGL_PROFILE,
+        OPT_PROFILE
     };
 
     option options[] =
@@ -239,6 +249,7 @@ ParseArgsStatus CApplication::ParseArguments(const std::vector<std::string>& arg
         { "graphics", required_argument, nullptr, OPT_DEVICE },
         { "glversion", required_argument, nullptr, OPT_OPENGL_VERSION },
         { "glprofile", required_argument, nullptr, OPT_OPENGL_PROFILE },
+        { "profile", required_argument, nullptr, OPT_PROFILE },
         { nullptr, 0, nullptr, 0}
     };
 
@@ -295,6 +306,7 @@ ParseArgsStatus CApplication::ParseArguments(const std::vector<std::string>& arg
                 GetLogger()->Message("  -graphics           changes graphics device (one of: default, auto, opengl, gl14, gl21, gl33");
                 GetLogger()->Message("  -glversion          sets OpenGL context version to use (either default or version in format #.#)");
                 GetLogger()->Message("  -glprofile          sets OpenGL context profile to use (one of: default, core, compatibility, opengles)");
+                GetLogger()->Message("  -profile file       record profiler trace and write last frames to file on exit (Chrome trace format)");
                 return PARSE_ARGS_HELP;
             }
             case OPT_DEBUG:
@@ -469,6 +481,13 @@ ParseArgsStatus CApplication::ParseArguments(const std::vector<std::string>& arg
                 }
                 break;
             }
+            case OPT_PROFILE:
+            {
+                m_profileTracePath = StrUtils::ToPath(optarg);
+                CProfiler::SetTraceEnabled(true);
+                GetLogger()->Info("Profiler trace will be written to: %%", m_profileTracePath);
+                break;
+            }
             default:
                 assert(false); // should never get here
         }
@@ -1183,6 +1202,15 @@ int CApplication::Run()
 
 end:
 
+    if (!m_profileTracePath.empty())
+    {
+        std::ofstream stream(m_profileTracePath);
+        if (stream)
+            CProfiler::WriteChromeTrace(stream);
+        else
+            GetLogger()->Error("Could not write profiler trace to %%", m_profileTracePath);
+    }
+
     return m_exitCode;
 }
 
@@ -1517,6 +1545,7 @@ void CApplication::InternalResumeSimulation()
 
 void CApplication::StartLoadingMusic()
 {
+    // long job, on its own thread so that it doesn't hold a pool worker for the whole startup
     std::thread{[this]()
     {
         GetLogger()->Debug("Cache sounds...");
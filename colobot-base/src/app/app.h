@@ -48,6 +48,7 @@ class CModManager;
 class CPathManager;
 class CConfigFile;
 class CSystemUtils;
+class CThreadPool;
 
 namespace Gfx
 {
@@ -322,6 +323,8 @@ protected:
     CSystemUtils* m_systemUtils = nullptr;
     //! Private (SDL-dependent data)
     std::unique_ptr<ApplicationPrivate> m_private;
+    //! Shared worker threads
+    std::unique_ptr<CThreadPool> m_threadPool;
     //! Global event queue
     std::unique_ptr<CEventQueue> m_eventQueue;
     //! Graphics engine
@@ -426,6 +429,9 @@ protected:
     //! Headles mode
     bool            m_headless = false;
 
+    //! File to write profiler trace to on exit, if set by commandline
+    std::filesystem::path m_profileTracePath;
+
     //! Static buffer for putenv locale
     inline static std::array<char, 64> m_languageLocale = { '\0' };
 
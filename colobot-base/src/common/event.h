@@ -424,6 +424,7 @@ enum EventType
     EVENT_DBG_CRASHSPHERES  = 856,
     EVENT_DBG_LIGHTS        = 857,
     EVENT_DBG_LIGHTS_DUMP   = 858,
+    EVENT_DBG_PROFILER      = 859,
 
     EVENT_SPAWN_CANCEL      = 860,
     EVENT_SPAWN_ME          = 861,
@@ -616,6 +617,7 @@ enum EventType
     EVENT_STUDIO_RUN        = 2051,
     EVENT_STUDIO_REALTIME   = 2052,
     EVENT_STUDIO_STEP       = 2053,
+    EVENT_STUDIO_PROFILE    = 2054,
 
     EVENT_WRITE_SCENE_FINISHED = 2100, //!< indicates end of writing scene (writing screenshot image)
 
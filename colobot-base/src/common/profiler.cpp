@@ -21,15 +21,98 @@
 
 #include "common/system/system.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <iomanip>
 
 using TimeUtils::TimeStamp;
 
+namespace
+{
+
+//! Scope names of performance counters
+const char* const COUNTER_NAMES[PCNT_MAX] =
+{
+    "Event processing",
+    "Update",
+    "Engine update",
+    "Particle update",
+    "Game update",
+    "CBot",
+    "Render",
+    "Particle render",
+    "Interface particle render",
+    "Water render",
+    "Terrain render",
+    "Objects render",
+    "Interface render",
+    "Shadow map render",
+    "Swap buffers",
+    "Frame",
+};
+
+std::atomic<bool> g_traceActive{false};
+std::atomic<int> g_nextThreadNumber{1};
+thread_local int t_threadNumber = 0;
+
+int GetThreadNumber()
+{
+    if (t_threadNumber == 0)
+        t_threadNumber = g_nextThreadNumber++;
+    return t_threadNumber;
+}
+
+void WriteJsonString(std::ostream& stream, std::string_view text)
+{
+    stream << '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            stream << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            stream << ' ';
+        else
+            stream << c;
+    }
+    stream << '"';
+}
+
+void WriteTraceEvent(std::ostream& stream, std::string_view name, int thread,
+                     TimeStamp origin, TimeStamp start, TimeStamp end)
+{
+    stream << ",\n{\"name\":";
+    WriteJsonString(stream, name);
+    stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+           << ",\"ts\":" << TimeUtils::ExactDiff(origin, start) / 1000.0
+           << ",\"dur\":" << TimeUtils::ExactDiff(start, std::max(start, end)) / 1000.0 << "}";
+}
+
+void WriteCounterEvent(std::ostream& stream, std::string_view name,
+                       TimeStamp origin, TimeStamp time, long long value)
+{
+    stream << ",\n{\"name\":";
+    WriteJsonString(stream, name);
+    stream << ",\"ph\":\"C\",\"pid\":1,\"tid\":0"
+           << ",\"ts\":" << TimeUtils::ExactDiff(origin, time) / 1000.0
+           << ",\"args\":{\"value\":" << value << "}}";
+}
+
+} // anonymous namespace
+
 CSystemUtils* CProfiler::m_systemUtils = nullptr;
 long long CProfiler::m_performanceCounters[PCNT_MAX] = {0};
 long long CProfiler::m_prevPerformanceCounters[PCNT_MAX] = {0};
 std::stack<TimeStamp> CProfiler::m_runningPerformanceCounters;
 std::stack<PerformanceCounter> CProfiler::m_runningPerformanceCountersType;
+std::vector<ProfilerFrame> CProfiler::m_frames(PROFILER_HISTORY_FRAMES);
+int CProfiler::m_currentFrame = 0;
+int CProfiler::m_frameCount = 0;
+std::vector<int> CProfiler::m_scopeStack;
+bool CProfiler::m_traceEnabled = false;
+bool CProfiler::m_traceRequested = false;
+std::mutex CProfiler::m_taskMutex;
+std::vector<ProfilerTask> CProfiler::m_pendingTasks;
 
 void CProfiler::SetSystemUtils(CSystemUtils* systemUtils)
 {
@@ -39,7 +122,14 @@ void CProfiler::SetSystemUtils(CSystemUtils* systemUtils)
 void CProfiler::StartPerformanceCounter(PerformanceCounter counter)
 {
     if (counter == PCNT_ALL)
+    {
         ResetPerformanceCounters();
+        BeginFrame();
+    }
+    else
+    {
+        BeginScope(COUNTER_NAMES[counter]);
+    }
 
     TimeStamp timeStamp = TimeUtils::GetCurrentTimeStamp();
     m_runningPerformanceCounters.push(timeStamp);
@@ -48,6 +138,9 @@ void CProfiler::StartPerformanceCounter(PerformanceCounter counter)
 
 void CProfiler::StopPerformanceCounter(PerformanceCounter counter)
 {
+    if (counter != PCNT_ALL)
+        EndScope();
+
     assert(m_runningPerformanceCountersType.top() == counter);
     m_runningPerformanceCountersType.pop();
 
@@ -56,7 +149,10 @@ void CProfiler::StopPerformanceCounter(PerformanceCounter counter)
     m_runningPerformanceCounters.pop();
 
     if (counter == PCNT_ALL)
+    {
         SavePerformanceCounters();
+        EndFrame();
+    }
 }
 
 long long CProfiler::GetPerformanceCounterTime(PerformanceCounter counter)
@@ -86,3 +182,145 @@ void CProfiler::SavePerformanceCounters()
         m_prevPerformanceCounters[i] = m_performanceCounters[i];
     }
 }
+
+void CProfiler::BeginScope(const char* name)
+{
+    if (!m_traceEnabled)
+    {
+        m_scopeStack.push_back(-1);
+        return;
+    }
+
+    auto& scopes = m_frames[m_currentFrame].scopes;
+    ProfilerScope& scope = scopes.emplace_back();
+    scope.name = name;
+    scope.depth = static_cast<int>(m_scopeStack.size());
+    scope.start = TimeUtils::GetCurrentTimeStamp();
+    scope.end = scope.start;
+    m_scopeStack.push_back(static_cast<int>(scopes.size()) - 1);
+}
+
+void CProfiler::EndScope()
+{
+    assert(!m_scopeStack.empty());
+    if (m_scopeStack.empty())
+        return;
+
+    int index = m_scopeStack.back();
+    m_scopeStack.pop_back();
+
+    auto& scopes = m_frames[m_currentFrame].scopes;
+    if (index >= 0 && index < static_cast<int>(scopes.size()))
+        scopes[index].end = TimeUtils::GetCurrentTimeStamp();
+}
+
+void CProfiler::RecordCounter(const char* name, long long value)
+{
+    if (!m_traceEnabled)
+        return;
+
+    m_frames[m_currentFrame].counters.push_back(ProfilerCounter{name, value});
+}
+
+void CProfiler::RecordTask(std::string_view name, TimeStamp start, TimeStamp end)
+{
+    if (!g_traceActive)
+        return;
+
+    int thread = GetThreadNumber();
+
+    std::lock_guard<std::mutex> lock{m_taskMutex};
+    m_pendingTasks.push_back(ProfilerTask{std::string(name), thread, start, end});
+}
+
+void CProfiler::SetTraceEnabled(bool enabled)
+{
+    m_traceRequested = enabled;
+}
+
+bool CProfiler::GetTraceEnabled()
+{
+    return m_traceRequested;
+}
+
+int CProfiler::GetFrameCount()
+{
+    return m_frameCount;
+}
+
+long long CProfiler::GetFrameTimePercentile(float percentile)
+{
+    if (m_frameCount == 0)
+        return 0;
+
+    std::vector<long long> times(m_frameCount);
+    for (int i = 0; i < m_frameCount; ++i)
+    {
+        const ProfilerFrame& frame = m_frames[(m_currentFrame - 1 - i + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES];
+        times[i] = TimeUtils::ExactDiff(frame.start, frame.end);
+    }
+
+    int index = std::clamp(static_cast<int>(percentile / 100.0f * m_frameCount), 0, m_frameCount - 1);
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+}
+
+void CProfiler::WriteChromeTrace(std::ostream& stream)
+{
+    int first = (m_currentFrame - m_frameCount + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+    TimeStamp origin = m_frameCount > 0 ? m_frames[first].start : TimeUtils::GetCurrentTimeStamp();
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Main\"}}";
+
+    for (int i = 0; i < m_frameCount; ++i)
+    {
+        const ProfilerFrame& frame = m_frames[(first + i) % PROFILER_HISTORY_FRAMES];
+
+        WriteTraceEvent(stream, COUNTER_NAMES[PCNT_ALL], 0, origin, frame.start, frame.end);
+
+        for (const auto& scope : frame.scopes)
+            WriteTraceEvent(stream, scope.name, 0, origin, scope.start, scope.end);
+
+        for (const auto& task : frame.tasks)
+            WriteTraceEvent(stream, task.name, task.thread, origin, task.start, task.end);
+
+        for (const auto& counter : frame.counters)
+            WriteCounterEvent(stream, counter.name, origin, frame.end, counter.value);
+    }
+
+    stream << "\n]}\n";
+}
+
+void CProfiler::BeginFrame()
+{
+    m_traceEnabled = m_traceRequested;
+    g_traceActive = m_traceEnabled;
+
+    ProfilerFrame& frame = m_frames[m_currentFrame];
+    frame.scopes.clear();
+    frame.tasks.clear();
+    frame.counters.clear();
+    frame.start = TimeUtils::GetCurrentTimeStamp();
+    frame.end = frame.start;
+
+    // scopes left open by previous frame would have wrong indexes
+    std::fill(m_scopeStack.begin(), m_scopeStack.end(), -1);
+}
+
+void CProfiler::EndFrame()
+{
+    ProfilerFrame& frame = m_frames[m_currentFrame];
+    frame.end = TimeUtils::GetCurrentTimeStamp();
+
+    {
+        std::lock_guard<std::mutex> lock{m_taskMutex};
+        if (m_traceEnabled)
+            frame.tasks.swap(m_pendingTasks);
+        m_pendingTasks.clear();
+    }
+
+    m_currentFrame = (m_currentFrame + 1) % PROFILER_HISTORY_FRAMES;
+    m_frameCount = std::min(m_frameCount + 1, PROFILER_HISTORY_FRAMES);
+}
@@ -21,10 +21,18 @@
 
 #include "common/timeutils.h"
 
+#include <mutex>
+#include <ostream>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <vector>
 
 class CSystemUtils;
 
+//! Number of frames kept in profiler history
+const int PROFILER_HISTORY_FRAMES = 300;
+
 /**
  * \enum PerformanceCounter
  * \brief Type of counter testing performance
@@ -55,6 +63,73 @@ enum PerformanceCounter
     PCNT_MAX
 };
 
+/**
+ * \struct ProfilerScope
+ * \brief Time spent in a named scope on the main thread during one frame
+ */
+struct ProfilerScope
+{
+    //! Name of the scope, must be a string with static storage
+    const char* name = nullptr;
+    //! Number of enclosing scopes
+    int depth = 0;
+    TimeUtils::TimeStamp start;
+    TimeUtils::TimeStamp end;
+};
+
+/**
+ * \struct ProfilerTask
+ * \brief Task run on the thread pool during one frame
+ */
+struct ProfilerTask
+{
+    std::string name;
+    //! Small number identifying the thread
+    int thread = 0;
+    TimeUtils::TimeStamp start;
+    TimeUtils::TimeStamp end;
+};
+
+/**
+ * \struct ProfilerCounter
+ * \brief Value of a named counter at the end of one frame
+ */
+struct ProfilerCounter
+{
+    //! Name of the counter, must be a string with static storage
+    const char* name = nullptr;
+    long long value = 0;
+};
+
+/**
+ * \struct ProfilerFrame
+ * \brief Profiling data of one frame
+ */
+struct ProfilerFrame
+{
+    TimeUtils::TimeStamp start;
+    TimeUtils::TimeStamp end;
+    //! Scopes in order they were started; only filled when tracing
+    std::vector<ProfilerScope> scopes;
+    //! Thread pool tasks finished during the frame; only filled when tracing
+    std::vector<ProfilerTask> tasks;
+    //! Counters recorded during the frame; only filled when tracing
+    std::vector<ProfilerCounter> counters;
+};
+
+/**
+ * \class CProfiler
+ * \brief Measures time spent in parts of the frame
+ *
+ * Performance counters sum time of fixed parts of the frame for the stats display.
+ *
+ * Scopes are named and can be nested in any way. Each performance counter is also a scope.
+ * Frames are delimited by PCNT_ALL; the last PROFILER_HISTORY_FRAMES of them are kept in
+ * a ring buffer. Frame times are always recorded, scopes, counters and thread pool tasks only
+ * when tracing is enabled, and can be written as Chrome trace events (chrome://tracing, Perfetto).
+ *
+ * Scopes and counters must only be used from the main thread.
+ */
 class CProfiler
 {
 public:
@@ -65,10 +140,36 @@ public:
     static long long GetPerformanceCounterTime(PerformanceCounter counter);
     static float GetPerformanceCounterFraction(PerformanceCounter counter);
 
+    //! Starts named scope; \a name must have static storage
+    static void BeginScope(const char* name);
+    //! Ends the last started scope
+    static void EndScope();
+
+    //! Records value of named counter in current frame; \a name must have static storage
+    static void RecordCounter(const char* name, long long value);
+
+    //! Records task run on another thread; can be called from any thread
+    static void RecordTask(std::string_view name, TimeUtils::TimeStamp start, TimeUtils::TimeStamp end);
+
+    //! Enables recording of scopes and tasks, from the next frame
+    static void SetTraceEnabled(bool enabled);
+    static bool GetTraceEnabled();
+
+    //! Returns number of frames in history
+    static int GetFrameCount();
+    //! Returns given percentile (0-100) of frame time in history, in nanoseconds
+    static long long GetFrameTimePercentile(float percentile);
+
+    //! Writes frames in history as Chrome trace event JSON
+    static void WriteChromeTrace(std::ostream& stream);
+
 private:
     static void ResetPerformanceCounters();
     static void SavePerformanceCounters();
 
+    static void BeginFrame();
+    static void EndFrame();
+
 private:
     static CSystemUtils* m_systemUtils;
 
@@ -76,6 +177,38 @@ private:
     static long long m_prevPerformanceCounters[PCNT_MAX];
     static std::stack<TimeUtils::TimeStamp> m_runningPerformanceCounters;
     static std::stack<PerformanceCounter> m_runningPerformanceCountersType;
-};
 
+    static std::vector<ProfilerFrame> m_frames;
+    //! Frame being recorded
+    static int m_currentFrame;
+    //! Number of finished frames in history
+    static int m_frameCount;
+    //! Indexes of scopes in current frame, -1 for scopes not recorded
+    static std::vector<int> m_scopeStack;
+    static bool m_traceEnabled;
+    static bool m_traceRequested;
+
+    static std::mutex m_taskMutex;
+    static std::vector<ProfilerTask> m_pendingTasks;
+};
 
+/**
+ * \class CProfilerScope
+ * \brief Profiler scope lasting until the end of the C++ scope
+ */
+class CProfilerScope
+{
+public:
+    explicit CProfilerScope(const char* name)
+    {
+        CProfiler::BeginScope(name);
+    }
+
+    ~CProfilerScope()
+    {
+        CProfiler::EndScope();
+    }
+
+    CProfilerScope(const CProfilerScope&) = delete;
+    CProfilerScope& operator=(const CProfilerScope&) = delete;
+};
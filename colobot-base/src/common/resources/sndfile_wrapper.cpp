@@ -124,3 +124,8 @@ sf_count_t CSNDFileWrapper::Read(short int *ptr, sf_count_t items)
 {
     return sf_read_short(m_snd_file, ptr, items);
 }
+
+sf_count_t CSNDFileWrapper::Seek(sf_count_t frames)
+{
+    return sf_seek(m_snd_file, frames, SEEK_SET);
+}
@@ -43,6 +43,7 @@ public:
     const std::string& GetLastError() const;
 
     sf_count_t Read(short int *ptr, sf_count_t items);
+    sf_count_t Seek(sf_count_t frames);
 
 private:
     SF_INFO m_file_info = {};
@@ -127,6 +127,9 @@ void InitializeRestext()
     stringsText[RT_STUDIO_COMPOK]    = TR("Compilation ok (0 errors)");
     stringsText[RT_STUDIO_PROGSTOP]  = TR("Program finished");
     stringsText[RT_STUDIO_CLONED]    = TR("Program cloned");
+    stringsText[RT_STUDIO_PROFILE_TOTAL] = TR("Total");
+    stringsText[RT_STUDIO_PROFILE_ENTRY] = TR("%s: %ld instr (%.1f%%), %.2f ms, %ld alloc");
+    stringsText[RT_STUDIO_PROFILE_LINE]  = TR("  line %d");
 
     stringsText[RT_PROGRAM_READONLY] = TR("This program is read-only, clone it to edit");
     stringsText[RT_PROGRAM_EXAMPLE]  = TR("This is example code that cannot be run directly");
@@ -509,6 +512,7 @@ void InitializeRestext()
     stringsEvent[EVENT_STUDIO_RUN]          = TR("Execute/stop");
     stringsEvent[EVENT_STUDIO_REALTIME]     = TR("Pause/continue");
     stringsEvent[EVENT_STUDIO_STEP]         = TR("One step");
+    stringsEvent[EVENT_STUDIO_PROFILE]      = TR("Profile program");
 
 
 
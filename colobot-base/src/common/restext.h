@@ -115,6 +115,9 @@ enum ResTextType
     RT_STUDIO_COMPOK        = 121,
     RT_STUDIO_PROGSTOP      = 122,
     RT_STUDIO_CLONED        = 123,
+    RT_STUDIO_PROFILE_TOTAL = 124,
+    RT_STUDIO_PROFILE_ENTRY = 125,
+    RT_STUDIO_PROFILE_LINE  = 126,
 
     RT_PROGRAM_READONLY     = 130,
     RT_PROGRAM_EXAMPLE      = 131,
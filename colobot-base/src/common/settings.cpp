@@ -31,6 +31,8 @@
 
 #include "level/robotmain.h"
 
+#include "script/script_scheduler.h"
+
 #include "sound/sound.h"
 
 void CSettings::SaveResolutionSettings(const Gfx::DeviceConfig& config)
@@ -90,6 +92,11 @@ void CSettings::SaveSettings()
     GetConfigFile().SetBoolProperty("Experimental", "TerrainShadows", engine->GetTerrainShadows());
     GetConfigFile().SetIntProperty("Setup", "VSync", engine->GetVSync());
 
+    CScriptScheduler* scheduler = main->GetScriptScheduler();
+    GetConfigFile().SetIntProperty("Setup", "CBotInstructionBudget", scheduler->GetInstructionBudget());
+    GetConfigFile().SetFloatProperty("Setup", "CBotTimeBudget", scheduler->GetTimeBudget());
+    GetConfigFile().SetBoolProperty("Setup", "CBotDeterministic", scheduler->GetDeterministic());
+
     CInput::GetInstancePointer()->SaveKeyBindings();
 
 
@@ -267,6 +274,16 @@ void CSettings::LoadSettings()
         engine->SetVSync(iValue);
     }
 
+    CScriptScheduler* scheduler = main->GetScriptScheduler();
+    if (GetConfigFile().GetIntProperty("Setup", "CBotInstructionBudget", iValue))
+        scheduler->SetInstructionBudget(iValue);
+
+    if (GetConfigFile().GetFloatProperty("Setup", "CBotTimeBudget", fValue))
+        scheduler->SetTimeBudget(fValue);
+
+    if (GetConfigFile().GetBoolProperty("Setup", "CBotDeterministic", bValue))
+        scheduler->SetDeterministic(bValue);
+
     CInput::GetInstancePointer()->LoadKeyBindings();
 
 
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/task_graph.h"
+
+#include "common/thread/thread_pool.h"
+
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+
+struct CTaskGraph::RunState
+{
+    std::vector<Node> nodes;
+    //! Number of unfinished dependencies of each task
+    std::unique_ptr<std::atomic<int>[]> pending;
+    //! Set for tasks depending on a failed task
+    std::unique_ptr<std::atomic<bool>[]> skipped;
+    std::atomic<std::size_t> remaining{0};
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::promise<void> done;
+};
+
+CTaskGraph::TaskId CTaskGraph::AddTask(std::string name, std::function<void()> func)
+{
+    m_nodes.push_back(Node{std::move(name), std::move(func), {}, 0});
+    return m_nodes.size() - 1;
+}
+
+void CTaskGraph::AddDependency(TaskId task, TaskId dependency)
+{
+    assert(task < m_nodes.size() && dependency < m_nodes.size());
+
+    m_nodes[dependency].dependents.push_back(task);
+    ++m_nodes[task].dependencyCount;
+}
+
+std::size_t CTaskGraph::GetTaskCount() const
+{
+    return m_nodes.size();
+}
+
+std::future<void> CTaskGraph::Run(CThreadPool& pool) const
+{
+    auto state = std::make_shared<RunState>();
+    state->nodes = m_nodes;
+    auto future = state->done.get_future();
+
+    std::size_t count = m_nodes.size();
+    if (count == 0)
+    {
+        state->done.set_value();
+        return future;
+    }
+
+    // check that every task can be reached, ie. there are no cycles
+    std::vector<int> dependencyCounts(count);
+    std::vector<TaskId> ready;
+    for (TaskId id = 0; id < count; ++id)
+    {
+        dependencyCounts[id] = m_nodes[id].dependencyCount;
+        if (dependencyCounts[id] == 0)
+            ready.push_back(id);
+    }
+
+    std::vector<TaskId> roots = ready;
+    std::size_t reached = 0;
+    while (!ready.empty())
+    {
+        TaskId id = ready.back();
+        ready.pop_back();
+        ++reached;
+        for (TaskId dependent : m_nodes[id].dependents)
+        {
+            if (--dependencyCounts[dependent] == 0)
+                ready.push_back(dependent);
+        }
+    }
+
+    if (reached != count)
+    {
+        state->done.set_exception(std::make_exception_ptr(std::logic_error("Task graph contains a cycle")));
+        return future;
+    }
+
+    state->pending = std::make_unique<std::atomic<int>[]>(count);
+    state->skipped = std::make_unique<std::atomic<bool>[]>(count);
+    for (TaskId id = 0; id < count; ++id)
+    {
+        state->pending[id] = m_nodes[id].dependencyCount;
+        state->skipped[id] = false;
+    }
+    state->remaining = count;
+
+    for (TaskId id : roots)
+        StartTask(pool, state, id);
+
+    return future;
+}
+
+void CTaskGraph::StartTask(CThreadPool& pool, const std::shared_ptr<RunState>& state, TaskId id)
+{
+    pool.Post(state->nodes[id].name, [&pool, state, id]()
+    {
+        Node& node = state->nodes[id];
+
+        bool failed = state->skipped[id];
+        if (!failed)
+        {
+            try
+            {
+                node.func();
+            }
+            catch (...)
+            {
+                failed = true;
+                std::lock_guard<std::mutex> lock{state->errorMutex};
+                if (!state->error)
+                    state->error = std::current_exception();
+            }
+        }
+
+        for (TaskId dependent : node.dependents)
+        {
+            if (failed)
+                state->skipped[dependent] = true;
+
+            if (--state->pending[dependent] == 0)
+                StartTask(pool, state, dependent);
+        }
+
+        if (--state->remaining == 0)
+        {
+            if (state->error)
+                state->done.set_exception(state->error);
+            else
+                state->done.set_value();
+        }
+    });
+}
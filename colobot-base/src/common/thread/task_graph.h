@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/thread/task_graph.h
+ * \brief Set of tasks with dependencies run on the thread pool
+ */
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CThreadPool;
+
+/**
+ * \class CTaskGraph
+ * \brief Tasks run on CThreadPool after all tasks they depend on have finished
+ *
+ * Example:
+ * \code
+ * CTaskGraph graph;
+ * auto terrain = graph.AddTask("terrain", [&]() { GenerateTerrain(); });
+ * auto textures = graph.AddTask("textures", [&]() { DecodeTextures(); });
+ * auto objects = graph.AddTask("objects", [&]() { PlaceObjects(); });
+ * graph.AddDependency(objects, terrain);
+ * graph.Run(*GetThreadPool()).wait();
+ * \endcode
+ *
+ * If a task throws, tasks depending on it are skipped and the exception is rethrown
+ * from the future returned by Run().
+ */
+class CTaskGraph
+{
+public:
+    using TaskId = std::size_t;
+
+    //! Adds task to the graph
+    TaskId AddTask(std::string name, std::function<void()> func);
+    //! Makes \a task start only after \a dependency has finished
+    void AddDependency(TaskId task, TaskId dependency);
+
+    //! Starts tasks without dependencies; the graph may be modified or destroyed afterwards
+    std::future<void> Run(CThreadPool& pool) const;
+
+    std::size_t GetTaskCount() const;
+
+private:
+    struct Node
+    {
+        std::string name;
+        std::function<void()> func;
+        std::vector<TaskId> dependents;
+        int dependencyCount = 0;
+    };
+
+    struct RunState;
+    static void StartTask(CThreadPool& pool, const std::shared_ptr<RunState>& state, TaskId id);
+
+    std::vector<Node> m_nodes;
+};
@@ -0,0 +1,264 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/thread_pool.h"
+
+#include "common/logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+
+
+namespace
+{
+thread_local const CThreadPool* t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+} // anonymous namespace
+
+CThreadPool::CThreadPool(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = GetDefaultThreadCount();
+
+    GetLogger()->Debug("Starting thread pool with %% threads", threadCount);
+
+    for (int i = 0; i < threadCount; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+
+    // all workers must exist before any of them starts stealing
+    for (int i = 0; i < threadCount; ++i)
+        m_workers[i]->thread = std::thread{&CThreadPool::Run, this, i};
+}
+
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_sleepMutex};
+        m_running = false;
+    }
+    m_sleepCond.notify_all();
+
+    for (auto& worker : m_workers)
+        worker->thread.join();
+}
+
+int CThreadPool::GetDefaultThreadCount()
+{
+    // at least two, so that one busy task can't hold up serial queues, e.g. sound streaming
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(2, cores - 1);
+}
+
+int CThreadPool::GetThreadCount() const
+{
+    return static_cast<int>(m_workers.size());
+}
+
+void CThreadPool::Post(std::string name, Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_sleepMutex};
+        ++m_unfinished;
+        ++m_queued;
+    }
+
+    int index = 0;
+    if (IsWorkerThread())
+        index = t_workerIndex;
+    else
+        index = m_nextWorker++ % m_workers.size();
+
+    {
+        Worker& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        worker.jobs.push_back(Job{std::move(name), std::move(task)});
+    }
+
+    m_sleepCond.notify_one();
+}
+
+void CThreadPool::WaitIdle()
+{
+    assert(!IsWorkerThread());
+
+    std::unique_lock<std::mutex> lock{m_sleepMutex};
+    m_idleCond.wait(lock, [&]() { return m_unfinished == 0; });
+}
+
+bool CThreadPool::IsWorkerThread() const
+{
+    return t_pool == this;
+}
+
+void CThreadPool::SetProfilingHook(ProfilingHook hook)
+{
+    std::lock_guard<std::mutex> lock{m_hookMutex};
+    m_profilingHook = std::move(hook);
+}
+
+void CThreadPool::Run(int index)
+{
+    t_pool = this;
+    t_workerIndex = index;
+
+    while (true)
+    {
+        Job job;
+        if (TakeJob(index, job))
+        {
+            RunJob(job);
+
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            if (--m_unfinished == 0)
+                m_idleCond.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_sleepMutex};
+        m_sleepCond.wait(lock, [&]() { return !m_running || m_queued > 0; });
+        if (!m_running && m_queued == 0)
+            break;
+    }
+
+    t_pool = nullptr;
+    t_workerIndex = -1;
+}
+
+bool CThreadPool::TakeJob(int index, Job& job)
+{
+    // newest task from own queue
+    {
+        Worker& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        if (!worker.jobs.empty())
+        {
+            job = std::move(worker.jobs.back());
+            worker.jobs.pop_back();
+            --m_queued;
+            return true;
+        }
+    }
+
+    // oldest task of another worker
+    for (std::size_t i = 1; i < m_workers.size(); ++i)
+    {
+        Worker& worker = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        if (!worker.jobs.empty())
+        {
+            job = std::move(worker.jobs.front());
+            worker.jobs.pop_front();
+            --m_queued;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CThreadPool::RunJob(Job& job)
+{
+    ProfilingHook hook;
+    {
+        std::lock_guard<std::mutex> lock{m_hookMutex};
+        if (m_profilingHook)
+            hook = m_profilingHook;
+    }
+
+    auto start = TimeUtils::GetCurrentTimeStamp();
+
+    try
+    {
+        job.task();
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Error("Exception in task \"%%\": %%", job.name, e.what());
+    }
+    catch (...)
+    {
+        GetLogger()->Error("Unknown exception in task \"%%\"", job.name);
+    }
+
+    if (hook)
+        hook(job.name, start, TimeUtils::GetCurrentTimeStamp());
+}
+
+
+CSerialQueue::CSerialQueue(CThreadPool& pool, std::string name)
+    : m_pool(pool),
+      m_name(std::move(name))
+{
+}
+
+CSerialQueue::~CSerialQueue()
+{
+    Clear();
+}
+
+void CSerialQueue::Post(CThreadPool::Task task)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_tasks.push(std::move(task));
+    if (!m_scheduled)
+    {
+        m_scheduled = true;
+        m_pool.Post(m_name, [this]() { Drain(); });
+    }
+}
+
+void CSerialQueue::Clear()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_tasks = {};
+    m_cond.wait(lock, [&]() { return !m_scheduled; });
+}
+
+void CSerialQueue::Drain()
+{
+    while (true)
+    {
+        CThreadPool::Task task;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_tasks.empty())
+            {
+                m_scheduled = false;
+                m_cond.notify_all();
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            GetLogger()->Error("Exception in task \"%%\": %%", m_name, e.what());
+        }
+        catch (...)
+        {
+            GetLogger()->Error("Unknown exception in task \"%%\"", m_name);
+        }
+    }
+}
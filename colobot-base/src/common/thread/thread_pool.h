@@ -0,0 +1,171 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/thread/thread_pool.h
+ * \brief Shared pool of worker threads
+ */
+
+#pragma once
+
+#include "common/singleton.h"
+#include "common/timeutils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \class CThreadPool
+ * \brief Work-stealing pool of threads running short tasks in background
+ *
+ * Every worker has its own queue. Tasks posted from a worker go to its own queue and are
+ * taken from its back, other tasks are distributed between the workers. A worker without
+ * tasks steals from the front of the queues of other workers.
+ *
+ * Tasks must not wait for results of other tasks of the pool, as all workers could end up
+ * waiting. Use CTaskGraph to run tasks that depend on each other.
+ *
+ * The pool is created by CApplication and available through GetThreadPool().
+ */
+class CThreadPool : public CSingleton<CThreadPool>
+{
+public:
+    using Task = std::function<void()>;
+    //! Called from the worker thread after each task, with its name and run time
+    using ProfilingHook = std::function<void(std::string_view name, TimeUtils::TimeStamp start, TimeUtils::TimeStamp end)>;
+
+public:
+    //! Creates pool with given number of threads, 0 means GetDefaultThreadCount()
+    explicit CThreadPool(int threadCount = 0);
+    ~CThreadPool() override;
+
+    CThreadPool(const CThreadPool&) = delete;
+    CThreadPool& operator=(const CThreadPool&) = delete;
+
+    //! Returns number of threads used by default: one less than the number of cores, at least two
+    static int GetDefaultThreadCount();
+    int GetThreadCount() const;
+
+    //! Queues a task without a result
+    void Post(std::string name, Task task);
+
+    //! Queues a function and returns future of its result
+    template<typename F>
+    auto Submit(std::string name, F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        Post(std::move(name), [task]() { (*task)(); });
+        return future;
+    }
+
+    //! Waits until all queued tasks are finished; must not be called from a task
+    void WaitIdle();
+
+    //! Returns true if called from one of the pool's threads
+    bool IsWorkerThread() const;
+
+    //! Sets function called after each task, or removes it if empty
+    void SetProfilingHook(ProfilingHook hook);
+
+private:
+    struct Job
+    {
+        std::string name;
+        Task task;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    void Run(int index);
+    bool TakeJob(int index, Job& job);
+    void RunJob(Job& job);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    //! Worker which gets the next task posted from outside the pool
+    std::atomic<unsigned int> m_nextWorker{0};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCond;
+    std::condition_variable m_idleCond;
+    //! Tasks queued, but not yet taken by a worker
+    std::atomic<int> m_queued{0};
+    //! Tasks queued or running
+    int m_unfinished = 0;
+    bool m_running = true;
+
+    std::mutex m_hookMutex;
+    ProfilingHook m_profilingHook;
+};
+
+/**
+ * \class CSerialQueue
+ * \brief Runs tasks on the thread pool one at a time, in order they were posted
+ *
+ * Used for work which isn't thread safe, like OpenAL calls in CALSound.
+ * Tasks not yet started are dropped when the queue is destroyed.
+ */
+class CSerialQueue
+{
+public:
+    CSerialQueue(CThreadPool& pool, std::string name);
+    ~CSerialQueue();
+
+    CSerialQueue(const CSerialQueue&) = delete;
+    CSerialQueue& operator=(const CSerialQueue&) = delete;
+
+    void Post(CThreadPool::Task task);
+
+    //! Drops tasks not yet started and waits for the running one to finish; must not be called from a task
+    void Clear();
+
+private:
+    void Drain();
+
+    CThreadPool& m_pool;
+    std::string m_name;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::queue<CThreadPool::Task> m_tasks;
+    //! Drain() is queued or running on the pool
+    bool m_scheduled = false;
+};
+
+inline CThreadPool* GetThreadPool()
+{
+    return CThreadPool::GetInstancePointer();
+}
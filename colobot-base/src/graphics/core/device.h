@@ -361,7 +361,7 @@ public:
     virtual void CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height) = 0;
 
     //! Returns the pixels of the entire screen
-    virtual std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() const = 0;
+    virtual std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() = 0;
 
     //! Returns framebuffer with given name or nullptr if it doesn't exist
     virtual CFramebuffer* GetFramebuffer(std::string name) = 0;
@@ -61,6 +61,18 @@ struct ShadowParam
     glm::vec2 uv_scale;
 };
 
+/**
+ * \struct UIRendererStatistics
+ * \brief Counts of primitives passed to UI renderer and draw calls issued for them
+ */
+struct UIRendererStatistics
+{
+    //! Number of BeginPrimitive()/EndPrimitive() pairs
+    int primitives = 0;
+    //! Number of draw calls they were merged into
+    int drawCalls = 0;
+};
+
 /**
  * \class CRenderer
  * \brief Common abstract interface for renderers
@@ -74,6 +86,10 @@ public:
 /**
  * \class CUIRenderer
  * \brief Abstract interface for UI renderers
+ *
+ * Primitives may be buffered and drawn later, in the order they were given.
+ * Consecutive primitives with the same state can be merged into one draw call.
+ * The device flushes buffered primitives before drawing anything else.
  */
 class CUIRenderer : public CRenderer
 {
@@ -92,6 +108,14 @@ public:
     virtual Vertex2D* BeginPrimitive(PrimitiveType type, int count) = 0;
     virtual Vertex2D* BeginPrimitives(PrimitiveType type, int drawCount, const int* counts) = 0;
     virtual bool EndPrimitive() = 0;
+
+    //! Draws all buffered primitives
+    virtual void Flush() = 0;
+
+    //! Returns statistics gathered since the last reset
+    virtual UIRendererStatistics GetStatistics() const = 0;
+    //! Resets statistics
+    virtual void ResetStatistics() = 0;
 };
 
 /**
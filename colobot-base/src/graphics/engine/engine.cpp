@@ -30,6 +30,7 @@
 #include "common/stringutils.h"
 
 #include "common/system/system.h"
+#include "common/thread/thread_pool.h"
 
 #include "graphics/core/device.h"
 #include "graphics/core/framebuffer.h"
@@ -47,6 +48,7 @@
 #include "graphics/engine/pyro_manager.h"
 #include "graphics/engine/terrain.h"
 #include "graphics/engine/text.h"
+#include "graphics/engine/triangle_bvh.h"
 #include "graphics/engine/water.h"
 
 #include "graphics/model/model_mesh.h"
@@ -57,6 +59,8 @@
 
 #include "math/geometry.h"
 
+#include "script/script_scheduler.h"
+
 #include "sound/sound.h"
 
 #include "ui/controls/interface.h"
@@ -64,7 +68,6 @@
 #include <iomanip>
 #include <SDL_surface.h>
 #include <SDL_thread.h>
-#include <thread>
 
 using TimeUtils::TimeUnit;
 
@@ -90,9 +93,6 @@ struct EngineBaseObjDataTier
     Texture                 materialTexture;
     Texture                 normalTexture;
     Texture                 detailTexture;
-
-    glm::vec2               uvOffset = { 0.0f, 0.0f };
-    glm::vec2               uvScale = { 1.0f, 1.0f };
 };
 
 /**
@@ -113,6 +113,8 @@ struct EngineBaseObject
     glm::vec3           bboxMax{ 0, 0, 0 };
     //! A bounding sphere that contains all the vertices in this EngineBaseObject
     Math::Sphere           boundingSphere;
+    //! Triangle hierarchy for picking, built on first use and shared by copies
+    std::shared_ptr<const CTriangleBVH> bvh;
     //! Next tier
     std::vector<EngineBaseObjDataTier> next;
 
@@ -515,9 +517,12 @@ void CEngine::FrameUpdate()
     m_particle->FrameParticle(rTime);
     CProfiler::StopPerformanceCounter(PCNT_UPDATE_PARTICLE);
 
-    ComputeDistance();
-    UpdateGeometry();
-    UpdateStaticBuffers();
+    {
+        CProfilerScope scope("Geometry update");
+        ComputeDistance();
+        UpdateGeometry();
+        UpdateStaticBuffers();
+    }
 
     m_highlightTime = m_app->GetAbsTime();
 
@@ -554,7 +559,7 @@ void CEngine::FrameUpdate()
 
 void CEngine::WriteScreenShot(const std::filesystem::path& fileName)
 {
-    auto data = std::make_unique<WriteScreenShotData>();
+    auto data = std::make_shared<WriteScreenShotData>();
     data->img = std::make_unique<CImage>(glm::ivec2(m_size.x, m_size.y));
 
     auto pixels = m_device->GetFrameBufferPixels();
@@ -563,10 +568,10 @@ void CEngine::WriteScreenShot(const std::filesystem::path& fileName)
 
     data->fileName = fileName;
 
-    std::thread{&CEngine::WriteScreenShotThread, std::move(data)}.detach();
+    GetThreadPool()->Post("Write screenshot", [data]() { WriteScreenShotTask(data); });
 }
 
-void CEngine::WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data)
+void CEngine::WriteScreenShotTask(const std::shared_ptr<WriteScreenShotData>& data)
 {
     if ( data->img->SavePNG(data->fileName) )
     {
@@ -801,6 +806,7 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<Vertex3D>&
     }
 
     p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
+    p1.bvh.reset();
 
     p1.totalTriangles += vertices.size() / 3;
 }
@@ -960,6 +966,18 @@ void CEngine::SetObjectTransform(int objRank, const glm::mat4& transform)
     m_objects[objRank].transform = transform;
 }
 
+void CEngine::SetObjectTransforms(std::span<const int> objRanks, std::span<const glm::mat4> transforms)
+{
+    assert(objRanks.size() == transforms.size());
+
+    for (std::size_t i = 0; i < objRanks.size(); ++i)
+    {
+        assert(objRanks[i] >= 0 && objRanks[i] < static_cast<int>( m_objects.size() ));
+
+        m_objects[objRanks[i]].transform = transforms[i];
+    }
+}
+
 void CEngine::GetObjectTransform(int objRank, glm::mat4& transform)
 {
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
@@ -1097,46 +1115,41 @@ void CEngine::ChangeSecondTexture(int objRank, const std::filesystem::path& tex2
 {
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
 
-    int baseObjRank = m_objects[objRank].baseObjRank;
-    if (baseObjRank == -1)
-        return;
-
-    assert(baseObjRank >= 0 && baseObjRank < static_cast<int>( m_baseObjects.size() ));
-
-    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-
-    std::filesystem::path tex2Path = "textures" / tex2Name;
-    for (auto& data : p1.next)
-    {
-        if (data.material.detailTexture == tex2Path)
-            continue;  // already new
-
-        data.material.detailTexture = tex2Path;
-
-        data.detailTexture = LoadTexture(tex2Path);
-    }
+    m_objects[objRank].detailTexture = LoadTexture("textures" / tex2Name);
 }
 
 void CEngine::SetUVTransform(int objRank, const std::string& tag, const glm::vec2& offset, const glm::vec2& scale)
 {
     assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
 
-    int baseObjRank = m_objects[objRank].baseObjRank;
-    if (baseObjRank == -1)
-        return;
+    auto& uvTransforms = m_objects[objRank].uvTransforms;
+    for (auto& uvTransform : uvTransforms)
+    {
+        if (uvTransform.tag == tag)
+        {
+            uvTransform.offset = offset;
+            uvTransform.scale = scale;
+            return;
+        }
+    }
 
-    assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
+    uvTransforms.push_back({ tag, offset, scale });
+}
 
-    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
+void CEngine::SetObjectMaterialParams(CObjectRenderer* objectRenderer, const EngineObject& object, const EngineBaseObjDataTier& data)
+{
+    objectRenderer->SetDetailTexture(object.detailTexture.Valid() ? object.detailTexture : data.detailTexture);
 
-    for (auto& data : p1.next)
+    for (const auto& uvTransform : object.uvTransforms)
     {
-        if (data.material.tag == tag)
+        if (uvTransform.tag == data.material.tag)
         {
-            data.uvOffset = offset;
-            data.uvScale = scale;
+            objectRenderer->SetUVTransform(uvTransform.offset, uvTransform.scale);
+            return;
         }
     }
+
+    objectRenderer->SetUVTransform({ 0.0f, 0.0f }, { 1.0f, 1.0f });
 }
 
 void CEngine::CreateShadowSpot(int objRank)
@@ -1485,6 +1498,7 @@ void CEngine::UpdateGeometry()
         }
 
         object.boundingSphere = Math::BoundingSphereForBox(object.bboxMin, object.bboxMax);
+        object.bvh.reset();
     }
 
     m_updateGeometry = false;
@@ -1543,66 +1557,35 @@ void CEngine::Update()
     UpdateStaticBuffers();
 }
 
-bool CEngine::DetectBBox(int objRank, const glm::vec2& mouse)
+int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool terrain)
 {
-    assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
-
-    int baseObjRank = m_objects[objRank].baseObjRank;
-    if (baseObjRank == -1)
-        return false;
-
-    assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
-
-    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-
-    glm::vec2 min, max;
-    min.x =  1000000.0f;
-    min.y =  1000000.0f;
-    max.x = -1000000.0f;
-    max.y = -1000000.0f;
+    // Ray through the mouse position; its direction has unit depth in view space,
+    // so t is the view depth of the hit, like the distance given by TransformPoint()
+    glm::mat4 matViewInverse = glm::inverse(m_matView);
+    glm::vec3 origin = Math::Transform(matViewInverse, glm::vec3(0.0f, 0.0f, 0.0f));
+    glm::vec3 dir = glm::mat3(matViewInverse) * glm::vec3(
+        (mouse.x*2.0f-1.0f) / m_matProj[0][0],
+        (mouse.y*2.0f-1.0f) / m_matProj[1][1],
+        1.0f);
+
+    const float tMin = 2.0f;
+    float tMax = 1000000.0f;
+    int nearest = -1;
 
-    for (int i = 0; i < 8; i++)
+    if (terrain && m_terrain != nullptr)
     {
-        glm::vec3 p{ 0, 0, 0 };
-
-        if ( i & (1<<0) )  p.x = p1.bboxMin.x;
-        else               p.x = p1.bboxMax.x;
-        if ( i & (1<<1) )  p.y = p1.bboxMin.y;
-        else               p.y = p1.bboxMax.y;
-        if ( i & (1<<2) )  p.z = p1.bboxMin.z;
-        else               p.z = p1.bboxMax.z;
-
-        glm::vec3 pp{ 0, 0, 0 };
-        if ( TransformPoint(pp, objRank, p) )
-        {
-            if (pp.x < min.x) min.x = pp.x;
-            if (pp.x > max.x) max.x = pp.x;
-            if (pp.y < min.y) min.y = pp.y;
-            if (pp.y > max.y) max.y = pp.y;
-        }
+        int objRank = -1;
+        if (m_terrain->IntersectRay(origin, dir, tMin, tMax, objRank))
+            nearest = objRank;
     }
 
-    return ( mouse.x >= min.x &&
-             mouse.x <= max.x &&
-             mouse.y >= min.y &&
-             mouse.y <= max.y );
-}
-
-int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool terrain)
-{
-    float min = 1000000.0f;
-    int nearest = -1;
-    glm::vec3 pos{ 0, 0, 0 };
-
     for (int objRank = 0; objRank < static_cast<int>( m_objects.size() ); objRank++)
     {
         if (! m_objects[objRank].used)
             continue;
 
-        if (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN && !terrain)
-            continue;
-
-        if (! DetectBBox(objRank, mouse))
+        // terrain is handled above, directly on the relief
+        if (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN)
             continue;
 
         int baseObjRank = m_objects[objRank].baseObjRank;
@@ -1615,104 +1598,57 @@ int CEngine::DetectObject(const glm::vec2& mouse, glm::vec3& targetPos, bool ter
         if (! p1.used)
             continue;
 
-        for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
-        {
-            EngineBaseObjDataTier& data = p1.next[l2];
+        // The direction is not normalized, so t in object space is the same as in world space
+        glm::mat4 matWorldInverse = glm::inverse(m_objects[objRank].transform);
+        glm::vec3 objOrigin = Math::Transform(matWorldInverse, origin);
+        glm::vec3 objDir = glm::mat3(matWorldInverse) * dir;
 
-            if (data.type == EngineTriangleType::TRIANGLES)
-            {
-                for (int i = 0; i < static_cast<int>(data.vertices.size()); i += 3)
-                {
-                    float dist = 0.0f;
-                    if (DetectTriangle(mouse, &data.vertices[i], objRank, dist, pos) && dist < min)
-                    {
-                        min = dist;
-                        nearest = objRank;
-                        targetPos = pos;
-                    }
-                }
-            }
-            else if (data.type == EngineTriangleType::SURFACE)
-            {
-                for (int i = 0; i < static_cast<int>(data.vertices.size()) - 2; i += 1)
-                {
-                    float dist = 0.0f;
-                    if (DetectTriangle(mouse, &data.vertices[i], objRank, dist, pos) && dist < min)
-                    {
-                        min = dist;
-                        nearest = objRank;
-                        targetPos = pos;
-                    }
-                }
-            }
-        }
+        float boxMin = tMin, boxMax = tMax;
+        if (! Math::IntersectRayBox(objOrigin, 1.0f / objDir, p1.bboxMin, p1.bboxMax, boxMin, boxMax))
+            continue;
+
+        if (GetBVH(p1).Intersect(objOrigin, objDir, tMin, tMax))
+            nearest = objRank;
     }
 
+    if (nearest != -1)
+        targetPos = origin + dir * tMax;
+
     return nearest;
 }
 
-bool CEngine::DetectTriangle(const glm::vec2& mouse, Vertex3D* triangle, int objRank, float& dist, glm::vec3& pos)
+const CTriangleBVH& CEngine::GetBVH(EngineBaseObject& p1)
 {
-    assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
+    if (p1.bvh != nullptr)
+        return *p1.bvh;
 
-    glm::vec3 p2D[3], p3D{ 0, 0, 0 };
+    std::vector<glm::vec3> vertices;
+    vertices.reserve(p1.totalTriangles * 3);
 
-    for (int i = 0; i < 3; i++)
+    for (const auto& data : p1.next)
     {
-        p3D.x = triangle[i].position.x;
-        p3D.y = triangle[i].position.y;
-        p3D.z = triangle[i].position.z;
-
-        if (! TransformPoint(p2D[i], objRank, p3D))
-            return false;
+        if (data.type == EngineTriangleType::TRIANGLES)
+        {
+            for (int i = 0; i + 2 < static_cast<int>(data.vertices.size()); i += 3)
+            {
+                vertices.push_back(data.vertices[i+0].position);
+                vertices.push_back(data.vertices[i+1].position);
+                vertices.push_back(data.vertices[i+2].position);
+            }
+        }
+        else if (data.type == EngineTriangleType::SURFACE)
+        {
+            for (int i = 0; i + 2 < static_cast<int>(data.vertices.size()); i += 1)
+            {
+                vertices.push_back(data.vertices[i+0].position);
+                vertices.push_back(data.vertices[i+1].position);
+                vertices.push_back(data.vertices[i+2].position);
+            }
+        }
     }
 
-    if (mouse.x < p2D[0].x &&
-        mouse.x < p2D[1].x &&
-        mouse.x < p2D[2].x)
-        return false;
-
-    if (mouse.x > p2D[0].x &&
-        mouse.x > p2D[1].x &&
-        mouse.x > p2D[2].x)
-        return false;
-
-    if (mouse.y < p2D[0].y &&
-        mouse.y < p2D[1].y &&
-        mouse.y < p2D[2].y)
-        return false;
-
-    if (mouse.y > p2D[0].y &&
-        mouse.y > p2D[1].y &&
-        mouse.y > p2D[2].y)
-        return false;
-
-    glm::vec2 a, b, c;
-    a.x = p2D[0].x;
-    a.y = p2D[0].y;
-    b.x = p2D[1].x;
-    b.y = p2D[1].y;
-    c.x = p2D[2].x;
-    c.y = p2D[2].y;
-
-    if (! Math::IsInsideTriangle(a, b, c, mouse))
-        return false;
-
-    auto matViewInverse = glm::inverse(m_matView);
-    auto matProjInverse = glm::inverse(m_matProj);
-
-    glm::vec3 a2 = Math::Transform(m_objects[objRank].transform, triangle[0].position);
-    glm::vec3 b2 = Math::Transform(m_objects[objRank].transform, triangle[1].position);
-    glm::vec3 c2 = Math::Transform(m_objects[objRank].transform, triangle[2].position);
-    glm::vec3 e  = Math::Transform(matViewInverse, glm::vec3(0.0f, 0.0f, -1.0f));
-    glm::vec3 f  = Math::Transform(matViewInverse, glm::vec3(
-        (mouse.x*2.0f-1.0f) * matProjInverse[0][0],
-        (mouse.y*2.0f-1.0f) * matProjInverse[1][1],
-        0.0f));
-    Math::Intersect(a2, b2, c2, e, f, pos);
-
-    dist = (p2D[0].z + p2D[1].z + p2D[2].z) / 3.0f;
-    return true;
+    p1.bvh = std::make_shared<const CTriangleBVH>(vertices);
+    return *p1.bvh;
 }
 
 //! Use only after world transform already set
@@ -2719,6 +2655,11 @@ void CEngine::Render()
 
     m_statisticTriangle = 0;
 
+    // UI primitives are flushed at the end of the scene, so statistics are from the previous frame
+    auto uiRenderer = m_device->GetUIRenderer();
+    m_statisticUI = uiRenderer->GetStatistics();
+    uiRenderer->ResetStatistics();
+
     m_lightMan->UpdateLights();
 
     Color color;
@@ -2991,7 +2932,7 @@ void CEngine::Draw3DScene()
 
             objectRenderer->SetAlbedoColor(color);
             objectRenderer->SetAlbedoTexture(data.albedoTexture);
-            objectRenderer->SetDetailTexture(data.detailTexture);
+            SetObjectMaterialParams(objectRenderer, m_objects[objRank], data);
 
             objectRenderer->SetEmissiveColor(data.material.emissiveColor);
             objectRenderer->SetEmissiveTexture(data.emissiveTexture);
@@ -3000,7 +2941,6 @@ void CEngine::Draw3DScene()
             objectRenderer->SetMaterialTexture(data.materialTexture);
 
             objectRenderer->SetCullFace(data.material.cullFace);
-            objectRenderer->SetUVTransform(data.uvOffset, data.uvScale);
             objectRenderer->DrawObject(data.buffer);
         }
     }
@@ -3068,8 +3008,7 @@ void CEngine::Draw3DScene()
 
                 objectRenderer->SetAlbedoColor(tColor);
                 objectRenderer->SetAlbedoTexture(data.albedoTexture);
-                objectRenderer->SetDetailTexture(data.detailTexture);
-                objectRenderer->SetUVTransform(data.uvOffset, data.uvScale);
+                SetObjectMaterialParams(objectRenderer, m_objects[objRank], data);
                 objectRenderer->DrawObject(data.buffer);
             }
         }
@@ -3625,6 +3564,7 @@ void CEngine::DrawInterface()
 {
     m_device->SetDepthTest(false);
     m_device->SetTransparency(TransparencyMode::NONE);
+    m_device->GetUIRenderer()->SetTransparency(TransparencyMode::NONE);
 
     SetInterfaceCoordinates();
 
@@ -3738,7 +3678,7 @@ void CEngine::DrawInterface()
 
                 renderer->SetAlbedoColor(color);
                 renderer->SetAlbedoTexture(data.albedoTexture);
-                renderer->SetDetailTexture(data.detailTexture);
+                SetObjectMaterialParams(renderer, m_objects[objRank], data);
 
                 renderer->DrawObject(data.buffer);
             }
@@ -4632,7 +4572,7 @@ void CEngine::DrawStats()
 
     float height = m_text->GetAscent(FONT_COMMON, 13.0f);
     float width = 0.4f;
-    const int TOTAL_LINES = 22;
+    const int TOTAL_LINES = 26;
 
     glm::vec2 pos(0.05f * m_size.x/m_size.y, 0.05f + TOTAL_LINES * height);
 
@@ -4679,6 +4619,8 @@ void CEngine::DrawStats()
         drawStatsValue(name, CProfiler::GetPerformanceCounterTime(counter));
     };
 
+    const ScriptSchedulerStats& scheduler = CRobotMain::GetInstance().GetScriptScheduler()->GetStats();
+
     // TODO: Find a more generic way to calculate these in CProfiler
 
     long long engineUpdate = CProfiler::GetPerformanceCounterTime(PCNT_UPDATE_ENGINE) -
@@ -4706,6 +4648,10 @@ void CEngine::DrawStats()
     drawStatsCounter("    Particle update",   PCNT_UPDATE_PARTICLE);
     drawStatsValue  ("    Game update",       gameUpdate);
     drawStatsCounter("    CBot programs",     PCNT_UPDATE_CBOT);
+    drawStatsLine(   "        instructions",  StrUtils::ToString<int>(scheduler.executed),
+                                          scheduler.budget > 0 ? "of " + StrUtils::ToString<int>(scheduler.budget) : "");
+    drawStatsLine(   "        run / waiting", StrUtils::Format("%d / %d", scheduler.scheduled, scheduler.starved),
+                                          StrUtils::ToString<long long>(scheduler.totalStarved) + " waits");
     drawStatsValue(  "    Other update",      otherUpdate);
     drawStatsLine(   "", "", "");
     drawStatsCounter("Frame render",      PCNT_RENDER_ALL);
@@ -4720,7 +4666,13 @@ void CEngine::DrawStats()
     drawStatsCounter("Swap buffers & VSync",  PCNT_SWAP_BUFFERS);
     drawStatsLine(   "", "", "");
     drawStatsLine(   "Triangles",         StrUtils::ToString<int>(m_statisticTriangle), "");
+    drawStatsLine(   "UI draw calls",     StrUtils::ToString<int>(m_statisticUI.drawCalls),
+                                          StrUtils::ToString<int>(m_statisticUI.primitives) + " prims");
     drawStatsLine(   "FPS",               StrUtils::Format("%.3f", m_fps), "");
+    drawStatsLine(   "Frame p50/p95/p99", StrUtils::Format("%.1f / %.1f / %.1f",
+                                                           CProfiler::GetFrameTimePercentile(50.0f) / 1e6f,
+                                                           CProfiler::GetFrameTimePercentile(95.0f) / 1e6f,
+                                                           CProfiler::GetFrameTimePercentile(99.0f) / 1e6f), "ms");
     drawStatsLine(   "", "", "");
     std::stringstream str;
     str << std::fixed << std::setprecision(2) << m_statisticPos.x << "; " << m_statisticPos.z;
@@ -4776,6 +4728,7 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<Gfx::ModelT
         }
 
         p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
+        p1.bvh.reset();
 
         p1.totalTriangles += vertices.size() / 3;
     }
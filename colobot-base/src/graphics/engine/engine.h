@@ -41,6 +41,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <span>
 #include <memory>
 #include <unordered_map>
 
@@ -68,6 +69,7 @@ class CCloud;
 class CLightning;
 class CPlanet;
 class CTerrain;
+class CTriangleBVH;
 class CPyroManager;
 class CModelMesh;
 class CVertexBuffer;
@@ -113,9 +115,26 @@ enum EngineObjectType : unsigned char
     ENG_OBJTYPE_METAL       = 6
 };
 
+/**
+ * \struct EngineObjectUVTransform
+ * \brief Texture coordinate transform for parts of an engine object with given material tag
+ */
+struct EngineObjectUVTransform
+{
+    //! Material tag of affected parts
+    std::string            tag;
+    //! UV offset
+    glm::vec2              offset = { 0.0f, 0.0f };
+    //! UV scale
+    glm::vec2              scale = { 1.0f, 1.0f };
+};
+
 /**
  * \struct EngineObject
  * \brief Object drawn by the graphics engine
+ *
+ * Geometry is shared with all other objects referencing the same base object,
+ * so anything that differs between instances of one model is stored here.
  */
 struct EngineObject
 {
@@ -141,6 +160,10 @@ struct EngineObject
     bool                   ghost = false;
     //! Team
     int                    team = 0;
+    //! UV transforms of tagged parts
+    std::vector<EngineObjectUVTransform> uvTransforms;
+    //! Detail texture replacing the one of base object, if valid
+    Texture                detailTexture;
 };
 
 /**
@@ -558,6 +581,7 @@ public:
     void            DeleteAllBaseObjects();
 
     //! Copies geometry between two base objects
+    /** Only needed if the geometry is going to be changed, otherwise objects should share the base object. */
     void            CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank);
 
     //! Adds triangles to given object with the specified params
@@ -594,6 +618,8 @@ public:
     //! Management of object transform
     void            SetObjectTransform(int objRank, const glm::mat4& transform);
     void            GetObjectTransform(int objRank, glm::mat4& transform);
+    //! Sets transforms of many objects at once, \a transforms[i] is given to object \a objRanks[i]
+    void            SetObjectTransforms(std::span<const int> objRanks, std::span<const glm::mat4> transforms);
     //@}
 
     //! Sets drawWorld for given object
@@ -617,8 +643,11 @@ public:
                                         std::vector<EngineTriangle>& triangles);
 
     //! Changes the 2nd texure for given object
+    /** Only affects given object, base object is left unchanged. */
     void            ChangeSecondTexture(int objRank, const std::filesystem::path& tex2Name);
 
+    //! Sets UV transform for parts of given object with given material tag
+    /** Only affects given object, base object is left unchanged. */
     void            SetUVTransform(int objRank, const std::string& tag, const glm::vec2& offset, const glm::vec2& scale);
 
     //! Detects the target object that is selected with the mouse
@@ -1033,6 +1062,8 @@ protected:
 
     //! Creates a new tier
     EngineBaseObjDataTier& AddLevel(EngineBaseObject& p3, EngineTriangleType type, const Material& material);
+    //! Sets renderer params which an object can override on its base object
+    void        SetObjectMaterialParams(CObjectRenderer* objectRenderer, const EngineObject& object, const EngineBaseObjDataTier& data);
 
     //! Create texture and add it to cache
     Texture CreateTexture(const std::filesystem::path &texName, const TextureCreateParams &params, CImage* image = nullptr);
@@ -1042,14 +1073,11 @@ protected:
 
     bool        InPlane(glm::vec3 normal, float originPlane, glm::vec3 center, float radius);
 
-    //! Detects whether an object is affected by the mouse
-    bool        DetectBBox(int objRank, const glm::vec2& mouse);
-
     //! Compute and return the 2D box on screen of any object
     bool        GetBBox2D(int objRank, glm::vec2& min, glm::vec2& max);
 
-    //! Detects whether the mouse is in a triangle.
-    bool        DetectTriangle(const glm::vec2& mouse, Vertex3D* triangle, int objRank, float& dist, glm::vec3& pos);
+    //! Returns the picking hierarchy of given base object, building it if needed
+    const CTriangleBVH& GetBVH(EngineBaseObject& p1);
 
     //! Transforms a 3D point (x, y, z) in 2D space (x, y, -) of the window
     /** The coordinated p2D.z gives the distance. */
@@ -1072,7 +1100,8 @@ protected:
         std::unique_ptr<CImage> img;
         std::filesystem::path fileName;
     };
-    static void WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data);
+    //! Saves the screenshot; runs on the thread pool
+    static void WriteScreenShotTask(const std::shared_ptr<WriteScreenShotData>& data);
 
 protected:
     CApplication*     m_app;
@@ -1166,6 +1195,7 @@ protected:
     float           m_fogStart[2];
     Color           m_waterAddColor;
     int             m_statisticTriangle;
+    UIRendererStatistics m_statisticUI;
     glm::vec3       m_statisticPos{ 0, 0, 0 };
     bool            m_updateGeometry;
     bool            m_updateStaticBuffers;
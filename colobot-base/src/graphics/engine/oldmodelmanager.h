@@ -47,8 +47,11 @@ class CEngine;
  * is then shared among all instances of this model with the instances
  * being engine objects linked to the shared base object.
  *
+ * Per-instance differences like team colors, UV transforms or detail
+ * textures are stored in the engine object, so they don't require a copy.
+ *
  * There is also a possibility of creating a copy of model so it has
- * its own and unique base engine object. This is especially useful
+ * its own and unique base engine object. This should only be used
  * for models where the geometry must be altered.
  */
 class COldModelManager
@@ -1590,16 +1590,7 @@ void CPyro::ExploStart()
         int objRank = m_object->GetObjectRank(i);
         if (objRank == -1) continue;
 
-        // TODO: refactor later to material change
-        int oldBaseObjRank = m_engine->GetObjectBaseRank(objRank);
-        if (oldBaseObjRank != -1)
-        {
-            int newBaseObjRank = m_engine->CreateBaseObject();
-            m_engine->CopyBaseObject(oldBaseObjRank, newBaseObjRank);
-            m_engine->SetObjectBaseRank(objRank, newBaseObjRank);
-
-            m_engine->ChangeSecondTexture(objRank, "dirty04.png");
-        }
+        m_engine->ChangeSecondTexture(objRank, "dirty04.png");
 
         // TODO: temporary hack (hopefully)
         assert(m_object->Implements(ObjectInterfaceType::Old));
@@ -1663,16 +1654,7 @@ void CPyro::BurnStart()
         int objRank = m_object->GetObjectRank(i);
         if (objRank == -1) continue;
 
-        // TODO: refactor later to material change
-        int oldBaseObjRank = m_engine->GetObjectBaseRank(objRank);
-        if (oldBaseObjRank != -1)
-        {
-            int newBaseObjRank = m_engine->CreateBaseObject();
-            m_engine->CopyBaseObject(oldBaseObjRank, newBaseObjRank);
-            m_engine->SetObjectBaseRank(objRank, newBaseObjRank);
-
-            m_engine->ChangeSecondTexture(objRank, "dirty04.png");
-        }
+        m_engine->ChangeSecondTexture(objRank, "dirty04.png");
     }
     m_engine->LoadTexture("textures/dirty04.png");
 
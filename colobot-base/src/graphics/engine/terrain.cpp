@@ -32,6 +32,7 @@
 
 #include "math/geometry.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <SDL.h>
@@ -1334,6 +1335,18 @@ bool CTerrain::Terraform(const glm::vec3 &p1, const glm::vec3 &p2, float height)
     }
     AdjustRelief();
 
+    // neighbouring points may also be adjusted above
+    glm::vec3 changeMin = { (tp1.x-2)*m_brickSize-dim, 0.0f, (tp1.y-2)*m_brickSize-dim };
+    glm::vec3 changeMax = { (tp2.x+2)*m_brickSize-dim, 0.0f, (tp2.y+2)*m_brickSize-dim };
+    if (m_reliefChanged)
+    {
+        changeMin = glm::min(changeMin, m_reliefChangeMin);
+        changeMax = glm::max(changeMax, m_reliefChangeMax);
+    }
+    m_reliefChangeMin = changeMin;
+    m_reliefChangeMax = changeMax;
+    m_reliefChanged = true;
+
     glm::ivec2 pp1, pp2;
     pp1.x = (tp1.x-2)/m_brickCount;
     pp1.y = (tp1.y-2)/m_brickCount;
@@ -1361,6 +1374,21 @@ bool CTerrain::Terraform(const glm::vec3 &p1, const glm::vec3 &p2, float height)
     return true;
 }
 
+bool CTerrain::GetReliefChange(glm::vec3& min, glm::vec3& max)
+{
+    if (!m_reliefChanged)
+        return false;
+
+    min = m_reliefChangeMin;
+    max = m_reliefChangeMax;
+    return true;
+}
+
+void CTerrain::ResetReliefChange()
+{
+    m_reliefChanged = false;
+}
+
 void CTerrain::SetWind(glm::vec3 speed)
 {
     m_wind = speed;
@@ -1463,6 +1491,92 @@ float CTerrain::GetFloorLevel(const glm::vec3 &pos, bool brut, bool water)
     return ps.y;
 }
 
+bool CTerrain::IntersectRay(const glm::vec3& origin, const glm::vec3& dir, float tMin, float& tMax, int& objRank)
+{
+    if (m_relief.empty())
+        return false;
+
+    int size = m_mosaicCount*m_brickCount;
+    float dim = (size*m_brickSize)/2.0f;
+
+    // Clip the ray to the area covered by the relief
+    float start = tMin, end = tMax;
+    if (! Math::IntersectRayBox(origin, 1.0f / dir,
+                                glm::vec3(-dim, -Math::HUGE_NUM, -dim),
+                                glm::vec3( dim,  Math::HUGE_NUM,  dim), start, end))
+        return false;
+
+    // Walk the cells crossed by the ray in the XZ plane (DDA), nearest first,
+    // so the first cell with a hit gives the nearest intersection
+    glm::vec3 p = origin + dir * start;
+    int x = std::clamp(static_cast<int>((p.x+dim)/m_brickSize), 0, size-1);
+    int y = std::clamp(static_cast<int>((p.z+dim)/m_brickSize), 0, size-1);
+
+    int stepX = dir.x < 0.0f ? -1 : 1;
+    int stepY = dir.z < 0.0f ? -1 : 1;
+
+    // Ray parameters at the next cell borders and between two borders
+    float nextX  = Math::HUGE_NUM;
+    float nextY  = Math::HUGE_NUM;
+    float deltaX = Math::HUGE_NUM;
+    float deltaY = Math::HUGE_NUM;
+    if (dir.x != 0.0f)
+    {
+        nextX  = ((x + (stepX > 0 ? 1 : 0))*m_brickSize - dim - origin.x) / dir.x;
+        deltaX = m_brickSize / fabs(dir.x);
+    }
+    if (dir.z != 0.0f)
+    {
+        nextY  = ((y + (stepY > 0 ? 1 : 0))*m_brickSize - dim - origin.z) / dir.z;
+        deltaY = m_brickSize / fabs(dir.z);
+    }
+
+    while (x >= 0 && x < size && y >= 0 && y < size)
+    {
+        glm::vec3 p1 = GetVector(x+0, y+0);
+        glm::vec3 p2 = GetVector(x+1, y+0);
+        glm::vec3 p3 = GetVector(x+0, y+1);
+        glm::vec3 p4 = GetVector(x+1, y+1);
+
+        // Same split of the square as the strips made in CreateMosaic()
+        float t = 0.0f;
+        bool hit = false;
+        if (Math::IntersectRayTriangle(origin, dir, p1, p3, p2, tMin, end, t))
+        {
+            end = t;
+            hit = true;
+        }
+        if (Math::IntersectRayTriangle(origin, dir, p3, p2, p4, tMin, end, t))
+        {
+            end = t;
+            hit = true;
+        }
+
+        if (hit)
+        {
+            tMax = end;
+            objRank = m_objRanks[(x/m_brickCount) + (y/m_brickCount)*m_mosaicCount];
+            return true;
+        }
+
+        if (std::min(nextX, nextY) > end)
+            break;
+
+        if (nextX < nextY)
+        {
+            x += stepX;
+            nextX += deltaX;
+        }
+        else
+        {
+            y += stepY;
+            nextY += deltaY;
+        }
+    }
+
+    return false;
+}
+
 float CTerrain::GetHeightToFloor(const glm::vec3 &pos, bool brut, bool water)
 {
     float dim = (m_mosaicCount*m_brickCount*m_brickSize)/2.0f;
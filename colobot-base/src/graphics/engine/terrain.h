@@ -182,6 +182,12 @@ public:
     //! Modifies the terrain's relief
     bool        Terraform(const glm::vec3& p1, const glm::vec3& p2, float height);
 
+    //@{
+    //! Area of relief modified by Terraform() since the last reset, returns false if there is none
+    bool        GetReliefChange(glm::vec3& min, glm::vec3& max);
+    void        ResetReliefChange();
+    //@}
+
     //@{
     //! Management of the wind
     void        SetWind(glm::vec3 speed);
@@ -206,6 +212,12 @@ public:
     bool        AdjustToBounds(glm::vec3& pos, float margin);
     //! Returns the resource type available underground at 2D (XZ) position
     TerrainRes GetResource(const glm::vec3& pos);
+    //! Intersects the ray \a origin + t * \a dir with the relief, for t in [tMin, tMax]
+    /**
+     * On hit, sets \a tMax to the nearest intersection and \a objRank to the engine object
+     * of the mosaic containing it.
+     */
+    bool        IntersectRay(const glm::vec3& origin, const glm::vec3& dir, float tMin, float& tMax, int& objRank);
 
     //! Empty the table of elevations
     void        FlushBuildingLevel();
@@ -291,6 +303,11 @@ protected:
 
     //! Relief data points
     std::vector<float> m_relief;
+    //! Whether relief was modified by Terraform() since the last ResetReliefChange()
+    bool m_reliefChanged = false;
+    //! Bounds of modified relief
+    glm::vec3 m_reliefChangeMin{ 0, 0, 0 };
+    glm::vec3 m_reliefChangeMax{ 0, 0, 0 };
     //! Resources data
     std::vector<unsigned char> m_resources;
     //! Texture indices
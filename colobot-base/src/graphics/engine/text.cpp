@@ -44,6 +44,8 @@
 #include <algorithm>
 #include <array>
 #include <filesystem>
+#include <list>
+#include <unordered_map>
 #include <utility>
 
 using namespace std::literals;
@@ -65,17 +67,6 @@ struct MultisizeFont
         : fileName(fn) {}
 };
 
-/**
- * \struct FontTexture
- * \brief Single texture filled with character textures
- */
-struct FontTexture
-{
-    unsigned int id = 0;
-    glm::ivec2 tileSize;
-    int freeSlots = 0;
-};
-
 struct CodePointComparator
 {
     constexpr bool operator()(const StrUtils::CodePoint& left, const StrUtils::CodePoint& right) const
@@ -98,10 +89,12 @@ struct CachedFont
 {
     std::unique_ptr<CSDLMemoryWrapper> fontFile;
     TTF_Font* font = nullptr;
+    int pointSize = 0;
     std::map<StrUtils::CodePoint, CharTexture, CodePointComparator> cache;
 
     CachedFont(std::unique_ptr<CSDLMemoryWrapper> fontFile, int pointSize)
-        : fontFile(std::move(fontFile))
+        : fontFile(std::move(fontFile)),
+          pointSize(pointSize)
     {
         font = TTF_OpenFontRW(this->fontFile->GetHandler(), 0, pointSize);
     }
@@ -109,6 +102,7 @@ struct CachedFont
     CachedFont(CachedFont&& other) noexcept
         : fontFile{std::move(other.fontFile)},
           font{std::exchange(other.font, nullptr)},
+          pointSize{other.pointSize},
           cache{std::move(other.cache)}
     {
     }
@@ -117,6 +111,7 @@ struct CachedFont
     {
         fontFile = std::move(other.fontFile);
         std::swap(font, other.font);
+        pointSize = other.pointSize;
         cache = std::move(other.cache);
         return *this;
     }
@@ -152,7 +147,13 @@ std::string ToString(FontType type)
 namespace
 {
 constexpr glm::ivec2 REFERENCE_SIZE(800, 600);
-constexpr glm::ivec2 FONT_TEXTURE_SIZE(256, 256);
+constexpr glm::ivec2 FONT_TEXTURE_SIZE(512, 512);
+//! Number of atlas pages per font size before the least recently used one gets reused
+constexpr std::size_t MAX_ATLAS_PAGES = 4;
+//! Empty pixels between glyphs in atlas
+constexpr int GLYPH_PADDING = 1;
+//! Number of string layouts kept in cache
+constexpr std::size_t MAX_CACHED_LAYOUTS = 512;
 
 Gfx::FontType ToBoldFontType(Gfx::FontType type)
 {
@@ -163,11 +164,69 @@ Gfx::FontType ToItalicFontType(Gfx::FontType type)
 {
     return static_cast<Gfx::FontType>(type | FONT_ITALIC);
 }
+
+template<typename T>
+void AppendToKey(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//! Builds key of cached layout from everything that affects it, except position
+std::string MakeLayoutKey(const std::string& text, const FontMetaChar* format, std::size_t formatLength,
+                          int font, int pointSize, int width, char32_t eol, Color color)
+{
+    std::string key;
+    key.reserve(32 + text.size() + formatLength * sizeof(FontMetaChar));
+    AppendToKey(key, font);
+    AppendToKey(key, pointSize);
+    AppendToKey(key, width);
+    AppendToKey(key, eol);
+    AppendToKey(key, color.r);
+    AppendToKey(key, color.g);
+    AppendToKey(key, color.b);
+    AppendToKey(key, color.a);
+    AppendToKey(key, text.size());
+    key.append(text);
+    if (formatLength > 0)
+        key.append(reinterpret_cast<const char*>(format), formatLength * sizeof(FontMetaChar));
+    return key;
+}
 } // anonymous namespace
 
+/// Laid out string in window coordinates relative to its starting position.
+/// Kept in CLayoutCache, so that drawing an unchanged string doesn't have to look up
+/// every character again.
+struct CText::TextLayout
+{
+    struct Highlight
+    {
+        FontMetaChar format;
+        glm::ivec2 pos;
+        glm::ivec2 size;
+    };
+
+    struct Quad
+    {
+        Vertex2D vertices[4];
+        //! Atlas page texture; 0 for button icons
+        unsigned int texID = 0;
+        //! Index of button texture for icons from FONT_BUTTON
+        unsigned int buttonTexture = 0;
+    };
+
+    std::vector<Highlight> highlights;
+    std::vector<Quad> quads;
+    //! Atlas pages (point size, texture) used by the quads
+    std::vector<std::pair<int, unsigned int>> pages;
+    //! Atlas generation the layout was made in
+    unsigned int generation = 0;
+};
+
 /// The QuadBatch is responsible for collecting as many quad (aka rectangle) draws as possible and
 /// sending them to the CDevice in one big batch. This avoids making one CDevice::DrawPrimitive call
-/// for every CText::DrawCharAndAdjustPos call, which makes text rendering much faster.
+/// for every character, which makes text rendering much faster.
+/// Quads are grouped by texture, so a whole string is drawn with one call per atlas page.
+/// Color is stored in vertices, so it doesn't break batches.
 /// Currently we only collect textured quads (ie. ones using Vertex), not untextured quads (which
 /// use VertexCol). Untextured quads are only drawn via DrawHighlight, which happens much less often
 /// than drawing textured quads.
@@ -177,63 +236,362 @@ public:
     explicit CQuadBatch(CEngine& engine)
         : m_engine(engine)
     {
-        m_quads.reserve(1024);
     }
 
-    /// Add a quad to be rendered.
-    /// This may trigger a call to Flush() if necessary.
-    void Add(Vertex2D vertices[4], unsigned int texID, TransparencyMode transparency, Color color)
+    /// Add a quad to be rendered on next Flush().
+    void Add(const Vertex2D vertices[4], unsigned int texID, TransparencyMode transparency)
     {
-        if (texID != m_texID || transparency != m_transparency || color != m_color)
+        Batch* batch = nullptr;
+        for (auto& b : m_batches)
         {
-            Flush();
-            m_texID = texID;
-            m_transparency = transparency;
-            m_color = color;
+            if (b.texID == texID && b.transparency == transparency)
+            {
+                batch = &b;
+                break;
+            }
+        }
+
+        if (batch == nullptr)
+        {
+            batch = &m_batches.emplace_back();
+            batch->texID = texID;
+            batch->transparency = transparency;
+            batch->quads.reserve(256);
         }
-        m_quads.emplace_back(Quad{{vertices[0], vertices[1], vertices[2], vertices[3]}});
+
+        batch->quads.emplace_back(Quad{{vertices[0], vertices[1], vertices[2], vertices[3]}});
     }
 
     /// Draw all pending quads immediately.
     void Flush()
     {
-        if (m_quads.empty()) return;
-
         auto renderer = m_engine.GetUIRenderer();
-        renderer->SetTexture(Texture{ m_texID });
-        renderer->SetTransparency(m_transparency);
-        renderer->SetColor(m_color);
 
-        if (m_counts.size() < m_quads.size())
+        for (auto& batch : m_batches)
         {
-            m_counts.resize(m_quads.size(), 4);
-        }
+            if (batch.quads.empty()) continue;
 
-        auto vertices = renderer->BeginPrimitives(PrimitiveType::TRIANGLE_STRIP, m_quads.size(), m_counts.data());
+            renderer->SetTexture(Texture{ batch.texID });
+            renderer->SetTransparency(batch.transparency);
+            renderer->SetColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
 
-        size_t offset = 0;
+            if (m_counts.size() < batch.quads.size())
+            {
+                m_counts.resize(batch.quads.size(), 4);
+            }
 
-        for (const auto& quad : m_quads)
-        {
-            std::copy_n(quad.vertices, 4, vertices + offset);
-            offset += 4;
-        }
+            auto vertices = renderer->BeginPrimitives(PrimitiveType::TRIANGLE_STRIP, batch.quads.size(), m_counts.data());
 
-        renderer->EndPrimitive();
+            size_t offset = 0;
+
+            for (const auto& quad : batch.quads)
+            {
+                std::copy_n(quad.vertices, 4, vertices + offset);
+                offset += 4;
+            }
 
-        m_engine.AddStatisticTriangle(static_cast<int>(m_quads.size() * 2));
-        m_quads.clear();
+            renderer->EndPrimitive();
+
+            m_engine.AddStatisticTriangle(static_cast<int>(batch.quads.size() * 2));
+            batch.quads.clear();
+        }
+
+        // don't keep batches of textures that are no longer used
+        if (m_batches.size() > MAX_ATLAS_PAGES * 2)
+            m_batches.clear();
     }
 private:
     CEngine& m_engine;
 
     struct Quad { Vertex2D vertices[4]; };
-    std::vector<Quad> m_quads;
+    struct Batch
+    {
+        unsigned int texID = 0;
+        TransparencyMode transparency = TransparencyMode::NONE;
+        std::vector<Quad> quads;
+    };
+    std::vector<Batch> m_batches;
     std::vector<int> m_counts;
+};
+
+/// Glyph atlas, kept separately for every font point size.
+/// Glyphs are packed into shelves (rows as high as the glyphs placed in them) on textures
+/// of FONT_TEXTURE_SIZE. When all MAX_ATLAS_PAGES pages of a size are full, the least recently
+/// used page is emptied and reused, and glyphs stored on it are removed from font caches.
+class CText::CGlyphAtlas
+{
+public:
+    /// Marks start of new string draw; pages used since then are never evicted
+    void BeginUse()
+    {
+        ++m_useCounter;
+    }
+
+    /// Marks page as used by current draw
+    void Touch(int pointSize, unsigned int texID)
+    {
+        auto it = m_atlases.find(pointSize);
+        if (it == m_atlases.end()) return;
+
+        for (auto& page : it->second)
+        {
+            if (page.id == texID)
+            {
+                page.lastUse = m_useCounter;
+                return;
+            }
+        }
+    }
+
+    /// Stores rendered glyph in atlas of its font point size
+    CharTexture Add(CDevice* device, CachedFont* font, const StrUtils::CodePoint& ch, SDL_Surface* surface)
+    {
+        CharTexture texture;
+
+        glm::ivec2 size(surface->w + GLYPH_PADDING, surface->h + GLYPH_PADDING);
+        if (size.x > FONT_TEXTURE_SIZE.x || size.y > FONT_TEXTURE_SIZE.y)
+            return texture;
+
+        auto& pages = m_atlases[font->pointSize];
+
+        Page* page = nullptr;
+        glm::ivec2 pos;
+        for (auto& p : pages)
+        {
+            if (Allocate(p, size, pos))
+            {
+                page = &p;
+                break;
+            }
+        }
+
+        if (page == nullptr)
+        {
+            page = GetLeastRecentlyUsedPage(pages);
+            if (page != nullptr)
+            {
+                Evict(*page);
+            }
+            else
+            {
+                Page newPage;
+                newPage.id = CreatePageTexture(device);
+                if (newPage.id == 0)
+                    return texture;
+
+                page = &pages.emplace_back(std::move(newPage));
+            }
+
+            if (!Allocate(*page, size, pos))
+                return texture;
+        }
+
+        texture.id = page->id;
+        texture.charPos = pos;
+        texture.charSize = { surface->w, surface->h };
+
+        ImageData imageData;
+        imageData.surface = surface;
+
+        Texture tex;
+        tex.id = texture.id;
+        device->UpdateTexture(tex, texture.charPos, &imageData, TextureFormat::RGBA);
+
+        imageData.surface = nullptr;
+
+        page->glyphs.emplace_back(font, ch);
+        page->lastUse = m_useCounter;
+
+        return texture;
+    }
+
+    /// Returns counter changed every time glyphs are moved or removed from atlas
+    unsigned int GetGeneration() const
+    {
+        return m_generation;
+    }
+
+    /// Destroys all atlas textures
+    void Clear(CDevice* device)
+    {
+        for (auto& [pointSize, pages] : m_atlases)
+        {
+            for (auto& page : pages)
+            {
+                Texture tex;
+                tex.id = page.id;
+                device->DestroyTexture(tex);
+            }
+        }
+        m_atlases.clear();
+        ++m_generation;
+    }
+
+private:
+    struct Shelf
+    {
+        int y = 0;
+        int height = 0;
+        //! Start of free space
+        int x = 0;
+    };
+
+    struct Page
+    {
+        unsigned int id = 0;
+        std::vector<Shelf> shelves;
+        //! Start of space not used by shelves
+        int top = 0;
+        unsigned long long lastUse = 0;
+        //! Glyphs stored on the page, to remove them from font caches on eviction
+        std::vector<std::pair<CachedFont*, StrUtils::CodePoint>> glyphs;
+    };
+
+    bool Allocate(Page& page, const glm::ivec2& size, glm::ivec2& pos)
+    {
+        // lowest shelf the glyph fits in; much higher shelves are only used if there's no space for a new one
+        Shelf* best = nullptr;
+        bool canAddShelf = page.top + size.y <= FONT_TEXTURE_SIZE.y;
+        for (auto& shelf : page.shelves)
+        {
+            if (shelf.height < size.y || shelf.x + size.x > FONT_TEXTURE_SIZE.x)
+                continue;
+
+            if (canAddShelf && shelf.height > size.y + size.y / 2)
+                continue;
+
+            if (best == nullptr || shelf.height < best->height)
+                best = &shelf;
+        }
+
+        if (best == nullptr)
+        {
+            if (!canAddShelf)
+                return false;
+
+            best = &page.shelves.emplace_back();
+            best->y = page.top;
+            best->height = size.y;
+            page.top += size.y;
+        }
+
+        pos = { best->x, best->y };
+        best->x += size.x;
+        return true;
+    }
+
+    Page* GetLeastRecentlyUsedPage(std::vector<Page>& pages)
+    {
+        if (pages.size() < MAX_ATLAS_PAGES)
+            return nullptr;
+
+        Page* result = nullptr;
+        for (auto& page : pages)
+        {
+            // quads of current draw may still reference it
+            if (page.lastUse == m_useCounter)
+                continue;
+
+            if (result == nullptr || page.lastUse < result->lastUse)
+                result = &page;
+        }
+        return result;
+    }
+
+    void Evict(Page& page)
+    {
+        GetLogger()->Trace("Evicting font atlas page %% with %% glyphs", page.id, page.glyphs.size());
+
+        for (auto& [font, ch] : page.glyphs)
+            font->cache.erase(ch);
+
+        page.glyphs.clear();
+        page.shelves.clear();
+        page.top = 0;
+        ++m_generation;
+    }
 
-    Color m_color;
-    unsigned int m_texID{};
-    TransparencyMode m_transparency = TransparencyMode::NONE;
+    unsigned int CreatePageTexture(CDevice* device)
+    {
+        SDL_Surface* textureSurface = SDL_CreateRGBSurface(0, FONT_TEXTURE_SIZE.x, FONT_TEXTURE_SIZE.y, 32,
+                                                           0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+        ImageData data;
+        data.surface = textureSurface;
+
+        TextureCreateParams createParams;
+        createParams.format = TextureFormat::RGBA;
+        createParams.filter = TextureFilter::NEAREST;
+        createParams.mipmap = false;
+
+        Texture tex = device->CreateTexture(&data, createParams);
+
+        data.surface = nullptr;
+        SDL_FreeSurface(textureSurface);
+
+        return tex.id;
+    }
+
+private:
+    std::map<int, std::vector<Page>> m_atlases;
+    unsigned long long m_useCounter = 0;
+    unsigned int m_generation = 0;
+};
+
+/// Cache of string layouts, keyed by text, formatting and drawing parameters.
+/// Least recently used layouts are dropped when it grows over MAX_CACHED_LAYOUTS.
+class CText::CLayoutCache
+{
+public:
+    /// Returns cached layout or nullptr; layouts from older atlas generation are not returned
+    TextLayout* Find(const std::string& key, unsigned int generation)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+            return nullptr;
+
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        if (it->second->second.generation != generation)
+            return nullptr;
+
+        return &it->second->second;
+    }
+
+    /// Returns layout to be filled for given key, reusing existing entry if there is one
+    TextLayout& Insert(const std::string& key, unsigned int generation)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            TextLayout& layout = it->second->second;
+            layout = TextLayout();
+            layout.generation = generation;
+            return layout;
+        }
+
+        if (m_entries.size() >= MAX_CACHED_LAYOUTS)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, TextLayout());
+        m_index.emplace(m_entries.front().first, m_entries.begin());
+        m_entries.front().second.generation = generation;
+        return m_entries.front().second;
+    }
+
+    void Clear()
+    {
+        m_index.clear();
+        m_entries.clear();
+    }
+
+private:
+    //! Most recently used first
+    std::list<std::pair<std::string, TextLayout>> m_entries;
+    //! Keys point to strings stored in m_entries
+    std::unordered_map<std::string_view, std::list<std::pair<std::string, TextLayout>>::iterator> m_index;
 };
 
 class FontsCache
@@ -407,6 +765,8 @@ CText::CText(CEngine* engine)
 
     m_fontsCache = std::make_unique<FontsCache>();
 
+    m_glyphAtlas = std::make_unique<CGlyphAtlas>();
+    m_layoutCache = std::make_unique<CLayoutCache>();
     m_quadBatch = std::make_unique<CQuadBatch>(*engine);
 }
 
@@ -448,6 +808,11 @@ bool CText::ReloadFonts()
         return false;
     }
 
+    // glyphs in atlas reference the old fonts
+    if (m_device != nullptr)
+        m_glyphAtlas->Clear(m_device);
+    m_layoutCache->Clear();
+
     m_fontsCache = std::move(newCache);
     return true;
 }
@@ -470,13 +835,8 @@ std::string CText::GetError()
 
 void CText::FlushCache()
 {
-    for (auto& fontTexture : m_fontTextures)
-    {
-        Texture tex;
-        tex.id = fontTexture.id;
-        m_device->DestroyTexture(tex);
-    }
-    m_fontTextures.clear();
+    m_glyphAtlas->Clear(m_device);
+    m_layoutCache->Clear();
 
     m_fontsCache->Flush();
 }
@@ -935,9 +1295,28 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
                        std::vector<FontMetaChar>::iterator end,
                        float size, const glm::ivec2& position, int width, char32_t eol, Color color)
 {
-    m_engine->SetWindowCoordinates();
+    m_glyphAtlas->BeginUse();
+
+    // format is only read for bytes of the text
+    std::size_t formatLength = std::min<std::size_t>(std::distance(format, end), text.size());
+    std::string key = MakeLayoutKey(text, formatLength > 0 ? &*format : nullptr, formatLength,
+                                    -1, GetFontPointSize(size), width, eol, color);
+
+    TextLayout* layout = m_layoutCache->Find(key, m_glyphAtlas->GetGeneration());
+    if (layout == nullptr)
+    {
+        layout = &m_layoutCache->Insert(key, m_glyphAtlas->GetGeneration());
+        LayoutString(text, format, end, size, width, eol, color, *layout);
+    }
+
+    DrawLayout(*layout, position);
+}
 
-    glm::ivec2 pos = position;
+void CText::LayoutString(const std::string &text, std::vector<FontMetaChar>::iterator format,
+                         std::vector<FontMetaChar>::iterator end,
+                         float size, int width, char32_t eol, Color color, TextLayout& layout)
+{
+    glm::ivec2 pos(0, 0);
 
     int start = pos.x;
 
@@ -962,7 +1341,7 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
             cw = GetCharWidthInt(ch, font, size, offset);
             pos.x = start + width - cw;
             color = Color(1.0f, 0.0f, 0.0f);
-            DrawCharAndAdjustPos(ch, font, size, pos, color);
+            LayoutCharAndAdjustPos(ch, font, size, pos, color, layout);
             break;
         }
 
@@ -997,18 +1376,17 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
             c = Color(0.239f, 0.384f, 0.341f, 1.0f); // #3D6257
         }
 
-        // draw highlight background or link underline
-        if (font != FONT_BUTTON)
+        // highlight background or link underline, drawn before all characters
+        if (font != FONT_BUTTON && ((format[fmtIndex] & FONT_MASK_LINK) != 0 ||
+                                    (format[fmtIndex] & FONT_MASK_HIGHLIGHT) == FONT_HIGHLIGHT_KEY))
         {
             glm::ivec2 charSize{};
             charSize.x = GetCharWidthInt(ch, font, size, offset);
             charSize.y = GetHeightInt(font, size);
-            // NB. for quad batching to improve highlight drawing performance, this code would have
-            // to be rearranged to draw all highlights before any characters are drawn.
-            DrawHighlight(format[fmtIndex], pos, charSize);
+            layout.highlights.push_back({ format[fmtIndex], pos, charSize });
         }
 
-        DrawCharAndAdjustPos(ch, font, size, pos, c);
+        LayoutCharAndAdjustPos(ch, font, size, pos, c, layout);
 
         // increment fmtIndex for each byte in multibyte character
         if ( ch[0] != 0 )
@@ -1024,8 +1402,42 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
         FontType font = FONT_COMMON;
         StrUtils::CodePoint ch = TranslateSpecialChar(eol);
         color = Color(1.0f, 0.0f, 0.0f);
-        DrawCharAndAdjustPos(ch, font, size, pos, color);
+        LayoutCharAndAdjustPos(ch, font, size, pos, color, layout);
     }
+}
+
+void CText::DrawLayout(const TextLayout& layout, const glm::ivec2& pos)
+{
+    m_engine->SetWindowCoordinates();
+
+    for (const auto& highlight : layout.highlights)
+        DrawHighlight(highlight.format, pos + highlight.pos, highlight.size);
+
+    for (const auto& [pointSize, texID] : layout.pages)
+        m_glyphAtlas->Touch(pointSize, texID);
+
+    for (const auto& quad : layout.quads)
+    {
+        Gfx::Vertex2D vertices[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            vertices[i] = quad.vertices[i];
+            vertices[i].position += glm::vec2(pos);
+        }
+
+        if (quad.texID != 0)
+        {
+            m_quadBatch->Add(vertices, quad.texID, TransparencyMode::ALPHA);
+        }
+        else
+        {
+            // TODO: A bit of code duplication, see CControl::SetButtonTextureForIcon()
+            const unsigned int texID = m_engine->LoadTexture(
+                StrUtils::ToPath("textures/interface/button" + StrUtils::ToString<int>(quad.buttonTexture) + ".png")).id;
+            m_quadBatch->Add(vertices, texID, TransparencyMode::NONE);
+        }
+    }
+
     m_quadBatch->Flush();
     m_engine->SetInterfaceCoordinates();
 }
@@ -1089,17 +1501,30 @@ void CText::DrawString(const std::string &text, FontType font,
 {
     assert(font != FONT_BUTTON);
 
-    glm::ivec2 pos = position;
+    m_glyphAtlas->BeginUse();
+
+    std::string key = MakeLayoutKey(text, nullptr, 0, font, GetFontPointSize(size), 0, 0, color);
+
+    TextLayout* layout = m_layoutCache->Find(key, m_glyphAtlas->GetGeneration());
+    if (layout == nullptr)
+    {
+        layout = &m_layoutCache->Insert(key, m_glyphAtlas->GetGeneration());
+        LayoutString(text, font, size, color, *layout);
+    }
+
+    DrawLayout(*layout, position);
+}
+
+void CText::LayoutString(const std::string &text, FontType font, float size, Color color, TextLayout& layout)
+{
+    glm::ivec2 pos(0, 0);
 
     std::vector<StrUtils::CodePoint> chars;
     StringToUTFCharList(text, chars);
-    m_engine->SetWindowCoordinates();
     for (auto it = chars.begin(); it != chars.end(); ++it)
     {
-        DrawCharAndAdjustPos(*it, font, size, pos, color);
+        LayoutCharAndAdjustPos(*it, font, size, pos, color, layout);
     }
-    m_quadBatch->Flush();
-    m_engine->SetInterfaceCoordinates();
 }
 
 void CText::DrawHighlight(FontMetaChar hl, const glm::ivec2& pos, const glm::ivec2& size)
@@ -1122,8 +1547,6 @@ void CText::DrawHighlight(FontMetaChar hl, const glm::ivec2& pos, const glm::ive
         return;
     }
 
-    m_quadBatch->Flush();
-
     glm::ivec2 vsize = m_engine->GetWindowSize();
     float h = 0.0f;
     if (vsize.y <= 768.0f)    // 1024x768 or less?
@@ -1156,7 +1579,8 @@ void CText::DrawHighlight(FontMetaChar hl, const glm::ivec2& pos, const glm::ive
     m_engine->AddStatisticTriangle(2);
 }
 
-void CText::DrawCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float size, glm::ivec2&pos, Color color)
+void CText::LayoutCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float size, glm::ivec2&pos, Color color,
+                                   TextLayout& layout)
 {
     if (font == FONT_BUTTON)
     {
@@ -1172,10 +1596,6 @@ void CText::DrawCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float si
         const unsigned texIndex = 1 + icon / 64;
         const unsigned iconIndex = icon % 64;
 
-        // TODO: A bit of code duplication, see CControl::SetButtonTextureForIcon()
-        const unsigned int texID = m_engine->LoadTexture(
-            StrUtils::ToPath("textures/interface/button" + StrUtils::ToString<int>(texIndex) + ".png")).id;
-
         glm::vec2 uv1, uv2;
         uv1.x = (32.0f / 256.0f) * (iconIndex % 8);
         uv1.y = (32.0f / 256.0f) * (iconIndex / 8);
@@ -1188,14 +1608,13 @@ void CText::DrawCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float si
         uv2.x -= dp;
         uv2.y -= dp;
 
-        Gfx::Vertex2D vertices[4];
-
-        vertices[0] = { { p1.x, p2.y }, { uv1.x, uv2.y } };
-        vertices[1] = { { p1.x, p1.y }, { uv1.x, uv1.y } };
-        vertices[2] = { { p2.x, p2.y }, { uv2.x, uv2.y } };
-        vertices[3] = { { p2.x, p1.y }, { uv2.x, uv1.y } };
+        TextLayout::Quad& quad = layout.quads.emplace_back();
+        quad.buttonTexture = texIndex;
 
-        m_quadBatch->Add(vertices, texID, TransparencyMode::NONE, color);
+        quad.vertices[0] = { { p1.x, p2.y }, { uv1.x, uv2.y } };
+        quad.vertices[1] = { { p1.x, p1.y }, { uv1.x, uv1.y } };
+        quad.vertices[2] = { { p2.x, p2.y }, { uv2.x, uv2.y } };
+        quad.vertices[3] = { { p2.x, p1.y }, { uv2.x, uv1.y } };
 
         pos.x += width;
     }
@@ -1226,14 +1645,17 @@ void CText::DrawCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float si
 
         Gfx::IntColor col = Gfx::ColorToIntColor(color);
 
-        Gfx::Vertex2D vertices[4];
+        TextLayout::Quad& quad = layout.quads.emplace_back();
+        quad.texID = tex.id;
 
-        vertices[0] = { { p1.x, p2.y }, { texCoord1.x, texCoord2.y }, col };
-        vertices[1] = { { p1.x, p1.y }, { texCoord1.x, texCoord1.y }, col };
-        vertices[2] = { { p2.x, p2.y }, { texCoord2.x, texCoord2.y }, col };
-        vertices[3] = { { p2.x, p1.y }, { texCoord2.x, texCoord1.y }, col };
+        quad.vertices[0] = { { p1.x, p2.y }, { texCoord1.x, texCoord2.y }, col };
+        quad.vertices[1] = { { p1.x, p1.y }, { texCoord1.x, texCoord1.y }, col };
+        quad.vertices[2] = { { p2.x, p2.y }, { texCoord2.x, texCoord2.y }, col };
+        quad.vertices[3] = { { p2.x, p1.y }, { texCoord2.x, texCoord1.y }, col };
 
-        m_quadBatch->Add(vertices, tex.id, TransparencyMode::ALPHA, color);
+        std::pair<int, unsigned int> page(GetFontPointSize(size), tex.id);
+        if (std::find(layout.pages.begin(), layout.pages.end(), page) == layout.pages.end())
+            layout.pages.push_back(page);
 
         pos.x += tex.charSize.x * width;
     }
@@ -1268,6 +1690,7 @@ CharTexture CText::GetCharTexture(StrUtils::CodePoint ch, FontType font, float s
     if (it != cf->cache.end())
     {
         tex = (*it).second;
+        m_glyphAtlas->Touch(cf->pointSize, tex.id);
     }
     else
     {
@@ -1301,96 +1724,15 @@ CharTexture CText::CreateCharTexture(StrUtils::CodePoint ch, CachedFont* font)
         return texture;
     }
 
-    const int pixelMargin = 1;
-    glm::ivec2 tileSize(Math::Max(16, Math::NextPowerOfTwo(textSurface->w)) + pixelMargin,
-                        Math::Max(16, Math::NextPowerOfTwo(textSurface->h)) + pixelMargin);
-
-    FontTexture* fontTexture = GetOrCreateFontTexture(tileSize);
-
-    if (fontTexture == nullptr)
+    texture = m_glyphAtlas->Add(m_device, font, ch, textSurface);
+    if (texture.id == 0)
     {
         m_error = "Texture create error";
     }
-    else
-    {
-        texture.id = fontTexture->id;
-        texture.charPos = GetNextTilePos(*fontTexture);
-        texture.charSize = { textSurface->w, textSurface->h };
-
-        ImageData imageData;
-        imageData.surface = textSurface;
-
-        Texture tex;
-        tex.id = texture.id;
-        m_device->UpdateTexture(tex, texture.charPos, &imageData, TextureFormat::RGBA);
-
-        imageData.surface = nullptr;
-
-        --fontTexture->freeSlots;
-    }
 
     SDL_FreeSurface(textSurface);
 
     return texture;
 }
 
-FontTexture* CText::GetOrCreateFontTexture(const glm::ivec2& tileSize)
-{
-    for (auto& fontTexture : m_fontTextures)
-    {
-       if (fontTexture.tileSize == tileSize && fontTexture.freeSlots > 0)
-           return &fontTexture;
-    }
-
-    FontTexture newFontTexture = CreateFontTexture(tileSize);
-    if (newFontTexture.id == 0)
-    {
-        return nullptr;
-    }
-
-    m_fontTextures.push_back(newFontTexture);
-    return &m_fontTextures.back();
-}
-
-FontTexture CText::CreateFontTexture(const glm::ivec2& tileSize)
-{
-    SDL_Surface* textureSurface = SDL_CreateRGBSurface(0, FONT_TEXTURE_SIZE.x, FONT_TEXTURE_SIZE.y, 32,
-                                                       0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-    ImageData data;
-    data.surface = textureSurface;
-
-    TextureCreateParams createParams;
-    createParams.format = TextureFormat::RGBA;
-    createParams.filter = TextureFilter::NEAREST;
-    createParams.mipmap = false;
-
-    Texture tex = m_device->CreateTexture(&data, createParams);
-
-    data.surface = nullptr;
-    SDL_FreeSurface(textureSurface);
-
-    FontTexture fontTexture;
-    fontTexture.id = tex.id;
-    fontTexture.tileSize = tileSize;
-    int horizontalTiles = FONT_TEXTURE_SIZE.x / tileSize.x;
-    int verticalTiles = FONT_TEXTURE_SIZE.y / tileSize.y;
-    fontTexture.freeSlots = horizontalTiles * verticalTiles;
-    return fontTexture;
-}
-
-glm::ivec2 CText::GetNextTilePos(const FontTexture& fontTexture)
-{
-    int horizontalTiles = FONT_TEXTURE_SIZE.x / std::max(1, fontTexture.tileSize.x); //this should prevent crashes in some combinations of resolution and font size, see issue #1128
-    int verticalTiles = FONT_TEXTURE_SIZE.y / std::max(1, fontTexture.tileSize.y);
-
-    int totalTiles = horizontalTiles * verticalTiles;
-    int tileNumber = totalTiles - fontTexture.freeSlots;
-
-    int verticalTileIndex = tileNumber / std::max(1, horizontalTiles);
-    int horizontalTileIndex = tileNumber % horizontalTiles;
-
-    return { horizontalTileIndex * fontTexture.tileSize.x,
-             verticalTileIndex * fontTexture.tileSize.y };
-}
-
 } // namespace Gfx
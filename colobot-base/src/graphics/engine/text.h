@@ -175,7 +175,6 @@ struct CharTexture
 class FontsCache;
 struct CachedFont;
 struct MultisizeFont;
-struct FontTexture;
 
 /**
  * \enum SpecialChar
@@ -198,6 +197,10 @@ enum SpecialChar
  * CText is responsible for drawing text in 2D interface. Font rendering is done using
  * textures generated by SDL_ttf from TTF font files.
  *
+ * Rendered characters are packed into a glyph atlas kept separately for every font point size.
+ * Layouts of drawn strings are cached, so drawing an unchanged string again only translates
+ * its vertices and sends them as one batch per atlas page.
+ *
  * All functions rendering text are divided into two types:
  * - single font - function takes a single FontType argument that (along with size)
  *   determines the font to be used for all characters,
@@ -295,17 +298,25 @@ protected:
     int GetFontPointSize(float size) const;
     CachedFont* GetOrOpenFont(FontType type, float size);
     CharTexture CreateCharTexture(StrUtils::CodePoint ch, CachedFont* font);
-    FontTexture* GetOrCreateFontTexture(const glm::ivec2& tileSize);
-    FontTexture CreateFontTexture(const glm::ivec2& tileSize);
-    glm::ivec2 GetNextTilePos(const FontTexture& fontTexture);
+
+    struct TextLayout;
 
     void        DrawString(const std::string &text, std::vector<FontMetaChar>::iterator format,
                            std::vector<FontMetaChar>::iterator end,
                            float size, const glm::ivec2& pos, int width, char32_t eol, Color color);
     void        DrawString(const std::string &text, FontType font,
                            float size, const glm::ivec2& pos, int width, char32_t eol, Color color);
+    //! Lays out text (multi-format) starting at (0, 0)
+    void        LayoutString(const std::string &text, std::vector<FontMetaChar>::iterator format,
+                             std::vector<FontMetaChar>::iterator end,
+                             float size, int width, char32_t eol, Color color, TextLayout& layout);
+    //! Lays out text (one font) starting at (0, 0)
+    void        LayoutString(const std::string &text, FontType font, float size, Color color, TextLayout& layout);
+    //! Draws cached or newly laid out text at given position
+    void        DrawLayout(const TextLayout& layout, const glm::ivec2& pos);
     void        DrawHighlight(FontMetaChar hl, const glm::ivec2& pos, const glm::ivec2& size);
-    void        DrawCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float size, glm::ivec2&pos, Color color);
+    void        LayoutCharAndAdjustPos(StrUtils::CodePoint ch, FontType font, float size, glm::ivec2&pos, Color color,
+                                       TextLayout& layout);
     void        StringToUTFCharList(std::string_view text, std::vector<StrUtils::CodePoint> &chars);
     void        StringToUTFCharList(std::string_view text, std::vector<StrUtils::CodePoint> &chars, std::vector<FontMetaChar>::iterator format, std::vector<FontMetaChar>::iterator end);
 
@@ -320,7 +331,12 @@ protected:
     int          m_tabSize;
 
     std::unique_ptr<FontsCache> m_fontsCache;
-    std::vector<FontTexture> m_fontTextures;
+
+    class CGlyphAtlas;
+    std::unique_ptr<CGlyphAtlas> m_glyphAtlas;
+
+    class CLayoutCache;
+    std::unique_ptr<CLayoutCache> m_layoutCache;
 
     class CQuadBatch;
     std::unique_ptr<CQuadBatch> m_quadBatch;
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/engine/triangle_bvh.h"
+
+#include "math/geometry.h"
+
+#include <algorithm>
+#include <numeric>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+CTriangleBVH::CTriangleBVH(const std::vector<glm::vec3>& vertices)
+{
+    int count = static_cast<int>(vertices.size() / 3);
+    if (count == 0)
+        return;
+
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<glm::vec3> centroids(count);
+    for (int i = 0; i < count; i++)
+        centroids[i] = (vertices[i*3+0] + vertices[i*3+1] + vertices[i*3+2]) / 3.0f;
+
+    m_nodes.reserve(2 * (count / LEAF_SIZE + 1));
+    Build(order, centroids, vertices, 0, count);
+
+    m_vertices.reserve(count * 3);
+    for (int index : order)
+    {
+        m_vertices.push_back(vertices[index*3+0]);
+        m_vertices.push_back(vertices[index*3+1]);
+        m_vertices.push_back(vertices[index*3+2]);
+    }
+}
+
+int CTriangleBVH::Build(std::vector<int>& order, const std::vector<glm::vec3>& centroids,
+                        const std::vector<glm::vec3>& vertices, int first, int count)
+{
+    int nodeIndex = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    glm::vec3 min = vertices[order[first]*3];
+    glm::vec3 max = min;
+    glm::vec3 centroidMin = centroids[order[first]];
+    glm::vec3 centroidMax = centroidMin;
+    for (int i = first; i < first + count; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            min = glm::min(min, vertices[order[i]*3+j]);
+            max = glm::max(max, vertices[order[i]*3+j]);
+        }
+        centroidMin = glm::min(centroidMin, centroids[order[i]]);
+        centroidMax = glm::max(centroidMax, centroids[order[i]]);
+    }
+
+    m_nodes[nodeIndex].min = min;
+    m_nodes[nodeIndex].max = max;
+
+    if (count <= LEAF_SIZE)
+    {
+        m_nodes[nodeIndex].first = first;
+        m_nodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    glm::vec3 extent = centroidMax - centroidMin;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    int middle = first + count / 2;
+    std::nth_element(order.begin() + first, order.begin() + middle, order.begin() + first + count,
+                     [&centroids, axis](int a, int b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    Build(order, centroids, vertices, first, middle - first);
+    int right = Build(order, centroids, vertices, middle, first + count - middle);
+
+    m_nodes[nodeIndex].first = right;
+    m_nodes[nodeIndex].axis = axis;
+    return nodeIndex;
+}
+
+bool CTriangleBVH::Intersect(const glm::vec3& origin, const glm::vec3& dir, float tMin, float& tMax) const
+{
+    if (m_nodes.empty())
+        return false;
+
+    glm::vec3 invDir = 1.0f / dir;
+    bool hit = false;
+
+    // median splits keep the depth logarithmic, so a small fixed stack is enough
+    int stack[64];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0)
+    {
+        int nodeIndex = stack[--size];
+        const Node& node = m_nodes[nodeIndex];
+
+        float nodeMin = tMin, nodeMax = tMax;
+        if (!Math::IntersectRayBox(origin, invDir, node.min, node.max, nodeMin, nodeMax))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                float t = 0.0f;
+                if (Math::IntersectRayTriangle(origin, dir, m_vertices[i*3+0], m_vertices[i*3+1], m_vertices[i*3+2],
+                                               tMin, tMax, t))
+                {
+                    tMax = t;
+                    hit = true;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first, so that farther one can be culled by the shortened ray
+        if (dir[node.axis] < 0.0f)
+        {
+            stack[size++] = nodeIndex + 1;
+            stack[size++] = node.first;
+        }
+        else
+        {
+            stack[size++] = node.first;
+            stack[size++] = nodeIndex + 1;
+        }
+    }
+
+    return hit;
+}
+
+int CTriangleBVH::GetTriangleCount() const
+{
+    return static_cast<int>(m_vertices.size() / 3);
+}
+
+} // namespace Gfx
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/triangle_bvh.h
+ * \brief Bounding volume hierarchy over triangles used for mouse picking
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \class CTriangleBVH
+ * \brief Static bounding volume hierarchy over the triangles of a base object
+ *
+ * Nodes are split at the median triangle along the longest axis of their centroids
+ * and stored depth-first, so the left child of a node always follows it.
+ * Triangles are reordered so that every leaf refers to a contiguous range.
+ */
+class CTriangleBVH
+{
+public:
+    //! Maximum number of triangles in a leaf
+    static constexpr int LEAF_SIZE = 4;
+
+    //! Builds the hierarchy from triangles given as consecutive triples of vertices
+    explicit CTriangleBVH(const std::vector<glm::vec3>& vertices);
+
+    //! Intersects the ray \a origin + t * \a dir with the triangles
+    /**
+     * Only hits with t in [tMin, tMax] are considered.
+     * If there is a hit, returns true and sets \a tMax to the nearest one.
+     */
+    bool Intersect(const glm::vec3& origin, const glm::vec3& dir, float tMin, float& tMax) const;
+
+    //! Returns the number of triangles
+    int GetTriangleCount() const;
+
+private:
+    struct Node
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+        //! First triangle for leaves, index of the right child for inner nodes
+        int first = 0;
+        //! Number of triangles, 0 for inner nodes
+        int count = 0;
+        //! Axis along which the children were split
+        int axis = 0;
+    };
+
+    int Build(std::vector<int>& order, const std::vector<glm::vec3>& centroids,
+              const std::vector<glm::vec3>& vertices, int first, int count);
+
+    std::vector<Node> m_nodes;
+    //! Vertices of triangles in leaf order
+    std::vector<glm::vec3> m_vertices;
+};
+
+} // namespace Gfx
@@ -0,0 +1,524 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/model/model_cache.h"
+
+#include "common/logger.h"
+#include "common/stringutils.h"
+
+#include "common/resources/inputstream.h"
+#include "common/resources/outputstream.h"
+#include "common/resources/resourcemanager.h"
+
+#include "graphics/model/model_io_exception.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Gfx::ModelIO
+{
+
+namespace
+{
+
+constexpr char CACHE_MAGIC[4] = { 'C', 'M', 'D', 'C' };
+//! Increment when the layout changes
+constexpr std::uint32_t CACHE_VERSION = 1;
+const std::filesystem::path CACHE_DIRECTORY = "cache/models";
+
+bool g_cacheEnabled = true;
+
+constexpr std::array<VertexAttribute, 7> CACHED_ATTRIBUTES =
+{
+    VertexAttribute::COLOR,
+    VertexAttribute::UV1,
+    VertexAttribute::UV2,
+    VertexAttribute::NORMAL,
+    VertexAttribute::TANGENT,
+    VertexAttribute::BONE_INDICES,
+    VertexAttribute::BONE_WEIGHTS,
+};
+
+struct CacheKey
+{
+    std::string path;
+    long long modificationTime = 0;
+    long long size = 0;
+};
+
+CacheKey GetCacheKey(const std::filesystem::path& path)
+{
+    CacheKey key;
+    key.path = CResourceManager::CleanPath(path);
+    key.modificationTime = CResourceManager::GetLastModificationTime(path);
+    key.size = CResourceManager::GetFileSize(path);
+    return key;
+}
+
+/**
+ * \class CCacheWriter
+ * \brief Appends aligned binary data to a buffer
+ */
+class CCacheWriter
+{
+public:
+    void WriteBytes(const void* data, std::size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+        m_data.resize((m_data.size() + 3) & ~std::size_t{3}, 0);
+    }
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string& value)
+    {
+        Write(static_cast<std::uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    void WritePath(const std::filesystem::path& value)
+    {
+        WriteString(StrUtils::ToString(value));
+    }
+
+    template<typename T>
+    void WriteArray(const T* data, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(data, count * sizeof(T));
+    }
+
+    const std::vector<char>& GetData() const
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<char> m_data;
+};
+
+/**
+ * \class CCacheReader
+ * \brief Reads binary data written by CCacheWriter, checking bounds
+ */
+class CCacheReader
+{
+public:
+    CCacheReader(const char* data, std::size_t size)
+        : m_data(data), m_size(size) {}
+
+    const char* ReadBytes(std::size_t size)
+    {
+        std::size_t aligned = (size + 3) & ~std::size_t{3};
+        if (m_position + aligned > m_size)
+            throw CModelIOException("Unexpected end of cache file");
+
+        const char* bytes = m_data + m_position;
+        m_position += aligned;
+        return bytes;
+    }
+
+    template<typename T>
+    T Read()
+    {
+        T value;
+        std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        auto size = Read<std::uint32_t>();
+        return std::string(ReadBytes(size), size);
+    }
+
+    std::filesystem::path ReadPath()
+    {
+        return StrUtils::ToPath(ReadString());
+    }
+
+    std::size_t GetRemaining() const
+    {
+        return m_size - m_position;
+    }
+
+    std::size_t GetPosition() const
+    {
+        return m_position;
+    }
+
+    void ReadArray(void* destination, std::size_t size)
+    {
+        if (size == 0)
+            return;
+
+        std::memcpy(destination, ReadBytes(size), size);
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_position = 0;
+};
+
+void WriteMaterial(CCacheWriter& writer, const Material& material)
+{
+    writer.Write(static_cast<glm::vec4>(material.albedoColor));
+    writer.WritePath(material.albedoTexture);
+    writer.Write(material.roughness);
+    writer.Write(material.metalness);
+    writer.Write(material.aoStrength);
+    writer.WritePath(material.materialTexture);
+    writer.Write(static_cast<glm::vec4>(material.emissiveColor));
+    writer.WritePath(material.emissiveTexture);
+    writer.WriteString(material.normalTexture);
+    writer.Write(static_cast<std::uint8_t>(material.alphaMode));
+    writer.Write(material.alphaThreshold);
+    writer.Write(static_cast<std::uint8_t>(material.cullFace));
+    writer.WriteString(material.tag);
+    writer.WriteString(material.recolor);
+    writer.Write(static_cast<glm::vec4>(material.recolorReference));
+    writer.Write(material.recolorThreshold);
+    writer.Write(static_cast<std::uint8_t>(material.variableDetail));
+    writer.WritePath(material.detailTexture);
+}
+
+Color ReadColor(CCacheReader& reader)
+{
+    auto color = reader.Read<glm::vec4>();
+    return Color(color.r, color.g, color.b, color.a);
+}
+
+Material ReadMaterial(CCacheReader& reader)
+{
+    Material material;
+    material.albedoColor = ReadColor(reader);
+    material.albedoTexture = reader.ReadPath();
+    material.roughness = reader.Read<float>();
+    material.metalness = reader.Read<float>();
+    material.aoStrength = reader.Read<float>();
+    material.materialTexture = reader.ReadPath();
+    material.emissiveColor = ReadColor(reader);
+    material.emissiveTexture = reader.ReadPath();
+    material.normalTexture = reader.ReadString();
+    material.alphaMode = static_cast<AlphaMode>(reader.Read<std::uint8_t>());
+    material.alphaThreshold = reader.Read<float>();
+    material.cullFace = static_cast<CullFace>(reader.Read<std::uint8_t>());
+    material.tag = reader.ReadString();
+    material.recolor = reader.ReadString();
+    material.recolorReference = ReadColor(reader);
+    material.recolorThreshold = reader.Read<float>();
+    material.variableDetail = reader.Read<std::uint8_t>() != 0;
+    material.detailTexture = reader.ReadPath();
+    return material;
+}
+
+void WritePart(CCacheWriter& writer, const CModelPart& part)
+{
+    WriteMaterial(writer, part.GetMaterial());
+
+    std::uint32_t attributes = 0;
+    for (std::size_t i = 0; i < CACHED_ATTRIBUTES.size(); ++i)
+    {
+        if (part.Has(CACHED_ATTRIBUTES[i]))
+            attributes |= 1u << i;
+    }
+    writer.Write(attributes);
+
+    std::uint32_t vertexCount = part.GetVertexCount();
+    std::uint32_t indexCount = part.IsIndexed() ? part.GetIndexCount() : 0;
+    writer.Write(vertexCount);
+    writer.Write(indexCount);
+
+    writer.WriteArray(part.GetPositionData(), vertexCount);
+    for (auto attribute : CACHED_ATTRIBUTES)
+    {
+        if (part.Has(attribute))
+        {
+            writer.WriteBytes(part.GetAttributeData(attribute), vertexCount * CModelPart::GetAttributeSize(attribute));
+        }
+    }
+    writer.WriteArray(part.GetIndexData(), indexCount);
+}
+
+void ReadPart(CCacheReader& reader, CModelMesh& mesh)
+{
+    CModelPart* part = mesh.AddPart(ReadMaterial(reader));
+
+    auto attributes = reader.Read<std::uint32_t>();
+    auto vertexCount = reader.Read<std::uint32_t>();
+    auto indexCount = reader.Read<std::uint32_t>();
+
+    std::uint64_t vertexSize = sizeof(glm::vec3);
+    for (std::size_t i = 0; i < CACHED_ATTRIBUTES.size(); ++i)
+    {
+        if (attributes & (1u << i))
+        {
+            part->Add(CACHED_ATTRIBUTES[i]);
+            vertexSize += CModelPart::GetAttributeSize(CACHED_ATTRIBUTES[i]);
+        }
+    }
+
+    // counts are checked before allocating, so that a corrupt file can't request huge arrays
+    std::uint64_t size = vertexCount * vertexSize + std::uint64_t{indexCount} * sizeof(std::uint32_t);
+    if (size > reader.GetRemaining())
+        throw CModelIOException("Vertex or index count exceeds the size of cache file");
+
+    part->SetVertices(vertexCount);
+    part->SetIndices(indexCount);
+
+    reader.ReadArray(part->GetPositionData(), vertexCount * sizeof(glm::vec3));
+    for (auto attribute : CACHED_ATTRIBUTES)
+    {
+        if (part->Has(attribute))
+        {
+            reader.ReadArray(part->GetAttributeData(attribute), vertexCount * CModelPart::GetAttributeSize(attribute));
+        }
+    }
+    reader.ReadArray(part->GetIndexData(), indexCount * sizeof(std::uint32_t));
+}
+
+void WriteModel(CCacheWriter& writer, const CModel& model)
+{
+    const auto& crashSpheres = model.GetCrashSpheres();
+    writer.Write(static_cast<std::uint32_t>(crashSpheres.size()));
+    for (const auto& crashSphere : crashSpheres)
+    {
+        writer.Write(crashSphere.position);
+        writer.Write(crashSphere.radius);
+        writer.WriteString(crashSphere.sound);
+        writer.Write(crashSphere.hardness);
+    }
+
+    writer.Write(static_cast<std::uint8_t>(model.HasShadowSpot()));
+    if (model.HasShadowSpot())
+    {
+        writer.Write(model.GetShadowSpot().radius);
+        writer.Write(model.GetShadowSpot().intensity);
+    }
+
+    writer.Write(static_cast<std::uint8_t>(model.HasCameraCollisionSphere()));
+    if (model.HasCameraCollisionSphere())
+    {
+        writer.Write(model.GetCameraCollisionSphere().pos);
+        writer.Write(model.GetCameraCollisionSphere().radius);
+    }
+
+    auto meshNames = model.GetMeshNames();
+    writer.Write(static_cast<std::uint32_t>(meshNames.size()));
+    for (const auto& name : meshNames)
+    {
+        const CModelMesh* mesh = model.GetMesh(name);
+
+        writer.WriteString(name);
+        writer.WriteString(mesh->GetParent());
+        writer.Write(mesh->GetPosition());
+        writer.Write(mesh->GetRotation());
+        writer.Write(mesh->GetScale());
+
+        writer.Write(static_cast<std::uint32_t>(mesh->GetPartCount()));
+        for (std::size_t i = 0; i < mesh->GetPartCount(); ++i)
+        {
+            WritePart(writer, *mesh->GetPart(i));
+        }
+    }
+}
+
+std::unique_ptr<CModel> ReadModel(CCacheReader& reader)
+{
+    auto model = std::make_unique<CModel>();
+
+    auto crashSphereCount = reader.Read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < crashSphereCount; ++i)
+    {
+        ModelCrashSphere crashSphere;
+        crashSphere.position = reader.Read<glm::vec3>();
+        crashSphere.radius = reader.Read<float>();
+        crashSphere.sound = reader.ReadString();
+        crashSphere.hardness = reader.Read<float>();
+        model->AddCrashSphere(crashSphere);
+    }
+
+    if (reader.Read<std::uint8_t>() != 0)
+    {
+        ModelShadowSpot shadowSpot;
+        shadowSpot.radius = reader.Read<float>();
+        shadowSpot.intensity = reader.Read<float>();
+        model->SetShadowSpot(shadowSpot);
+    }
+
+    if (reader.Read<std::uint8_t>() != 0)
+    {
+        Math::Sphere sphere;
+        sphere.pos = reader.Read<glm::vec3>();
+        sphere.radius = reader.Read<float>();
+        model->SetCameraCollisionSphere(sphere);
+    }
+
+    auto meshCount = reader.Read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < meshCount; ++i)
+    {
+        auto mesh = std::make_unique<CModelMesh>();
+
+        std::string name = reader.ReadString();
+        mesh->SetParent(reader.ReadString());
+        mesh->SetPosition(reader.Read<glm::vec3>());
+        mesh->SetRotation(reader.Read<glm::vec3>());
+        mesh->SetScale(reader.Read<glm::vec3>());
+
+        auto partCount = reader.Read<std::uint32_t>();
+        for (std::uint32_t j = 0; j < partCount; ++j)
+        {
+            ReadPart(reader, *mesh);
+        }
+
+        model->AddMesh(name, std::move(mesh));
+    }
+
+    return model;
+}
+
+} // namespace
+
+std::vector<char> EncodeCachedModel(const CModel& model)
+{
+    CCacheWriter writer;
+    WriteModel(writer, model);
+    return writer.GetData();
+}
+
+std::unique_ptr<CModel> DecodeCachedModel(const char* data, std::size_t size)
+{
+    CCacheReader reader(data, size);
+    return ReadModel(reader);
+}
+
+std::filesystem::path GetCachedModelPath(const std::filesystem::path& path)
+{
+    // FNV-1a, stable across platforms and runs
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : CResourceManager::CleanPath(path))
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+    return CACHE_DIRECTORY / name;
+}
+
+std::unique_ptr<CModel> ReadCachedModel(const std::filesystem::path& path)
+{
+    if (!g_cacheEnabled || CResourceManager::GetSaveLocation().empty())
+        return nullptr;
+
+    std::filesystem::path cachePath = GetCachedModelPath(path);
+    if (!CResourceManager::Exists(cachePath))
+        return nullptr;
+
+    CInputStream stream(cachePath);
+    if (!stream.is_open())
+        return nullptr;
+
+    // the whole file is read at once and then used in place
+    std::vector<char> data(stream.size());
+    stream.read(data.data(), data.size());
+    if (static_cast<std::size_t>(stream.gcount()) != data.size())
+        return nullptr;
+
+    try
+    {
+        CCacheReader reader(data.data(), data.size());
+
+        if (std::memcmp(reader.ReadBytes(sizeof(CACHE_MAGIC)), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+            return nullptr;
+        if (reader.Read<std::uint32_t>() != CACHE_VERSION)
+            return nullptr;
+
+        CacheKey key = GetCacheKey(path);
+        if (reader.ReadString() != key.path)
+            return nullptr;
+        if (reader.Read<std::int64_t>() != key.modificationTime)
+            return nullptr;
+        if (reader.Read<std::int64_t>() != key.size)
+            return nullptr;
+
+        return DecodeCachedModel(data.data() + reader.GetPosition(), reader.GetRemaining());
+    }
+    catch (const CModelIOException& e)
+    {
+        GetLogger()->Warn("Invalid model cache file '%%': %%", cachePath, e.what());
+        return nullptr;
+    }
+}
+
+bool WriteCachedModel(const std::filesystem::path& path, const CModel& model)
+{
+    if (!g_cacheEnabled || CResourceManager::GetSaveLocation().empty())
+        return false;
+
+    CCacheWriter writer;
+    CacheKey key = GetCacheKey(path);
+
+    writer.WriteBytes(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writer.Write(CACHE_VERSION);
+    writer.WriteString(key.path);
+    writer.Write(static_cast<std::int64_t>(key.modificationTime));
+    writer.Write(static_cast<std::int64_t>(key.size));
+    auto encoded = EncodeCachedModel(model);
+    writer.WriteBytes(encoded.data(), encoded.size());
+
+    if (!CResourceManager::DirectoryExists(CACHE_DIRECTORY))
+        CResourceManager::CreateNewDirectory(CACHE_DIRECTORY);
+
+    std::filesystem::path cachePath = GetCachedModelPath(path);
+    COutputStream stream(cachePath);
+    if (!stream.is_open())
+    {
+        GetLogger()->Debug("Could not write model cache file '%%'", cachePath);
+        return false;
+    }
+
+    const auto& data = writer.GetData();
+    stream.write(data.data(), data.size());
+    return stream.good();
+}
+
+void SetModelCacheEnabled(bool enabled)
+{
+    g_cacheEnabled = enabled;
+}
+
+bool GetModelCacheEnabled()
+{
+    return g_cacheEnabled;
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "graphics/model/model.h"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+/**
+ * \page modelcache Model cache
+ *
+ * Models read from source files (.mod, .txt, .gltf) are stored in a binary cache
+ * in the save directory (\p cache/models), so that later launches don't have to parse them again.
+ *
+ * The cache file is laid out so that it can be used directly from memory after reading it
+ * in one go: all arrays are 4-byte aligned, prefixed with their length and stored in native
+ * byte order, so vertex arrays are copied to mesh parts as whole blocks.
+ *
+ * A cache file is only used if the source path, modification time and size stored
+ * in its header match the source file. Otherwise it's rewritten after parsing the source.
+ */
+
+namespace Gfx::ModelIO
+{
+
+//! Encodes model as stored in cache files after their header
+std::vector<char> EncodeCachedModel(const CModel& model);
+
+//! Decodes model encoded by EncodeCachedModel()
+/**
+ * @throws CModelIOException if the data is truncated or corrupt
+ */
+std::unique_ptr<CModel> DecodeCachedModel(const char* data, std::size_t size);
+
+//! Returns path of cache file for given source model file
+std::filesystem::path GetCachedModelPath(const std::filesystem::path& path);
+
+//! Reads model from cache, returns nullptr if there is no valid cache for given source file
+std::unique_ptr<CModel> ReadCachedModel(const std::filesystem::path& path);
+
+//! Writes model read from given source file to cache
+bool WriteCachedModel(const std::filesystem::path& path, const CModel& model);
+
+//! Enables or disables use of the cache
+void SetModelCacheEnabled(bool enabled);
+bool GetModelCacheEnabled();
+
+}
@@ -19,6 +19,7 @@
 
 #include "graphics/model/model_input.h"
 
+#include "graphics/model/model_cache.h"
 #include "graphics/model/model_gltf.h"
 #include "graphics/model/model_mod.h"
 #include "graphics/model/model_txt.h"
@@ -31,6 +32,17 @@ namespace Gfx
 {
 
 std::unique_ptr<CModel> ModelInput::Read(const std::filesystem::path& path)
+{
+    auto model = ModelIO::ReadCachedModel(path);
+    if (model != nullptr)
+        return model;
+
+    model = ReadSource(path);
+    ModelIO::WriteCachedModel(path, *model);
+    return model;
+}
+
+std::unique_ptr<CModel> ModelInput::ReadSource(const std::filesystem::path& path)
 {
     auto extension = path.extension();
 
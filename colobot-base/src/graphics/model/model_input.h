@@ -33,7 +33,10 @@ namespace Gfx
  */
 namespace ModelInput
 {
+    //! Reads model from binary cache if it's up to date, otherwise from given file
     std::unique_ptr<CModel> Read(const std::filesystem::path& path);
+    //! Reads model from given file, bypassing the cache
+    std::unique_ptr<CModel> ReadSource(const std::filesystem::path& path);
 }
 
 } // namespace Gfx
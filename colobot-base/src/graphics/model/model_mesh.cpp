@@ -323,6 +323,79 @@ void CModelPart::GetTriangles(std::vector<Gfx::ModelTriangle>& triangles)
     }
 }
 
+glm::vec3* CModelPart::GetPositionData()
+{
+    return m_positions.array.data();
+}
+
+const glm::vec3* CModelPart::GetPositionData() const
+{
+    return m_positions.array.data();
+}
+
+void* CModelPart::GetAttributeData(VertexAttribute attribute)
+{
+    return const_cast<void*>(static_cast<const CModelPart*>(this)->GetAttributeData(attribute));
+}
+
+const void* CModelPart::GetAttributeData(VertexAttribute attribute) const
+{
+    if (!Has(attribute))
+        return nullptr;
+
+    switch (attribute)
+    {
+    case VertexAttribute::COLOR:
+        return m_colors.array.data();
+    case VertexAttribute::UV1:
+        return m_uvs1.array.data();
+    case VertexAttribute::UV2:
+        return m_uvs2.array.data();
+    case VertexAttribute::NORMAL:
+        return m_normals.array.data();
+    case VertexAttribute::TANGENT:
+        return m_tangents.array.data();
+    case VertexAttribute::BONE_INDICES:
+        return m_boneIndices.array.data();
+    case VertexAttribute::BONE_WEIGHTS:
+        return m_boneWeights.array.data();
+    default:
+        return nullptr;
+    }
+}
+
+std::uint32_t* CModelPart::GetIndexData()
+{
+    return m_indices.array.data();
+}
+
+const std::uint32_t* CModelPart::GetIndexData() const
+{
+    return m_indices.array.data();
+}
+
+size_t CModelPart::GetAttributeSize(VertexAttribute attribute)
+{
+    switch (attribute)
+    {
+    case VertexAttribute::COLOR:
+        return sizeof(glm::u8vec4);
+    case VertexAttribute::UV1:
+    case VertexAttribute::UV2:
+        return sizeof(glm::vec2);
+    case VertexAttribute::NORMAL:
+        return sizeof(glm::vec3);
+    case VertexAttribute::TANGENT:
+        return sizeof(glm::vec4);
+    case VertexAttribute::BONE_INDICES:
+        return sizeof(glm::u8vec4);
+    case VertexAttribute::BONE_WEIGHTS:
+        return sizeof(glm::vec4);
+    default:
+        return 0;
+    }
+}
+
 void CModelMesh::AddTriangle(const ModelTriangle& triangle)
 {
     for (auto& part : m_parts)
@@ -155,6 +155,20 @@ public:
     //! Fills the array with converted model triangles
     void GetTriangles(std::vector<Gfx::ModelTriangle>& triangles);
 
+    //@{
+    //! Raw access to contiguous vertex data, used for bulk copying
+    /** Attribute data is nullptr if the attribute is not present. */
+    glm::vec3* GetPositionData();
+    const glm::vec3* GetPositionData() const;
+    void* GetAttributeData(VertexAttribute attribute);
+    const void* GetAttributeData(VertexAttribute attribute) const;
+    std::uint32_t* GetIndexData();
+    const std::uint32_t* GetIndexData() const;
+    //@}
+
+    //! Returns size of single element of given vertex attribute in bytes
+    static size_t GetAttributeSize(VertexAttribute attribute);
+
     friend class CVertexProxy;
 
 private:
@@ -278,12 +278,16 @@ void CGL33Device::BeginScene()
 
 void CGL33Device::EndScene()
 {
+    FlushUIRenderer();
+
     if constexpr (Version::DEVELOPMENT_BUILD)
         CheckGLErrors();
 }
 
 void CGL33Device::Clear()
 {
+    FlushUIRenderer();
+
     glDepthMask(GL_TRUE);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -295,21 +299,29 @@ CUIRenderer* CGL33Device::GetUIRenderer()
 
 CTerrainRenderer* CGL33Device::GetTerrainRenderer()
 {
+    FlushUIRenderer();
+
     return m_terrainRenderer.get();
 }
 
 CObjectRenderer* CGL33Device::GetObjectRenderer()
 {
+    FlushUIRenderer();
+
     return m_objectRenderer.get();
 }
 
 CParticleRenderer* CGL33Device::GetParticleRenderer()
 {
+    FlushUIRenderer();
+
     return m_particleRenderer.get();
 }
 
 CShadowRenderer* CGL33Device::GetShadowRenderer()
 {
+    FlushUIRenderer();
+
     return m_shadowRenderer.get();
 }
 
@@ -476,6 +488,8 @@ void CGL33Device::UpdateTexture(const Texture& texture, const glm::ivec2& offset
 {
     if (texture.id == 0) return;
 
+    FlushUIRenderer();
+
     glActiveTexture(GL_TEXTURE3);
     glBindTexture(GL_TEXTURE_2D, texture.id);
 
@@ -497,6 +511,7 @@ void CGL33Device::DestroyTexture(const Texture &texture)
     auto it = m_allTextures.find(texture);
     if (it != m_allTextures.end())
     {
+        FlushUIRenderer();
         glDeleteTextures(1, &texture.id);
         m_allTextures.erase(it);
     }
@@ -504,6 +519,8 @@ void CGL33Device::DestroyTexture(const Texture &texture)
 
 void CGL33Device::DestroyAllTextures()
 {
+    FlushUIRenderer();
+
     // Unbind all texture stages
     for (int index = 0; index < 32; ++index)
     {
@@ -540,6 +557,8 @@ void CGL33Device::DestroyVertexBuffer(CVertexBuffer* buffer)
 
 void CGL33Device::SetViewport(int x, int y, int width, int height)
 {
+    FlushUIRenderer();
+
     glViewport(x, y, width, height);
 }
 
@@ -621,6 +640,8 @@ void CGL33Device::SetTransparency(TransparencyMode mode)
 
 void CGL33Device::SetColorMask(bool red, bool green, bool blue, bool alpha)
 {
+    FlushUIRenderer();
+
     glColorMask(red, green, blue, alpha);
 }
 
@@ -633,19 +654,26 @@ void CGL33Device::CopyFramebufferToTexture(Texture& texture, int xOffset, int yO
 {
     if (texture.id == 0) return;
 
+    FlushUIRenderer();
+
     glActiveTexture(GL_TEXTURE3);
     glBindTexture(GL_TEXTURE_2D, texture.id);
 
     glCopyTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset, x, y, width, height);
 }
 
-std::unique_ptr<CFrameBufferPixels> CGL33Device::GetFrameBufferPixels() const
+std::unique_ptr<CFrameBufferPixels> CGL33Device::GetFrameBufferPixels()
 {
+    FlushUIRenderer();
+
     return GetGLFrameBufferPixels(m_config.size);
 }
 
 CFramebuffer* CGL33Device::GetFramebuffer(std::string name)
 {
+    // framebuffer may be bound or read after this
+    FlushUIRenderer();
+
     auto it = m_framebuffers.find(name);
     if (it == m_framebuffers.end())
         return nullptr;
@@ -674,6 +702,8 @@ void CGL33Device::DeleteFramebuffer(std::string name)
     // can't delete default framebuffer
     if (name == "default") return;
 
+    FlushUIRenderer();
+
     auto it = m_framebuffers.find(name);
     if (it != m_framebuffers.end())
     {
@@ -682,6 +712,21 @@ void CGL33Device::DeleteFramebuffer(std::string name)
     }
 }
 
+void CGL33Device::FlushUIRenderer()
+{
+    if (m_uiRenderer == nullptr) return;
+
+    bool depthTest = m_depthTest;
+    CullFace cullFace = m_cullFace;
+    TransparencyMode transparency = m_transparency;
+
+    m_uiRenderer->Flush();
+
+    SetDepthTest(depthTest);
+    SetCullFace(cullFace);
+    SetTransparency(transparency);
+}
+
 bool CGL33Device::IsAnisotropySupported()
 {
     return m_capabilities.anisotropySupported;
@@ -132,7 +132,7 @@ public:
 
     void CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height) override;
 
-    std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() const override;
+    std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() override;
 
     CFramebuffer* GetFramebuffer(std::string name) override;
 
@@ -152,6 +152,9 @@ public:
     bool IsFramebufferSupported() override;
 
 private:
+    //! Draws buffered UI primitives, keeping current render state
+    void FlushUIRenderer();
+
     //! Current config
     DeviceConfig m_config;
 
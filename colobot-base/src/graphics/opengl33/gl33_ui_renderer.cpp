@@ -79,9 +79,7 @@ CGL33UIRenderer::CGL33UIRenderer(CGL33Device* device)
     m_uniforms.projectionMatrix = glm::ortho(0.0f, +1.0f, 0.0f, +1.0f);
     m_uniforms.color = { 1.0f, 1.0f, 1.0f, 1.0f };
 
-    m_uniformsDirty = true;
-
-    UpdateUniforms();
+    UpdateUniforms(m_uniforms);
 
     // Bind uniform block to uniform buffer binding
     GLuint blockIndex = glGetUniformBlockIndex(m_program, "Uniforms");
@@ -133,32 +131,21 @@ CGL33UIRenderer::~CGL33UIRenderer()
 void CGL33UIRenderer::SetProjection(float left, float right, float bottom, float top)
 {
     m_uniforms.projectionMatrix = glm::ortho(left, right, bottom, top);
-    m_uniformsDirty = true;
 }
 
 void CGL33UIRenderer::SetTexture(const Texture& texture)
 {
-    if (m_currentTexture == texture.id) return;
-
-    glActiveTexture(GL_TEXTURE8);
-
-    m_currentTexture = texture.id;
-
-    if (m_currentTexture == 0)
-        glBindTexture(GL_TEXTURE_2D, m_whiteTexture);
-    else
-        glBindTexture(GL_TEXTURE_2D, m_currentTexture);
+    m_texture = texture.id;
 }
 
 void CGL33UIRenderer::SetColor(const glm::vec4& color)
 {
     m_uniforms.color = color;
-    m_uniformsDirty = true;
 }
 
 void CGL33UIRenderer::SetTransparency(TransparencyMode mode)
 {
-    m_device->SetTransparency(mode);
+    m_transparency = mode;
 }
 
 Vertex2D* CGL33UIRenderer::BeginPrimitive(PrimitiveType type, int count)
@@ -168,20 +155,89 @@ Vertex2D* CGL33UIRenderer::BeginPrimitive(PrimitiveType type, int count)
 
 Vertex2D* CGL33UIRenderer::BeginPrimitives(PrimitiveType type, int drawCount, const int* counts)
 {
-    glBindVertexArray(m_bufferVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_bufferVBO);
+    GLsizei currentCount = 0;
+
+    for (int i = 0; i < drawCount; i++)
+    {
+        currentCount += counts[i];
+    }
 
-    m_currentCount = 0;
+    // Don't let buffered data grow past VBO capacity
+    if (m_vertices.size() + currentCount > m_bufferCapacity)
+        Flush();
+
+    GLsizei currentOffset = static_cast<GLsizei>(m_vertices.size());
 
     for (int i = 0; i < drawCount; i++)
     {
-        m_currentCount += counts[i];
+        m_first.push_back(currentOffset);
+        m_count.push_back(counts[i]);
+
+        currentOffset += counts[i];
     }
 
-    GLuint total = m_bufferOffset + m_currentCount;
+    m_vertices.resize(currentOffset);
+
+    m_drawing = true;
+    m_type = type;
+    m_drawCount = drawCount;
+
+    return m_vertices.data() + currentOffset - currentCount;
+}
+
+bool CGL33UIRenderer::EndPrimitive()
+{
+    if (!m_drawing) return false;
+
+    m_drawing = false;
+    m_statistics.primitives++;
 
-    // Buffer full, orphan
-    if (total >= m_bufferCapacity)
+    std::size_t begin = m_first.size() - m_drawCount;
+
+    if (!m_batches.empty() && CanMerge(m_batches.back()))
+    {
+        Batch& batch = m_batches.back();
+
+        // Lists can be drawn as one range, strips and fans need separate ranges
+        bool list = m_type == PrimitiveType::POINTS
+                 || m_type == PrimitiveType::LINES
+                 || m_type == PrimitiveType::TRIANGLES;
+
+        if (list)
+        {
+            for (std::size_t i = begin; i < m_first.size(); i++)
+                m_count[batch.end - 1] += m_count[i];
+
+            m_first.resize(begin);
+            m_count.resize(begin);
+        }
+
+        batch.end = m_first.size();
+    }
+    else
+    {
+        m_batches.push_back({ m_type, m_texture, m_transparency, m_uniforms, begin, m_first.size() });
+    }
+
+    return true;
+}
+
+void CGL33UIRenderer::Flush()
+{
+    if (m_batches.empty() || m_drawing) return;
+
+    GLsizei vertexCount = static_cast<GLsizei>(m_vertices.size());
+
+    glBindVertexArray(m_bufferVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_bufferVBO);
+
+    // Single primitive larger than buffer, grow it
+    bool grow = static_cast<GLuint>(vertexCount) > m_bufferCapacity;
+    if (grow)
+        m_bufferCapacity = vertexCount;
+
+    // Buffer grown or full, reallocate and orphan the old storage
+    if (grow || m_bufferOffset + vertexCount > static_cast<GLsizei>(m_bufferCapacity))
     {
         glBufferData(GL_ARRAY_BUFFER, m_bufferCapacity * sizeof(Vertex2D), nullptr, GL_STREAM_DRAW);
 
@@ -201,86 +257,102 @@ Vertex2D* CGL33UIRenderer::BeginPrimitives(PrimitiveType type, int drawCount, co
             reinterpret_cast<void*>(offsetof(Vertex2D, color)));
     }
 
-    m_first.resize(drawCount);
-    m_count.resize(drawCount);
-
-    GLsizei currentOffset = m_bufferOffset;
-
-    for (int i = 0; i < drawCount; i++)
-    {
-        m_first[i] = currentOffset;
-        m_count[i] = counts[i];
-
-        currentOffset += counts[i];
-    }
-
     auto ptr = glMapBufferRange(GL_ARRAY_BUFFER,
         m_bufferOffset * sizeof(Vertex2D),
-        m_currentCount * sizeof(Vertex2D),
+        vertexCount * sizeof(Vertex2D),
         GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
 
-    m_mapped = true;
-    m_type = type;
-    m_drawCount = drawCount;
-
-    // Mapping failed, use backup buffer
-    if (ptr == nullptr)
+    if (ptr != nullptr)
     {
-        m_backup = true;
-        m_buffer.resize(m_currentCount);
-
-        return m_buffer.data();
+        std::copy(m_vertices.begin(), m_vertices.end(), reinterpret_cast<Vertex2D*>(ptr));
+        glUnmapBuffer(GL_ARRAY_BUFFER);
     }
+    // Mapping failed, upload directly
     else
-    {
-        return reinterpret_cast<Vertex2D*>(ptr);
-    }
-}
-
-bool CGL33UIRenderer::EndPrimitive()
-{
-    if (!m_mapped) return false;
-
-    if (m_backup)
     {
         glBufferSubData(GL_ARRAY_BUFFER,
             m_bufferOffset * sizeof(Vertex2D),
-            m_currentCount * sizeof(Vertex2D),
-            m_buffer.data());
-    }
-    else
-    {
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+            vertexCount * sizeof(Vertex2D),
+            m_vertices.data());
     }
 
+    for (auto& first : m_first)
+        first += m_bufferOffset;
+
     glUseProgram(m_program);
 
     glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_uniformBuffer);
 
-    UpdateUniforms();
-
     m_device->SetDepthTest(false);
     m_device->SetCullFace(CullFace::NONE);
 
-    if (m_drawCount == 1)
-        glDrawArrays(TranslateGfxPrimitive(m_type), m_first.front(), m_count.front());
-    else
-        glMultiDrawArrays(TranslateGfxPrimitive(m_type), m_first.data(), m_count.data(), m_drawCount);
+    // Textures may have been rebound or deleted since the last flush
+    glActiveTexture(GL_TEXTURE8);
+    m_boundTexture = 0;
 
-    m_bufferOffset += m_currentCount;
+    for (const auto& batch : m_batches)
+    {
+        GLuint texture = batch.texture == 0 ? m_whiteTexture : batch.texture;
 
-    m_mapped = false;
-    m_backup = false;
+        if (m_boundTexture != texture)
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            m_boundTexture = texture;
+        }
 
-    return true;
+        m_device->SetTransparency(batch.transparency);
+
+        UpdateUniforms(batch.uniforms);
+
+        GLsizei drawCount = static_cast<GLsizei>(batch.end - batch.begin);
+
+        if (drawCount == 1)
+            glDrawArrays(TranslateGfxPrimitive(batch.type), m_first[batch.begin], m_count[batch.begin]);
+        else
+            glMultiDrawArrays(TranslateGfxPrimitive(batch.type), &m_first[batch.begin], &m_count[batch.begin], drawCount);
+
+        m_statistics.drawCalls++;
+    }
+
+    m_bufferOffset += vertexCount;
+
+    m_vertices.clear();
+    m_first.clear();
+    m_count.clear();
+    m_batches.clear();
 }
 
-void CGL33UIRenderer::UpdateUniforms()
+UIRendererStatistics CGL33UIRenderer::GetStatistics() const
 {
-    if (!m_uniformsDirty) return;
+    return m_statistics;
+}
+
+void CGL33UIRenderer::ResetStatistics()
+{
+    m_statistics = {};
+}
+
+bool CGL33UIRenderer::CanMerge(const Batch& batch) const
+{
+    return batch.type == m_type
+        && batch.texture == m_texture
+        && batch.transparency == m_transparency
+        && batch.uniforms.projectionMatrix == m_uniforms.projectionMatrix
+        && batch.uniforms.color == m_uniforms.color;
+}
+
+void CGL33UIRenderer::UpdateUniforms(const Uniforms& uniforms)
+{
+    if (!m_uniformsDirty
+        && m_uploadedUniforms.projectionMatrix == uniforms.projectionMatrix
+        && m_uploadedUniforms.color == uniforms.color)
+        return;
 
     glBindBuffer(GL_COPY_WRITE_BUFFER, m_uniformBuffer);
     glBufferData(GL_COPY_WRITE_BUFFER, sizeof(Uniforms), nullptr, GL_STREAM_DRAW);
-    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(Uniforms), &m_uniforms);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(Uniforms), &uniforms);
     glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_uploadedUniforms = uniforms;
+    m_uniformsDirty = false;
 }
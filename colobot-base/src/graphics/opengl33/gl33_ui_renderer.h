@@ -52,21 +52,45 @@ public:
     virtual Vertex2D* BeginPrimitives(PrimitiveType type, int drawCount, const int* counts) override;
     virtual bool EndPrimitive() override;
 
-private:
-    void UpdateUniforms();
+    virtual void Flush() override;
 
-    CGL33Device* const m_device;
+    virtual UIRendererStatistics GetStatistics() const override;
+    virtual void ResetStatistics() override;
 
+private:
     // Uniform data
     struct Uniforms
     {
         glm::mat4 projectionMatrix;
         glm::vec4 color;
     };
+
+    // Consecutive primitives drawn with the same state
+    struct Batch
+    {
+        PrimitiveType type;
+        GLuint texture;
+        TransparencyMode transparency;
+        Uniforms uniforms;
+        // Range of entries in m_first and m_count
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    bool CanMerge(const Batch& batch) const;
+    void UpdateUniforms(const Uniforms& uniforms);
+
+    CGL33Device* const m_device;
+
+    // Current state
     Uniforms m_uniforms = {};
+    GLuint m_texture = 0;
+    TransparencyMode m_transparency = {};
 
-    // true means uniforms need to be updated
-    bool m_uniformsDirty = false;
+    // Uniforms last uploaded to uniform buffer
+    Uniforms m_uploadedUniforms = {};
+    // true means uniform buffer contents are unknown
+    bool m_uniformsDirty = true;
 
     // Uniform buffer object
     GLuint m_uniformBuffer = 0;
@@ -80,23 +104,23 @@ private:
     // Buffer offset
     GLsizei m_bufferOffset = 0;
 
-    // Buffer mapping state
+    // Type of primitive being drawn
     PrimitiveType m_type = {};
-    // Number of drawn primitives
-    GLuint m_drawCount = 0;
-    // Total count of drawn vertices
-    GLuint m_currentCount = 0;
-    // Starting offset for each drawn primitive
-    std::vector<GLint> m_first;
-    // Numbers of vertices for each drawn primitive
-    std::vector<GLsizei> m_count;
+    // Number of primitives being drawn
+    int m_drawCount = 0;
     // True means currently drawing
-    bool m_mapped = false;
-    // True means mapping failed, using auxiliary buffer
-    bool m_backup = false;
+    bool m_drawing = false;
 
     // Buffered vertex data
-    std::vector<Vertex2D> m_buffer;
+    std::vector<Vertex2D> m_vertices;
+    // Starting offset for each buffered primitive
+    std::vector<GLint> m_first;
+    // Numbers of vertices for each buffered primitive
+    std::vector<GLsizei> m_count;
+    // Buffered batches
+    std::vector<Batch> m_batches;
+
+    UIRendererStatistics m_statistics;
 
     // Shader program
     GLuint m_program = 0;
@@ -104,7 +128,7 @@ private:
     // 1x1 white texture
     GLuint m_whiteTexture = 0;
     // Currently bound texture
-    GLuint m_currentTexture = 0;
+    GLuint m_boundTexture = 0;
 };
 
 }
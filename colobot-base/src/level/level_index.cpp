@@ -0,0 +1,220 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/level_index.h"
+
+#include "app/app.h"
+
+#include "common/logger.h"
+#include "common/stringutils.h"
+
+#include "common/resources/inputstream.h"
+#include "common/resources/outputstream.h"
+#include "common/resources/resourcemanager.h"
+
+#include "level/parser/parser.h"
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace LevelIndex
+{
+
+namespace
+{
+
+const std::filesystem::path INDEX_FILE = "cache/levels.txt";
+//! Increment when the format changes
+const std::string INDEX_VERSION = "LevelIndex 1";
+
+struct IndexEntry
+{
+    long long modificationTime = 0;
+    long long size = 0;
+    LevelInfo info;
+};
+
+struct Index
+{
+    bool loaded = false;
+    bool changed = false;
+    //! Entries by clean path and language
+    std::map<std::pair<std::string, char>, IndexEntry> entries;
+};
+
+Index& GetIndex()
+{
+    static Index index;
+    return index;
+}
+
+/*
+ * One entry per line, fields separated by tabs:
+ * path, language, modification time, size, created, title, resume.
+ * Level files can't contain tabs or line breaks inside strings, because the parser
+ * reads line by line and replaces tabs with spaces.
+ */
+
+void Load(Index& index)
+{
+    index.loaded = true;
+
+    CInputStream stream;
+    stream.open(INDEX_FILE);
+    if (!stream.is_open())
+        return;
+
+    std::string line;
+    if (!std::getline(stream, line) || line != INDEX_VERSION)
+        return;
+
+    while (std::getline(stream, line))
+    {
+        std::stringstream fields(line);
+        std::string path, language, modificationTime, size, created;
+        IndexEntry entry;
+        if (!std::getline(fields, path, '\t') ||
+            !std::getline(fields, language, '\t') ||
+            !std::getline(fields, modificationTime, '\t') ||
+            !std::getline(fields, size, '\t') ||
+            !std::getline(fields, created, '\t') ||
+            !std::getline(fields, entry.info.title, '\t') ||
+            language.size() != 1)
+        {
+            GetLogger()->Warn("Level index is corrupted, it will be rebuilt");
+            index.entries.clear();
+            return;
+        }
+        std::getline(fields, entry.info.resume, '\t');
+
+        try
+        {
+            entry.modificationTime = std::stoll(modificationTime);
+            entry.size = std::stoll(size);
+            entry.info.created = std::stoi(created);
+        }
+        catch (const std::exception&)
+        {
+            GetLogger()->Warn("Level index is corrupted, it will be rebuilt");
+            index.entries.clear();
+            return;
+        }
+
+        index.entries[{ path, language[0] }] = entry;
+    }
+}
+
+LevelInfo ReadLevelInfo(const std::filesystem::path& path, const std::set<std::string>& commands)
+{
+    CLevelParser levelParser(path);
+    levelParser.LoadHeader(commands);
+
+    LevelInfo info;
+    info.title = levelParser.Get("Title")->GetParam("text")->AsString();
+
+    CLevelParserLine* line = levelParser.GetIfDefined("Resume");
+    if (line != nullptr)
+        info.resume = line->GetParam("text")->AsString("");
+
+    line = levelParser.GetIfDefined("Created");
+    if (line != nullptr)
+        info.created = line->GetParam("date")->AsInt(0);
+
+    return info;
+}
+
+LevelInfo GetInfo(const std::filesystem::path& path, const std::set<std::string>& commands)
+{
+    Index& index = GetIndex();
+    if (!index.loaded)
+        Load(index);
+
+    std::pair<std::string, char> key(CResourceManager::CleanPath(path),
+                                     CApplication::GetInstancePointer()->GetLanguageChar());
+    long long modificationTime = CResourceManager::GetLastModificationTime(path);
+    long long size = CResourceManager::GetFileSize(path);
+
+    auto it = index.entries.find(key);
+    if (it != index.entries.end() && it->second.modificationTime == modificationTime && it->second.size == size)
+        return it->second.info;
+
+    // errors are not stored, so that the message is the same as when reading the file
+    IndexEntry entry;
+    entry.modificationTime = modificationTime;
+    entry.size = size;
+    entry.info = ReadLevelInfo(path, commands);
+
+    index.entries[key] = entry;
+    index.changed = true;
+    return entry.info;
+}
+
+} // namespace
+
+LevelInfo GetLevelInfo(const std::filesystem::path& path)
+{
+    return GetInfo(path, { "Title", "Resume" });
+}
+
+LevelInfo GetSavedSceneInfo(const std::filesystem::path& path)
+{
+    return GetInfo(path, { "Title", "Created" });
+}
+
+void Save()
+{
+    Index& index = GetIndex();
+    if (!index.changed)
+        return;
+
+    // forget files that were removed, like deleted savegames
+    for (auto it = index.entries.begin(); it != index.entries.end(); )
+    {
+        if (CResourceManager::Exists(StrUtils::ToPath(it->first.first)))
+            ++it;
+        else
+            it = index.entries.erase(it);
+    }
+
+    if (!CResourceManager::DirectoryExists(INDEX_FILE.parent_path()))
+        CResourceManager::CreateNewDirectory(INDEX_FILE.parent_path());
+
+    COutputStream stream;
+    stream.open(INDEX_FILE);
+    if (!stream.is_open())
+    {
+        GetLogger()->Warn("Could not write level index: %%", INDEX_FILE);
+        return;
+    }
+
+    stream << INDEX_VERSION << "\n";
+    for (const auto& [key, entry] : index.entries)
+    {
+        stream << key.first << "\t" << key.second << "\t"
+               << entry.modificationTime << "\t" << entry.size << "\t" << entry.info.created << "\t"
+               << entry.info.title << "\t" << entry.info.resume << "\n";
+    }
+    stream.close();
+
+    index.changed = false;
+}
+
+} // namespace LevelIndex
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file level/level_index.h
+ * \brief Index of titles and summaries of level and savegame files
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/**
+ * \page levelindex Level index
+ *
+ * Level lists and the savegame list only need a few lines from every file
+ * (\p Title, \p Resume and \p Created). These are kept in an index in the save directory
+ * (\p cache/levels.txt), so that the menus don't have to parse all of the files
+ * every time they are opened.
+ *
+ * Entries are keyed by the file path and the current language, and are used only
+ * while the modification time and size of the file match. Files that changed
+ * are read again with CLevelParser::LoadHeader() and their entries replaced.
+ */
+
+//! Header lines of a level or savegame file
+struct LevelInfo
+{
+    //! Text of the \p Title line
+    std::string title;
+    //! Text of the \p Resume line, empty if there is none
+    std::string resume;
+    //! Date from the \p Created line of savegames, 0 if there is none
+    int created = 0;
+};
+
+namespace LevelIndex
+{
+
+//! Returns title and summary of a level or chapter file
+/**
+ * The file is read only if the index has no valid entry for it.
+ * Throws CLevelParserException if the file can't be read or has no title.
+ */
+LevelInfo GetLevelInfo(const std::filesystem::path& path);
+//! Returns title and creation date of a savegame file, like GetLevelInfo()
+LevelInfo GetSavedSceneInfo(const std::filesystem::path& path);
+
+//! Writes the index if it changed since it was last written
+void Save();
+
+}
@@ -152,6 +152,16 @@ bool CLevelParser::Exists() const
 }
 
 void CLevelParser::Load()
+{
+    LoadLines(nullptr);
+}
+
+void CLevelParser::LoadHeader(const std::set<std::string>& commands)
+{
+    LoadLines(&commands);
+}
+
+void CLevelParser::LoadLines(const std::set<std::string>* commands)
 {
     CInputStream file;
     file.open(m_filename);
@@ -163,6 +173,7 @@ void CLevelParser::Load()
     std::string line;
     int lineNumber = 0;
     std::set<std::string> translatableLines;
+    std::set<std::string> foundCommands;
     while (getline(file, line))
     {
         lineNumber++;
@@ -188,10 +199,22 @@ void CLevelParser::Load()
         if (command.empty())
             continue;
 
+        bool translated = command.length() > 2 && command[command.length() - 2] == '.';
+        if (commands != nullptr && command[0] != '#')
+        {
+            std::string baseCommand = translated ? command.substr(0, command.length() - 2) : command;
+            if (commands->count(baseCommand) == 0)
+                continue;
+
+            // a line in the current language (or without one) is the one Get() will return
+            if (!translated || command[command.length() - 1] == lang)
+                foundCommands.insert(baseCommand);
+        }
+
         auto parserLine = std::make_unique<CLevelParserLine>(lineNumber, command);
         parserLine->SetLevel(this);
 
-        if (command.length() > 2 && command[command.length() - 2] == '.')
+        if (translated)
         {
             std::string baseCommand = command.substr(0, command.length() - 2);
             parserLine->SetCommand(baseCommand);
@@ -274,7 +297,7 @@ void CLevelParser::Load()
             if(cmd == "Include")
             {
                 std::unique_ptr<CLevelParser> includeParser = std::make_unique<CLevelParser>(parserLine->GetParam("file")->AsPath(""));
-                includeParser->Load();
+                includeParser->LoadLines(commands);
                 for(CLevelParserLineUPtr& line : includeParser->m_lines)
                 {
                     AddLine(std::move(line));
@@ -289,6 +312,9 @@ void CLevelParser::Load()
         {
             AddLine(std::move(parserLine));
         }
+
+        if (commands != nullptr && foundCommands.size() == commands->size())
+            break;
     }
 
     file.close();
@@ -32,6 +32,7 @@
 #include "level/parser/parserparam.h"
 
 #include <filesystem>
+#include <set>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -65,6 +66,12 @@ public:
     bool Exists() const;
     //! Load file
     void Load();
+    //! Load only lines with given commands
+    /**
+     * Reading stops as soon as all of them were found in the current language,
+     * so this is much faster than Load() for things like the level title.
+     */
+    void LoadHeader(const std::set<std::string>& commands);
     //! Save file
     void Save();
 
@@ -95,6 +102,9 @@ public:
     int CountLines(const std::string& command);
 
 private:
+    //! Reads the file, keeping only given commands if \a commands is not null
+    void LoadLines(const std::set<std::string>* commands);
+
     std::filesystem::path m_filename;
     std::vector<CLevelParserLineUPtr> m_lines;
 
@@ -29,6 +29,7 @@
 #include "common/resources/resourcemanager.h"
 #include "common/version.h"
 
+#include "level/level_index.h"
 #include "level/robotmain.h"
 
 #include "level/parser/parser.h"
@@ -486,14 +487,10 @@ std::vector<SavedScene> CPlayerProfile::GetSavedSceneList()
         std::filesystem::path savegameFile = GetSaveFile(dir / "data.sav");
         if (CResourceManager::Exists(savegameFile) && CResourceManager::GetFileSize(savegameFile) > 0)
         {
-            CLevelParser levelParser(savegameFile);
-            levelParser.Load();
-            CLevelParserLine* line = levelParser.GetIfDefined("Created");
-            int time = line != nullptr ? line->GetParam("date")->AsInt() : 0;
             try
             {
-                sortedSaveDirs[time] = SavedScene{ GetSaveFile(dir),
-                    levelParser.Get("Title")->GetParam("text")->AsString() };
+                LevelInfo info = LevelIndex::GetSavedSceneInfo(savegameFile);
+                sortedSaveDirs[info.created] = SavedScene{ GetSaveFile(dir), info.title };
             }
             catch (CLevelParserException &e)
             {
@@ -502,6 +499,8 @@ std::vector<SavedScene> CPlayerProfile::GetSavedSceneList()
         }
     }
 
+    LevelIndex::Save();
+
     std::vector<SavedScene> result;
     for (auto dir : sortedSaveDirs)
     {
@@ -28,6 +28,7 @@
 #include "common/config_file.h"
 #include "common/event.h"
 #include "common/logger.h"
+#include "common/profiler.h"
 #include "common/restext.h"
 #include "common/settings.h"
 #include "common/stringutils.h"
@@ -89,6 +90,7 @@
 
 #include "script/cbottoken.h"
 #include "script/script.h"
+#include "script/script_scheduler.h"
 #include "script/scriptfunc.h"
 
 #include "sound/sound.h"
@@ -135,6 +137,9 @@ const Gfx::Color COLOR_REF_ALIEN = Gfx::Color(135.0f/256.0f, 170.0f/256.0f,  13.
 const Gfx::Color COLOR_REF_GREEN = Gfx::Color(135.0f/256.0f, 170.0f/256.0f,  13.0f/256.0f);  // green
 const Gfx::Color COLOR_REF_WATER = Gfx::Color( 25.0f/256.0f, 255.0f/256.0f, 240.0f/256.0f);  // cyan
 
+//! Key of the record with static members of CBOT classes in cbot.run, object ids are never negative
+const long CBOT_STATIC_STATE_RECORD = -1;
+
 //! Constructor of robot application
 CRobotMain::CRobotMain()
 {
@@ -156,6 +161,7 @@ CRobotMain::CRobotMain()
     m_modelManager = std::make_unique<Gfx::CModelManager>();
     m_settings    = std::make_unique<CSettings>();
     m_pause       = std::make_unique<CPauseManager>();
+    m_scriptScheduler = std::make_unique<CScriptScheduler>();
     m_interface   = std::make_unique<Ui::CInterface>();
     m_terrain     = std::make_unique<Gfx::CTerrain>();
     m_camera      = std::make_unique<Gfx::CCamera>();
@@ -164,6 +170,7 @@ CRobotMain::CRobotMain()
     m_ui          = std::make_unique<Ui::CMainUserInterface>();
     m_short       = std::make_unique<Ui::CMainShort>();
     m_map         = std::make_unique<Ui::CMainMap>();
+    m_cbotSnapshot = std::make_unique<CBot::CBotSnapshot>();
 
     m_objMan = std::make_unique<CObjectManager>(
         m_engine,
@@ -312,6 +319,11 @@ CPauseManager* CRobotMain::GetPauseManager()
     return m_pause.get();
 }
 
+CScriptScheduler* CRobotMain::GetScriptScheduler()
+{
+    return m_scriptScheduler.get();
+}
+
 std::string PhaseToString(Phase phase)
 {
     if (phase == PHASE_WELCOME1) return "PHASE_WELCOME1";
@@ -1869,9 +1881,8 @@ CObject* CRobotMain::GetSelectObject()
 CObject* CRobotMain::DeselectAll()
 {
     CObject* prev = nullptr;
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (CObject* obj : m_objMan->GetObjectsImplementing(ObjectInterfaceType::Controllable))
     {
-        if (!obj->Implements(ObjectInterfaceType::Controllable)) continue;
         auto controllableObj = dynamic_cast<CControllableObject*>(obj);
         if (controllableObj->GetSelect()) prev = obj;
         controllableObj->SetSelect(false);
@@ -2002,6 +2013,8 @@ void CRobotMain::DeleteAllObjects()
         FlushShowLimit(i);
 
     m_objMan->DeleteAllObjects();
+
+    m_scriptScheduler->Reset();
 }
 
 CObject* CRobotMain::SearchHuman()
@@ -2011,9 +2024,8 @@ CObject* CRobotMain::SearchHuman()
 
 CObject* CRobotMain::GetSelect()
 {
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (CObject* obj : m_objMan->GetObjectsImplementing(ObjectInterfaceType::Controllable))
     {
-        if (!obj->Implements(ObjectInterfaceType::Controllable)) continue;
         if (dynamic_cast<CControllableObject&>(*obj).GetSelect())
             return obj;
     }
@@ -2089,9 +2101,8 @@ void CRobotMain::HiliteClear()
     int rank = -1;
     m_engine->SetHighlightRank(&rank);  // nothing more selected
 
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (CObject* obj : m_objMan->GetObjectsImplementing(ObjectInterfaceType::Controllable))
     {
-        if (!obj->Implements(ObjectInterfaceType::Controllable)) continue;
         dynamic_cast<CControllableObject&>(*obj).SetHighlight(false);
     }
     m_map->SetHighlight(nullptr);
@@ -2377,6 +2388,24 @@ void CRobotMain::InitEye()
                        glm::vec3(10.0f,  5.0f, 0.0f), 0.0f);
 }
 
+void CRobotMain::ScheduleScripts()
+{
+    m_scriptScheduler->SetTeamQuotas(GetMissionType() == MISSION_CODE_BATTLE);
+
+    for (CObject* obj : m_objMan->GetObjectsImplementing(ObjectInterfaceType::Programmable))
+    {
+        CProgrammableObject* programmable = dynamic_cast<CProgrammableObject*>(obj);
+        if (!programmable->GetActivity() || !programmable->IsProgram()) continue;
+
+        CScript* script = programmable->GetCurrentProgram()->script.get();
+        if (script->GetStepMode()) continue;
+
+        m_scriptScheduler->AddProgram(obj->GetID(), obj->GetTeam(), script->GetIpf());
+    }
+
+    m_scriptScheduler->Schedule();
+}
+
 //! Advances the entire scene
 bool CRobotMain::EventFrame(const Event &event)
 {
@@ -2404,9 +2433,16 @@ bool CRobotMain::EventFrame(const Event &event)
     CObject* toto = nullptr;
     if (!m_pause->IsPauseType(PAUSE_OBJECT_UPDATES))
     {
+        CProfilerScope objectsScope("Objects");
+
+        ScheduleScripts();
+
         // Advances all the robots, but not toto.
-        for (CObject* obj : m_objMan->GetAllObjects())
+        for (ObjectUpdateEntry entry : m_objMan->GetUpdateObjects())
         {
+            CProfilerScope objectScope("Object");
+
+            CObject* obj = entry.object;
             if (pm != nullptr)
                 pm->UpdateObject(obj);
 
@@ -2415,8 +2451,8 @@ bool CRobotMain::EventFrame(const Event &event)
 
             if (obj->GetType() == OBJECT_TOTO)
                 toto = obj;
-            else if (obj->Implements(ObjectInterfaceType::Interactive))
-                dynamic_cast<CInteractiveObject&>(*obj).EventProcess(event);
+            else if (entry.interactive != nullptr)
+                entry.interactive->EventProcess(event);
 
             if ( obj->GetProxyActivate() )  // active if it is near?
             {
@@ -2434,15 +2470,17 @@ bool CRobotMain::EventFrame(const Event &event)
             }
         }
         // Advances all objects transported by robots.
-        for (CObject* obj : m_objMan->GetAllObjects())
+        for (ObjectUpdateEntry entry : m_objMan->GetTransportedObjects())
         {
-            if (! IsObjectBeingTransported(obj))
-                continue;
+            CProfilerScope objectScope("Object");
 
-            if (obj->Implements(ObjectInterfaceType::Interactive))
-                dynamic_cast<CInteractiveObject&>(*obj).EventProcess(event);
+            if (entry.interactive != nullptr)
+                entry.interactive->EventProcess(event);
         }
 
+        m_scriptScheduler->EndFrame();
+
+        CProfilerScope pyroScope("Pyro");
         m_engine->GetPyroManager()->EventProcess(event);
     }
 
@@ -2694,11 +2732,11 @@ bool CRobotMain::EventObject(const Event &event)
 
     m_resetCreate = false;
 
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (ObjectUpdateEntry entry : m_objMan->GetUpdateObjects())
     {
-        if (obj->Implements(ObjectInterfaceType::Interactive))
+        if (entry.interactive != nullptr)
         {
-            dynamic_cast<CInteractiveObject&>(*obj).EventProcess(event);
+            entry.interactive->EventProcess(event);
         }
     }
 
@@ -4341,7 +4379,7 @@ void CRobotMain::SaveOneScript(CObject *obj)
 }
 
 //! Saves the stack of the program in execution of a robot
-bool CRobotMain::SaveFileStack(CObject *obj, std::ostream &ostr)
+bool CRobotMain::SaveFileStack(CObject *obj)
 {
     if (! obj->Implements(ObjectInterfaceType::Programmable)) return true;
 
@@ -4350,22 +4388,19 @@ bool CRobotMain::SaveFileStack(CObject *obj, std::ostream &ostr)
     ObjectType type = obj->GetType();
     if (type == OBJECT_HUMAN) return true;
 
-    long status = 1;
-    std::stringstream sstr("");
-
-    if (!programmable->WriteStack(sstr))
+    std::ostream& ostr = m_cbotSnapshot->BeginRecord(obj->GetID());
+    if (!programmable->WriteStack(ostr))
     {
         GetLogger()->Error("WriteStack failed at object id = %%", obj->GetID());
-        status = 100; // marked bad
+        m_cbotSnapshot->CancelRecord(); // the program won't be resumed
+        return true;
     }
-
-    if (!CBot::WriteLong(ostr, status)) return false;
-    if (!CBot::WriteStream(ostr, sstr)) return false;
+    m_cbotSnapshot->EndRecord();
 
     return true;
 }
 
-//! Resumes the execution stack of the program in a robot
+//! Resumes the execution stack of the program in a robot, from cbot.run files of version 1
 bool CRobotMain::ReadFileStack(CObject *obj, std::istream &istr)
 {
     if (! obj->Implements(ObjectInterfaceType::Programmable)) return true;
@@ -4421,10 +4456,8 @@ bool CRobotMain::IOIsBusy()
 {
     if (CScriptFunctions::CheckOpenFiles()) return true;
 
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (CObject* obj : m_objMan->GetObjectsImplementing(ObjectInterfaceType::TaskExecutor))
     {
-        if (! obj->Implements(ObjectInterfaceType::TaskExecutor)) continue;
-
         if (obj->Implements(ObjectInterfaceType::Programmable) && dynamic_cast<CProgrammableObject&>(*obj).IsProgram()) continue; // TODO: I'm not sure if this is correct but this is how it worked earlier
         if (dynamic_cast<CTaskExecutorObject&>(*obj).IsForegroundTask()) return true;
     }
@@ -4601,28 +4634,31 @@ bool CRobotMain::IOWriteScene(const std::filesystem::path& filename,
     COutputStream ostr(filecbot);
     if (!ostr.is_open()) return false;
 
-    bool bError = false;
-    long version = 1;
+    // version 2: one snapshot with a record for every running robot, by object id
+    long version = 2;
     CBot::WriteLong(ostr, version);                 // version of COLOBOT
-    version = CBot::CBotProgram::GetVersion();
-    CBot::WriteLong(ostr, version);                 // version of CBOT
-    CBot::WriteWord(ostr, 0); // TODO
 
+    m_cbotSnapshot->Clear();
     for (CObject* obj : m_objMan->GetAllObjects())
     {
         if (IsSkip(obj)) continue;
-
-        if (!SaveFileStack(obj, ostr))
-        {
-            GetLogger()->Error("SaveFileStack failed at object id = %%", obj->GetID());
-            bError = true;
-            break;
-        }
+        SaveFileStack(obj);
     }
 
-    if (!bError && !CBot::CBotClass::SaveStaticState(ostr))
+    std::ostream& staticState = m_cbotSnapshot->BeginRecord(CBOT_STATIC_STATE_RECORD);
+    if (CBot::CBotClass::SaveStaticState(staticState))
+    {
+        m_cbotSnapshot->EndRecord();
+    }
+    else
     {
         GetLogger()->Error("CBotClass save static state failed");
+        m_cbotSnapshot->CancelRecord();
+    }
+
+    if (!m_cbotSnapshot->Write(ostr))
+    {
+        GetLogger()->Error("Failed to write CBOT state");
     }
 
     ostr.close();
@@ -4836,7 +4872,38 @@ CObject* CRobotMain::IOReadScene(const std::filesystem::path& filename,
         bool bError = false;
         long version = 0;
         CBot::ReadLong(istr, version);             // version of COLOBOT
-        if (version == 1)
+        if (version == 2)
+        {
+            if (m_cbotSnapshot->Read(istr))
+            {
+                // stacks first, static members may point to instances they create
+                for (CObject* obj : m_objMan->GetAllObjects())
+                {
+                    if (! obj->Implements(ObjectInterfaceType::Programmable)) continue;
+
+                    CBot::CBotSnapshot::Record record = m_cbotSnapshot->GetRecord(obj->GetID());
+                    auto& programmable = dynamic_cast<CProgrammableObject&>(*obj);
+                    if (!record.IsEmpty() && !record.Read([&](std::istream& s) { return programmable.ReadStack(s); }))
+                    {
+                        GetLogger()->Error("ReadStack failed at object id = %%", obj->GetID());
+                        bError = true;
+                    }
+                }
+
+                CBot::CBotSnapshot::Record staticState = m_cbotSnapshot->GetRecord(CBOT_STATIC_STATE_RECORD);
+                if (!staticState.IsEmpty() && !staticState.Read(CBot::CBotClass::RestoreStaticState))
+                {
+                    GetLogger()->Error("CBotClass restore static state failed");
+                    bError = true;
+                }
+            }
+            else
+            {
+                GetLogger()->Error("cbot.run file has wrong format or CBOT version");
+                bError = true;
+            }
+        }
+        else if (version == 1)
         {
             CBot::ReadLong(istr, version);         // version of CBOT
             if (version == CBot::CBotProgram::GetVersion())
@@ -5296,10 +5363,9 @@ bool CRobotMain::GetRadar()
     if (m_cheatRadar)
         return true;
 
-    for (CObject* obj : m_objMan->GetAllObjects())
+    for (CObject* obj : m_objMan->GetObjectsOfType(OBJECT_RADAR))
     {
-        ObjectType type = obj->GetType();
-        if (type == OBJECT_RADAR && !obj->GetLock() && !obj->GetProxyActivate())
+        if (!obj->GetLock() && !obj->GetProxyActivate())
             return true;
     }
     return false;
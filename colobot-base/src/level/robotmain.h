@@ -98,6 +98,7 @@ class CPlayerProfile;
 class CSettings;
 class COldObject;
 class CPauseManager;
+class CScriptScheduler;
 struct ActivePause;
 
 namespace Gfx
@@ -113,6 +114,11 @@ class CTerrain;
 class CModelManager;
 }
 
+namespace CBot
+{
+class CBotSnapshot;
+}
+
 namespace Ui
 {
 class CMainUserInterface;
@@ -194,6 +200,7 @@ public:
     Ui::CInterface* GetInterface();
     Ui::CDisplayText* GetDisplayText();
     CPauseManager* GetPauseManager();
+    CScriptScheduler* GetScriptScheduler();
 
     /**
      * \name Phase management
@@ -316,7 +323,7 @@ public:
 
     void        SaveAllScript();
     void        SaveOneScript(CObject *obj);
-    bool        SaveFileStack(CObject *obj, std::ostream &ostr);
+    bool        SaveFileStack(CObject *obj);
     bool        ReadFileStack(CObject *obj, std::istream &istr);
 
     //! Return list of scripts to load to robot created in BotFactory
@@ -568,6 +575,9 @@ protected:
 
     void        UpdateDebugCrashSpheres();
 
+    //! Tells CScriptScheduler which programs want to run in this frame
+    void        ScheduleScripts();
+
     //! Adds element to the beginning of command history
     void        PushToCommandHistory(std::string cmd);
     //! Returns next/previous element from command history and updates index
@@ -592,6 +602,7 @@ protected:
     std::unique_ptr<CObjectManager> m_objMan;
     std::unique_ptr<CMainMovie> m_movie;
     std::unique_ptr<CPauseManager> m_pause;
+    std::unique_ptr<CScriptScheduler> m_scriptScheduler;
     std::unique_ptr<Gfx::CModelManager> m_modelManager;
     std::unique_ptr<Gfx::CTerrain> m_terrain;
     std::unique_ptr<Gfx::CCamera> m_camera;
@@ -607,6 +618,9 @@ protected:
     //! Progress of loaded player
     std::unique_ptr<CPlayerProfile> m_playerProfile;
 
+    //! Execution stacks of programs, reused between saves, see IOWriteScene()
+    std::unique_ptr<CBot::CBotSnapshot> m_cbotSnapshot;
+
 
     //! Time since level start, including pause and intro movie
     float           m_time = 0.0f;
@@ -32,6 +32,7 @@
 
 #include "common/stringutils.h"
 
+#include <cmath>
 #include <limits>
 
 
@@ -55,27 +56,8 @@ bool CObjectCondition::CheckForObject(CObject* obj)
         if (IsObjectBeingTransported(obj)) return false;
     }
 
-    ObjectType type = obj->GetType();
-
-    ToolType tool = GetToolFromObject(type);
-    DriveType drive = GetDriveFromObject(type);
-    if (this->tool != ToolType::Other &&
-        tool != this->tool)
-        return false;
-
-    if (this->drive != DriveType::Other &&
-        drive != this->drive)
-        return false;
-
-    if (this->tool == ToolType::Other &&
-        this->drive == DriveType::Other &&
-        type != this->type &&
-        this->type != OBJECT_NULL)
-        return false;
-
-    if ((this->team > 0 && obj->GetTeam() != this->team) ||
-        (this->team < 0 && (obj->GetTeam() == -(this->team) || obj->GetTeam() == 0)))
-        return false;
+    if (!CheckType(obj->GetType())) return false;
+    if (!CheckTeam(obj->GetTeam())) return false;
 
     float energyLevel = -1;
     CPowerContainerObject* power = nullptr;
@@ -111,14 +93,73 @@ bool CObjectCondition::CheckForObject(CObject* obj)
     return false;
 }
 
+bool CObjectCondition::CheckType(ObjectType type)
+{
+    ToolType tool = GetToolFromObject(type);
+    DriveType drive = GetDriveFromObject(type);
+    if (this->tool != ToolType::Other &&
+        tool != this->tool)
+        return false;
+
+    if (this->drive != DriveType::Other &&
+        drive != this->drive)
+        return false;
+
+    if (this->tool == ToolType::Other &&
+        this->drive == DriveType::Other &&
+        type != this->type &&
+        this->type != OBJECT_NULL)
+        return false;
+
+    return true;
+}
+
+bool CObjectCondition::CheckTeam(int team)
+{
+    if ((this->team > 0 && team != this->team) ||
+        (this->team < 0 && (team == -(this->team) || team == 0)))
+        return false;
+
+    return true;
+}
+
 int CObjectCondition::CountObjects()
 {
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+
+    // Without position and energy filters the result depends only on type, team
+    // and transport state, which the object manager keeps counts of
+    bool anyPosition = std::isinf(this->dist);
+    bool anyEnergy = this->powermin <= -1.0f && this->powermax >= 100.0f;
+
+    std::vector<ObjectType> types;
+    if (this->tool == ToolType::Other && this->drive == DriveType::Other && this->type != OBJECT_NULL)
+        types.push_back(this->type);
+    else
+        types = objectManager->GetExistingObjectTypes();
+
     int nb = 0;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (ObjectType type : types)
     {
-        if (!obj->GetActive()) continue;
-        if (!CheckForObject(obj)) continue;
-        nb ++;
+        if (!CheckType(type)) continue;
+
+        if (anyPosition && anyEnergy)
+        {
+            for (const auto& [team, count] : objectManager->GetObjectCounts(type))
+            {
+                if (!CheckTeam(team)) continue;
+                nb += count.active;
+                if (!this->countTransported) nb -= count.transported;
+            }
+            continue;
+        }
+
+        for (CObject* obj : objectManager->GetObjectsOfType(type))
+        {
+            if (!obj->GetActive()) continue;
+            if (!CheckForObject(obj)) continue;
+            nb ++;
+        }
     }
     return nb;
 }
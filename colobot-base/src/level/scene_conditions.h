@@ -63,6 +63,12 @@ public:
 
     //! Count all object matching the conditions
     int CountObjects();
+
+private:
+    //! Checks if objects of given type can match the condition
+    bool CheckType(ObjectType type);
+    //! Checks if objects of given team can match the condition
+    bool CheckTeam(int team);
 };
 
 /**
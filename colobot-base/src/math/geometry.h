@@ -593,6 +593,63 @@ inline bool IntersectY(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &
     return true;
 }
 
+//! Intersects the ray \a origin + t * \a dir with triangle abc (both faces)
+/** Returns true and the ray parameter in \a t if there is a hit with t in [tMin, tMax]. */
+inline bool IntersectRayTriangle(const glm::vec3 &origin, const glm::vec3 &dir,
+                                 const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c,
+                                 float tMin, float tMax, float &t)
+{
+    glm::vec3 edge1 = b - a;
+    glm::vec3 edge2 = c - a;
+    glm::vec3 p = glm::cross(dir, edge2);
+    float det = glm::dot(edge1, p);
+    if (det == 0.0f)
+        return false;
+
+    float invDet = 1.0f / det;
+    glm::vec3 s = origin - a;
+    float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    glm::vec3 q = glm::cross(s, edge1);
+    float v = glm::dot(dir, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    float hit = glm::dot(edge2, q) * invDet;
+    if (hit < tMin || hit > tMax)
+        return false;
+
+    t = hit;
+    return true;
+}
+
+//! Clips the ray \a origin + t * \a invDir^-1 to box [\a min, \a max]
+/**
+ * \a invDir is the reciprocal of the ray direction. On success, [tMin, tMax] is narrowed
+ * to the part of the ray inside the box.
+ */
+inline bool IntersectRayBox(const glm::vec3 &origin, const glm::vec3 &invDir,
+                            const glm::vec3 &min, const glm::vec3 &max,
+                            float &tMin, float &tMax)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        float t1 = (min[i] - origin[i]) * invDir[i];
+        float t2 = (max[i] - origin[i]) * invDir[i];
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        // NaN from 0 * inf (ray in the slab plane) leaves the limits unchanged
+        if (t1 > tMin) tMin = t1;
+        if (t2 < tMax) tMax = t2;
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
 //! Calculates the end point
 inline glm::vec3 LookatPoint(const glm::vec3 &eye, float angleH, float angleV, float length)
 {
@@ -399,10 +399,8 @@ CObject* CAutoConvert::SearchStone(ObjectType type)
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfType(type))
     {
-        ObjectType oType = obj->GetType();
-        if ( oType != type )  continue;
         if (IsObjectBeingTransported(obj)) continue;
 
         glm::vec3 oPos = obj->GetPosition();
@@ -281,10 +281,9 @@ CObject* CAutoDestroyer::SearchPlastic()
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Destroyable))
     {
         if (obj == m_object) continue;
-        if (!obj->Implements(ObjectInterfaceType::Destroyable)) continue;
         if (obj->GetType() == OBJECT_HUMAN || obj->GetType() == OBJECT_TECH) continue;
 
         glm::vec3 oPos = obj->GetPosition();
@@ -292,16 +292,10 @@ CObject* CAutoEgg::SearchAlien()
     glm::vec3 cPos = m_object->GetPosition();
     float min = 100000.0f;
     CObject* best = nullptr;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_ANT, OBJECT_BEE, OBJECT_SPIDER, OBJECT_WORM}))
     {
         if (IsObjectBeingTransported(obj))  continue;
 
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_ANT    &&
-             type != OBJECT_BEE    &&
-             type != OBJECT_SPIDER &&
-             type != OBJECT_WORM   )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         float dist = Math::DistanceProjected(oPos, cPos);
         if ( dist < 8.0f && dist < min )
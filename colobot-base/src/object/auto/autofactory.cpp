@@ -562,10 +562,8 @@ bool CAutoFactory::Read(CLevelParserLine* line)
 
 CObject* CAutoFactory::SearchCargo()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfType(OBJECT_METAL))
     {
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_METAL )  continue;
         if (IsObjectBeingTransported(obj))  continue;
 
         glm::vec3 oPos = obj->GetPosition();
@@ -583,49 +581,10 @@ bool CAutoFactory::NearestVehicle()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    std::vector<CObject*> objects = CObjectManager::GetInstancePointer()->GetObjectsOfTypes(
+        {OBJECT_HUMAN}, {ROBOT_OBJECT_TYPES, ALIEN_OBJECT_TYPES});
+    for (CObject* obj : objects)
     {
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_HUMAN    &&
-             type != OBJECT_MOBILEfa &&
-             type != OBJECT_MOBILEta &&
-             type != OBJECT_MOBILEwa &&
-             type != OBJECT_MOBILEia &&
-             type != OBJECT_MOBILEfb &&
-             type != OBJECT_MOBILEtb &&
-             type != OBJECT_MOBILEwb &&
-             type != OBJECT_MOBILEib &&
-             type != OBJECT_MOBILEfc &&
-             type != OBJECT_MOBILEtc &&
-             type != OBJECT_MOBILEwc &&
-             type != OBJECT_MOBILEic &&
-             type != OBJECT_MOBILEfi &&
-             type != OBJECT_MOBILEti &&
-             type != OBJECT_MOBILEwi &&
-             type != OBJECT_MOBILEii &&
-             type != OBJECT_MOBILEfs &&
-             type != OBJECT_MOBILEts &&
-             type != OBJECT_MOBILEws &&
-             type != OBJECT_MOBILEis &&
-             type != OBJECT_MOBILErt &&
-             type != OBJECT_MOBILErc &&
-             type != OBJECT_MOBILErr &&
-             type != OBJECT_MOBILErs &&
-             type != OBJECT_MOBILEsa &&
-             type != OBJECT_MOBILEtg &&
-             type != OBJECT_MOBILEft &&
-             type != OBJECT_MOBILEtt &&
-             type != OBJECT_MOBILEwt &&
-             type != OBJECT_MOBILEit &&
-             type != OBJECT_MOBILErp &&
-             type != OBJECT_MOBILEst &&
-             type != OBJECT_MOBILEdr &&
-             type != OBJECT_MOTHER   &&
-             type != OBJECT_ANT      &&
-             type != OBJECT_SPIDER   &&
-             type != OBJECT_BEE      &&
-             type != OBJECT_WORM     )  continue;
-
         if (obj->GetCrashSphereCount() == 0) continue;
 
         auto crashSphere = obj->GetFirstCrashSphere();
@@ -691,12 +650,9 @@ bool CAutoFactory::CreateVehicle()
 
 CObject* CAutoFactory::SearchVehicle()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfType(m_type))
     {
         if ( !obj->GetLock() )  continue;
-
-        ObjectType  type = obj->GetType();
-        if ( type != m_type )  continue;
         if (IsObjectBeingTransported(obj))  continue;
 
         glm::vec3 oPos = obj->GetPosition();
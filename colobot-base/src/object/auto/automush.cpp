@@ -229,60 +229,15 @@ bool CAutoMush::SearchTarget()
 {
     glm::vec3 iPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    std::vector<CObject*> objects = CObjectManager::GetInstancePointer()->GetObjectsOfTypes({
+        OBJECT_DERRICK,   OBJECT_STATION,   OBJECT_FACTORY,   OBJECT_REPAIR,    OBJECT_DESTROYER,
+        OBJECT_CONVERT,   OBJECT_TOWER,     OBJECT_RESEARCH,  OBJECT_RADAR,     OBJECT_INFO,
+        OBJECT_ENERGY,    OBJECT_LABO,      OBJECT_NUCLEAR,   OBJECT_PARA,      OBJECT_HUMAN
+    }, {ROBOT_OBJECT_TYPES});
+    for (CObject* obj : objects)
     {
         if ( obj->GetLock() )  continue;
 
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_MOBILEfa &&
-             type != OBJECT_MOBILEta &&
-             type != OBJECT_MOBILEwa &&
-             type != OBJECT_MOBILEia &&
-             type != OBJECT_MOBILEfb &&
-             type != OBJECT_MOBILEtb &&
-             type != OBJECT_MOBILEwb &&
-             type != OBJECT_MOBILEib &&
-             type != OBJECT_MOBILEfc &&
-             type != OBJECT_MOBILEtc &&
-             type != OBJECT_MOBILEwc &&
-             type != OBJECT_MOBILEic &&
-             type != OBJECT_MOBILEfi &&
-             type != OBJECT_MOBILEti &&
-             type != OBJECT_MOBILEwi &&
-             type != OBJECT_MOBILEii &&
-             type != OBJECT_MOBILEfs &&
-             type != OBJECT_MOBILEts &&
-             type != OBJECT_MOBILEws &&
-             type != OBJECT_MOBILEis &&
-             type != OBJECT_MOBILErt &&
-             type != OBJECT_MOBILErc &&
-             type != OBJECT_MOBILErr &&
-             type != OBJECT_MOBILErs &&
-             type != OBJECT_MOBILEsa &&
-             type != OBJECT_MOBILEtg &&
-             type != OBJECT_MOBILEft &&
-             type != OBJECT_MOBILEtt &&
-             type != OBJECT_MOBILEwt &&
-             type != OBJECT_MOBILEit &&
-             type != OBJECT_MOBILErp &&
-             type != OBJECT_MOBILEst &&
-             type != OBJECT_MOBILEdr &&
-             type != OBJECT_DERRICK  &&
-             type != OBJECT_STATION  &&
-             type != OBJECT_FACTORY  &&
-             type != OBJECT_REPAIR   &&
-             type != OBJECT_DESTROYER&&
-             type != OBJECT_CONVERT  &&
-             type != OBJECT_TOWER    &&
-             type != OBJECT_RESEARCH &&
-             type != OBJECT_RADAR    &&
-             type != OBJECT_INFO     &&
-             type != OBJECT_ENERGY   &&
-             type != OBJECT_LABO     &&
-             type != OBJECT_NUCLEAR  &&
-             type != OBJECT_PARA     &&
-             type != OBJECT_HUMAN    )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         float dist = glm::distance(oPos, iPos);
         if ( dist < 50.0f )  return true;
@@ -178,13 +178,10 @@ void CAutoNest::CreateCargo(glm::vec3 pos, float angle, ObjectType type)
 
 CObject* CAutoNest::SearchCargo()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfType(OBJECT_BULLET))
     {
         if ( !obj->GetLock() )  continue;
 
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_BULLET )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         if ( oPos.x == m_cargoPos.x &&
              oPos.z == m_cargoPos.z )
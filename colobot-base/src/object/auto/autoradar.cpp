@@ -273,17 +273,10 @@ bool CAutoRadar::SearchEnemy(glm::vec3 &pos)
     m_totalDetect = 0;
 
     CObject* best = nullptr;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_ANT, OBJECT_SPIDER, OBJECT_BEE, OBJECT_WORM, OBJECT_MOTHER}))
     {
         if ( !obj->GetDetectable() )  continue;
 
-        ObjectType oType = obj->GetType();
-        if ( oType != OBJECT_ANT    &&
-             oType != OBJECT_SPIDER &&
-             oType != OBJECT_BEE    &&
-             oType != OBJECT_WORM   &&
-             oType != OBJECT_MOTHER )  continue;
-
         m_totalDetect ++;
 
         glm::vec3 oPos = obj->GetPosition();
@@ -241,10 +241,9 @@ CObject* CAutoRepair::SearchVehicle()
 {
     glm::vec3 sPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Shielded))
     {
         if (obj == m_object) continue;
-        if ( !obj->Implements(ObjectInterfaceType::Shielded) ) continue;
         if ( !dynamic_cast<CShieldedObject&>(*obj).IsRepairable() )  continue;
 
         if ( obj->Implements(ObjectInterfaceType::Movable) && !dynamic_cast<CMovableObject&>(*obj).GetPhysics()->GetLand() )  continue;  // in flight?
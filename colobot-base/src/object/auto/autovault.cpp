@@ -406,15 +406,11 @@ int CAutoVault::CountKeys()
         m_keyPos[index] = cPos;
     }
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_KEYa, OBJECT_KEYb, OBJECT_KEYc, OBJECT_KEYd}))
     {
         if (IsObjectBeingTransported(obj))  continue;
 
-        ObjectType  oType = obj->GetType();
-        if ( oType != OBJECT_KEYa &&
-             oType != OBJECT_KEYb &&
-             oType != OBJECT_KEYc &&
-             oType != OBJECT_KEYd )  continue;
+        ObjectType oType = obj->GetType();
 
         glm::vec3 oPos = obj->GetPosition();
         float dist = Math::DistanceProjected(oPos, cPos);
@@ -477,16 +473,10 @@ void CAutoVault::LockKeys()
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_KEYa, OBJECT_KEYb, OBJECT_KEYc, OBJECT_KEYd}))
     {
-        ObjectType oType = obj->GetType();
         if (IsObjectBeingTransported(obj))  continue;
 
-        if ( oType != OBJECT_KEYa &&
-             oType != OBJECT_KEYb &&
-             oType != OBJECT_KEYc &&
-             oType != OBJECT_KEYd )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         float dist = Math::DistanceProjected(oPos, cPos);
         if ( dist > 20.0f )  continue;
@@ -501,16 +491,10 @@ void CAutoVault::DownKeys(float progress)
 {
     glm::vec3 cPos = m_object->GetPosition();
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_KEYa, OBJECT_KEYb, OBJECT_KEYc, OBJECT_KEYd}))
     {
-        ObjectType oType = obj->GetType();
         if (IsObjectBeingTransported(obj))  continue;
 
-        if ( oType != OBJECT_KEYa &&
-             oType != OBJECT_KEYb &&
-             oType != OBJECT_KEYc &&
-             oType != OBJECT_KEYd )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         float dist = Math::DistanceProjected(oPos, cPos);
         if ( dist > 20.0f )  continue;
@@ -530,16 +514,10 @@ void CAutoVault::DeleteKeys()
     do
     {
         haveDeleted = false;
-        for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+        for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsOfTypes({OBJECT_KEYa, OBJECT_KEYb, OBJECT_KEYc, OBJECT_KEYd}))
         {
-            ObjectType oType = obj->GetType();
             if (IsObjectBeingTransported(obj))  continue;
 
-            if ( oType != OBJECT_KEYa &&
-                 oType != OBJECT_KEYb &&
-                 oType != OBJECT_KEYc &&
-                 oType != OBJECT_KEYd )  continue;
-
             glm::vec3 oPos = obj->GetPosition();
             float dist = Math::DistanceProjected(oPos, cPos);
             if ( dist > 20.0f )  continue;
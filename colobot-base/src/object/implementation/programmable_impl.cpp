@@ -40,6 +40,7 @@
 #include "physics/physics.h"
 
 #include "script/script.h"
+#include "script/script_scheduler.h"
 
 #include "ui/controls/edit.h"
 
@@ -78,7 +79,7 @@ bool CProgrammableObjectImpl::EventProcess(const Event &event)
             CProfiler::StartPerformanceCounter(PCNT_UPDATE_CBOT);
             if ( IsProgram() )  // current program?
             {
-                if ( m_currentProgram->script->Continue() )
+                if ( ContinueProgram() )
                 {
                     StopProgram();
                 }
@@ -96,6 +97,23 @@ bool CProgrammableObjectImpl::EventProcess(const Event &event)
 }
 
 
+bool CProgrammableObjectImpl::ContinueProgram()
+{
+    CScript* script = m_currentProgram->script.get();
+    if ( script->GetStepMode() )
+    {
+        return script->Continue(0);
+    }
+
+    CScriptScheduler* scheduler = CRobotMain::GetInstancePointer()->GetScriptScheduler();
+    int ipf = scheduler->StartSlice(m_object->GetID(), script->GetIpf());
+    if ( ipf < 0 )  return false;  // waits for a later frame
+
+    bool finished = script->Continue(ipf);
+    scheduler->EndSlice(script->GetExecutedInstructions());
+    return finished;
+}
+
 void CProgrammableObjectImpl::SetActivity(bool activity)
 {
     m_activity = activity;
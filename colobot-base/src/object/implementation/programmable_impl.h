@@ -72,6 +72,9 @@ public:
     std::vector<float>& GetCmdLine();
 
 private:
+    //! Runs the current program for a slice given by CScriptScheduler, returns true when it finished
+    bool        ContinueProgram();
+
     //! Save current status to recording buffer
     void        TraceRecordFrame();
     //! Save this operation to recording buffer
@@ -537,7 +537,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(6, rank);
         m_object->SetObjectParent(6, 0);
-        modelManager->AddModelCopy("lem2t", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("lem2t", false, rank, m_object->GetTeam());
         if (m_object->GetTrainer() || type == OBJECT_MOBILEtt)
         {
             m_object->SetPartPosition(6, glm::vec3(0.0f, 2.0f, -3.55f));
@@ -551,7 +551,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(7, rank);
         m_object->SetObjectParent(7, 0);
-        modelManager->AddModelCopy("lem3t", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("lem3t", false, rank, m_object->GetTeam());
         if (m_object->GetTrainer() || type == OBJECT_MOBILEtt)
         {
             m_object->SetPartPosition(7, glm::vec3(0.0f, 2.0f, 3.55f));
@@ -572,7 +572,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(6, rank);
         m_object->SetObjectParent(6, 0);
-        modelManager->AddModelCopy("roller2", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("roller2", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(6, glm::vec3(0.0f, 2.0f, -3.0f));
 
         // Creates the left caterpillar.
@@ -580,7 +580,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(7, rank);
         m_object->SetObjectParent(7, 0);
-        modelManager->AddModelCopy("roller3", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("roller3", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(7, glm::vec3(0.0f, 2.0f, 3.0f));
     }
 
@@ -592,7 +592,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(6, rank);
         m_object->SetObjectParent(6, 0);
-        modelManager->AddModelCopy("subm4", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("subm4", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(6, glm::vec3(0.0f, 1.0f, -3.0f));
 
         // Creates the left caterpillar.
@@ -600,7 +600,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(7, rank);
         m_object->SetObjectParent(7, 0);
-        modelManager->AddModelCopy("subm5", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("subm5", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(7, glm::vec3(0.0f, 1.0f, 3.0f));
     }
 
@@ -611,7 +611,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(6, rank);
         m_object->SetObjectParent(6, 0);
-        modelManager->AddModelCopy("drawer2", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("drawer2", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(6, glm::vec3(0.0f, 1.0f, -3.0f));
 
         // Creates the left caterpillar.
@@ -619,7 +619,7 @@ void CMotionVehicle::Create(glm::vec3 pos, float angle, ObjectType type,
         m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_DESCENDANT);
         m_object->SetObjectRank(7, rank);
         m_object->SetObjectParent(7, 0);
-        modelManager->AddModelCopy("drawer3", false, rank, m_object->GetTeam());
+        modelManager->AddModelReference("drawer3", false, rank, m_object->GetTeam());
         m_object->SetPartPosition(7, glm::vec3(0.0f, 1.0f, 3.0f));
     }
 
@@ -32,6 +32,8 @@
 
 #include "math/const.h"
 
+#include "object/object_manager.h"
+
 #include "script/scriptfunc.h"
 
 #include <stdexcept>
@@ -89,29 +91,42 @@ void CObject::SetCrashSpheres(const std::vector<Gfx::ModelCrashSphere>& crashSph
 void CObject::AddCrashSphere(const CrashSphere& crashSphere)
 {
     m_crashSpheres.push_back(crashSphere);
+    InvalidateCrashSpheres();
 }
 
 CrashSphere CObject::GetFirstCrashSphere()
 {
     assert(m_crashSpheres.size() >= 1);
 
-    CrashSphere transformedFirstCrashSphere = m_crashSpheres[0];
-    TransformCrashSphere(transformedFirstCrashSphere.sphere);
-    return transformedFirstCrashSphere;
+    return GetAllCrashSpheres()[0];
 }
 
-std::vector<CrashSphere> CObject::GetAllCrashSpheres()
+std::span<const CrashSphere> CObject::GetAllCrashSpheres()
 {
-    std::vector<CrashSphere> allCrashSpheres;
+    UpdateWorldTransform();
 
-    for (const auto& crashSphere : m_crashSpheres)
+    if (!m_worldCrashSpheresValid)
     {
-        CrashSphere transformedCrashSphere = crashSphere;
-        TransformCrashSphere(transformedCrashSphere.sphere);
-        allCrashSpheres.push_back(transformedCrashSphere);
+        m_worldCrashSpheres = m_crashSpheres;
+        for (auto& crashSphere : m_worldCrashSpheres)
+        {
+            TransformCrashSphere(crashSphere.sphere);
+        }
+        m_worldCrashSpheresValid = true;
     }
 
-    return allCrashSpheres;
+    return m_worldCrashSpheres;
+}
+
+void CObject::InvalidateCrashSpheres()
+{
+    m_worldCrashSpheresValid = false;
+}
+
+void CObject::UpdateObjectIndex()
+{
+    if (CObjectManager::IsCreated())
+        CObjectManager::GetInstancePointer()->UpdateObjectIndex(this);
 }
 
 bool CObject::CanCollideWith(CObject* other)
@@ -272,6 +287,7 @@ int CObject::GetCrashSphereCount()
 void CObject::DeleteAllCrashSpheres()
 {
     m_crashSpheres.clear();
+    InvalidateCrashSpheres();
 }
 
 void CObject::SetCameraCollisionSphere(const Math::Sphere& sphere)
@@ -309,6 +325,7 @@ bool CObject::GetCollisions()
 void CObject::SetTeam(int team)
 {
     m_team = team;
+    UpdateObjectIndex();
 }
 
 int CObject::GetTeam()
@@ -359,6 +376,7 @@ std::string CObject::GetTooltipText()
 void CObject::SetLock(bool lock)
 {
     m_lock = lock;
+    UpdateObjectIndex();
 }
 
 bool CObject::GetLock() const
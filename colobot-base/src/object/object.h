@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <optional>
+#include <span>
 
 namespace Gfx
 {
@@ -155,8 +156,10 @@ public:
     /** Crash sphere position is returned in world coordinates */
     CrashSphere GetFirstCrashSphere();
     //! Returns all crash spheres
-    /** Crash sphere position is returned in world coordinates */
-    std::vector<CrashSphere> GetAllCrashSpheres();
+    /** Crash sphere position is returned in world coordinates.
+     *  Spheres are transformed once and cached until the object moves, the returned span
+     *  is valid until then or until crash spheres of the object change. */
+    std::span<const CrashSphere> GetAllCrashSpheres();
     //! Removes all crash spheres
     void DeleteAllCrashSpheres();
     //! Returns true if this object can collide with the other one
@@ -228,6 +231,13 @@ public:
 protected:
     //! Transform crash sphere by object's world matrix
     virtual void TransformCrashSphere(Math::Sphere& crashSphere) = 0;
+    //! Applies pending changes of position, rotation and scale to object's world matrix
+    /** Called before cached crash spheres are used, see InvalidateCrashSpheres() */
+    virtual void UpdateWorldTransform() {}
+    //! Marks cached world coordinates of crash spheres as outdated, called when object's world matrix changes
+    void InvalidateCrashSpheres();
+    //! Tells object manager that type, team or active state of the object changed, see CObjectManager::UpdateObjectIndex()
+    void UpdateObjectIndex();
     //! Transform crash sphere by object's world matrix
     virtual void TransformCameraCollisionSphere(Math::Sphere& collisionSphere) = 0;
 
@@ -240,6 +250,8 @@ protected:
     glm::vec3 m_scale;
     std::optional<glm::vec3> m_scaleOverride;
     std::vector<CrashSphere> m_crashSpheres; //!< crash spheres
+    std::vector<CrashSphere> m_worldCrashSpheres; //!< crash spheres in world coordinates, see GetAllCrashSpheres()
+    bool m_worldCrashSpheresValid = false;
     Math::Sphere m_cameraCollisionSphere;
     bool m_animateOnReset;
     bool m_collisions;
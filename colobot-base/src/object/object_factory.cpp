@@ -370,14 +370,7 @@ CObjectUPtr CObjectFactory::CreateResource(const ObjectCreateParams& params)
     if ( type == OBJECT_MARKKEYd    )  name = "crossd";
     if ( type == OBJECT_EGG         )  name = "egg";
 
-    if (type == OBJECT_POWER || type == OBJECT_ATOMIC)
-    {
-        m_oldModelManager->AddModelCopy(name, false, rank, obj->GetTeam());
-    }
-    else
-    {
-        m_oldModelManager->AddModelReference(name, false, rank, obj->GetTeam());
-    }
+    m_oldModelManager->AddModelReference(name, false, rank, obj->GetTeam());
 
     obj->SetPosition(pos);
     obj->SetRotationY(angle);
@@ -31,6 +31,8 @@
 
 #include "object/auto/auto.h"
 
+#include "object/interface/transportable_object.h"
+
 #include "physics/physics.h"
 
 #include <algorithm>
@@ -64,6 +66,8 @@ bool CObjectManager::DeleteObject(CObject* instance)
     if (oldObj != nullptr)
         oldObj->DeleteObject();
 
+    RemoveFromObjectIndex(instance);
+
     auto it = m_objects.find(instance->GetID());
     if (it != m_objects.end())
     {
@@ -106,6 +110,13 @@ void CObjectManager::DeleteAllObjects()
         }
     }
 
+    m_objectsByType.clear();
+    for (auto& objects : m_objectsByInterface)
+        objects.clear();
+    m_objectCounts.clear();
+    m_objectIndex.clear();
+    m_updateObjects.Clear();
+    m_transportedObjects.Clear();
     m_objects.clear();
 
     m_nextId = 0;
@@ -154,6 +165,8 @@ CObject* CObjectManager::CreateObject(ObjectCreateParams params)
 
     m_objects[params.id] = std::move(objectUPtr);
 
+    AddToObjectIndex(objectPtr);
+
     return objectPtr;
 }
 
@@ -227,15 +240,173 @@ void CObjectManager::DestroyTeam(int team, DestructionType destructionType)
     }
 }
 
-int CObjectManager::CountObjectsImplementing(ObjectInterfaceType interface)
+namespace
 {
-    int count = 0;
-    for (CObject* object : GetAllObjects())
+
+void InsertById(std::vector<CObject*>& list, CObject* object)
+{
+    auto it = std::upper_bound(list.begin(), list.end(), object, [](CObject* a, CObject* b)
+    {
+        return a->GetID() < b->GetID();
+    });
+    list.insert(it, object);
+}
+
+void Remove(std::vector<CObject*>& list, CObject* object)
+{
+    auto it = std::find(list.begin(), list.end(), object);
+    if (it != list.end())
+        list.erase(it);
+}
+
+} // namespace
+
+void CObjectManager::AddToObjectIndex(CObject* object)
+{
+    for (int i = 0; i < static_cast<int>(ObjectInterfaceType::Max); ++i)
+    {
+        if (object->Implements(static_cast<ObjectInterfaceType>(i)))
+            InsertById(m_objectsByInterface[i], object);
+    }
+
+    ObjectIndexEntry& entry = m_objectIndex[object];
+    entry.type = object->GetType();
+    InsertById(m_objectsByType[entry.type], object);
+    m_updateObjects.Add(object);
+    UpdateObjectIndex(object);
+}
+
+void CObjectManager::UpdateObjectIndex(CObject* object)
+{
+    auto it = m_objectIndex.find(object);
+    if (it == m_objectIndex.end())
+        return;
+
+    ObjectIndexEntry& entry = it->second;
+    ObjectIndexEntry current;
+    current.type = object->GetType();
+    current.team = object->GetTeam();
+    current.active = object->GetActive();
+    current.transported = IsObjectBeingTransported(object);
+
+    if (current.type != entry.type)
+    {
+        Remove(m_objectsByType[entry.type], object);
+        InsertById(m_objectsByType[current.type], object);
+    }
+
+    if (current.transported != entry.transported)
+    {
+        if (current.transported)
+            m_transportedObjects.Add(object);
+        else
+            m_transportedObjects.Remove(object);
+    }
+
+    if (entry.active)
+    {
+        ObjectCount& count = m_objectCounts[entry.type][entry.team];
+        count.active--;
+        if (entry.transported) count.transported--;
+    }
+    if (current.active)
+    {
+        ObjectCount& count = m_objectCounts[current.type][current.team];
+        count.active++;
+        if (current.transported) count.transported++;
+    }
+
+    entry = current;
+}
+
+void CObjectManager::RemoveFromObjectIndex(CObject* object)
+{
+    auto it = m_objectIndex.find(object);
+    if (it == m_objectIndex.end())
+        return;
+
+    for (int i = 0; i < static_cast<int>(ObjectInterfaceType::Max); ++i)
+    {
+        if (object->Implements(static_cast<ObjectInterfaceType>(i)))
+            Remove(m_objectsByInterface[i], object);
+    }
+
+    const ObjectIndexEntry& entry = it->second;
+    Remove(m_objectsByType[entry.type], object);
+    m_updateObjects.Remove(object);
+    if (entry.transported)
+        m_transportedObjects.Remove(object);
+    if (entry.active)
+    {
+        ObjectCount& count = m_objectCounts[entry.type][entry.team];
+        count.active--;
+        if (entry.transported) count.transported--;
+    }
+
+    m_objectIndex.erase(it);
+}
+
+const std::vector<CObject*>& CObjectManager::GetObjectsOfType(ObjectType type)
+{
+    return m_objectsByType[type];
+}
+
+std::vector<CObject*> CObjectManager::GetObjectsOfTypes(std::initializer_list<ObjectType> types,
+                                                        std::initializer_list<std::span<const ObjectType>> typeGroups)
+{
+    std::vector<CObject*> result;
+    std::size_t typeCount = types.size();
+    auto addType = [&](ObjectType type)
+    {
+        const auto& objects = m_objectsByType[type];
+        result.insert(result.end(), objects.begin(), objects.end());
+    };
+    for (ObjectType type : types)
     {
-        if (object->Implements(interface))
-            count++;
+        addType(type);
     }
-    return count;
+    for (const auto& group : typeGroups)
+    {
+        for (ObjectType type : group)
+        {
+            addType(type);
+        }
+        typeCount += group.size();
+    }
+    if (typeCount > 1)
+    {
+        std::sort(result.begin(), result.end(), [](CObject* a, CObject* b)
+        {
+            return a->GetID() < b->GetID();
+        });
+    }
+    return result;
+}
+
+const std::vector<CObject*>& CObjectManager::GetObjectsImplementing(ObjectInterfaceType interface)
+{
+    return m_objectsByInterface[static_cast<int>(interface)];
+}
+
+const std::map<int, CObjectManager::ObjectCount>& CObjectManager::GetObjectCounts(ObjectType type)
+{
+    return m_objectCounts[type];
+}
+
+std::vector<ObjectType> CObjectManager::GetExistingObjectTypes()
+{
+    std::vector<ObjectType> types;
+    for (const auto& [type, objects] : m_objectsByType)
+    {
+        if (!objects.empty())
+            types.push_back(type);
+    }
+    return types;
+}
+
+int CObjectManager::CountObjectsImplementing(ObjectInterfaceType interface)
+{
+    return GetObjectsImplementing(interface).size();
 }
 
 std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, ObjectType type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
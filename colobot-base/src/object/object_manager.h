@@ -31,14 +31,18 @@
 #include "object/object_create_params.h"
 #include "object/object_interface_type.h"
 #include "object/object_type.h"
+#include "object/object_update_list.h"
 
 #include "object/interface/destroyable_object.h"
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <initializer_list>
 #include <map>
 #include <vector>
 #include <memory>
+#include <span>
 
 namespace Gfx
 {
@@ -64,6 +68,22 @@ enum RadarFilter
     FILTER_NEUTRAL     = 1 << (8+4),
 };
 
+//! Types of all robots, for use with CObjectManager::GetObjectsOfTypes()
+inline constexpr ObjectType ROBOT_OBJECT_TYPES[] = {
+    OBJECT_MOBILEfa, OBJECT_MOBILEta, OBJECT_MOBILEwa, OBJECT_MOBILEia, OBJECT_MOBILEfb,
+    OBJECT_MOBILEtb, OBJECT_MOBILEwb, OBJECT_MOBILEib, OBJECT_MOBILEfc, OBJECT_MOBILEtc,
+    OBJECT_MOBILEwc, OBJECT_MOBILEic, OBJECT_MOBILEfi, OBJECT_MOBILEti, OBJECT_MOBILEwi,
+    OBJECT_MOBILEii, OBJECT_MOBILEfs, OBJECT_MOBILEts, OBJECT_MOBILEws, OBJECT_MOBILEis,
+    OBJECT_MOBILErt, OBJECT_MOBILErc, OBJECT_MOBILErr, OBJECT_MOBILErs, OBJECT_MOBILEsa,
+    OBJECT_MOBILEtg, OBJECT_MOBILEft, OBJECT_MOBILEtt, OBJECT_MOBILEwt, OBJECT_MOBILEit,
+    OBJECT_MOBILErp, OBJECT_MOBILEst, OBJECT_MOBILEdr
+};
+
+//! Types of all aliens, for use with CObjectManager::GetObjectsOfTypes()
+inline constexpr ObjectType ALIEN_OBJECT_TYPES[] = {
+    OBJECT_MOTHER, OBJECT_ANT, OBJECT_SPIDER, OBJECT_BEE, OBJECT_WORM
+};
+
 using CObjectMap = std::map<int, std::unique_ptr<CObject>>;
 using CObjectMapCIt = std::map<int, std::unique_ptr<CObject>>::const_iterator;
 
@@ -183,6 +203,45 @@ public:
     //! Counts all objects implementing given interface
     int CountObjectsImplementing(ObjectInterfaceType interface);
 
+    //! Number of active objects of one type and team, see UpdateObjectIndex()
+    struct ObjectCount
+    {
+        //! All active objects
+        int active = 0;
+        //! Active objects being carried by another object
+        int transported = 0;
+    };
+
+    //! Updates the object in the type/team index
+    /**
+     * Has to be called whenever anything that affects the index changes:
+     * type, team, transporter or any state checked by CObject::GetActive().
+     * Objects which are not created through CObjectManager are ignored.
+     */
+    void      UpdateObjectIndex(CObject* object);
+
+    //! Returns all objects of given type, active or not, ordered by id
+    /**
+     * The list is updated immediately when objects are created, deleted or change type,
+     * so callers which may do so while iterating should use GetObjectsOfTypes() instead.
+     */
+    const std::vector<CObject*>& GetObjectsOfType(ObjectType type);
+    //! Returns a copy of the list of all objects of any of given types, ordered by id
+    /**
+     * Groups of types used in many places, like ROBOT_OBJECT_TYPES, can be passed in \a typeGroups
+     */
+    std::vector<CObject*> GetObjectsOfTypes(std::initializer_list<ObjectType> types,
+                                            std::initializer_list<std::span<const ObjectType>> typeGroups = {});
+    //! Returns all objects implementing given interface, ordered by id
+    /**
+     * Same as for GetObjectsOfType(), creating or deleting objects changes the list.
+     */
+    const std::vector<CObject*>& GetObjectsImplementing(ObjectInterfaceType interface);
+    //! Returns counts of active objects of given type, by team
+    const std::map<int, ObjectCount>& GetObjectCounts(ObjectType type);
+    //! Returns all types which have at least one object
+    std::vector<ObjectType> GetExistingObjectTypes();
+
     //! Returns all objects
     CObjectContainerProxy GetAllObjects()
     {
@@ -190,6 +249,17 @@ public:
         return CObjectContainerProxy(m_objects, m_activeObjectIterators);
     }
 
+    //! Returns all objects with their interactive interface, for updating them every frame
+    CObjectUpdateList::Proxy GetUpdateObjects()
+    {
+        return m_updateObjects.GetObjects();
+    }
+    //! Returns all objects being carried by other objects
+    CObjectUpdateList::Proxy GetTransportedObjects()
+    {
+        return m_transportedObjects.GetObjects();
+    }
+
     //! Finds an object, like radar() in CBot
     //@{
     std::vector<CObject*> RadarAll(CObject* pThis,
@@ -302,9 +372,29 @@ private:
     //! Prevents creation of overcharged power cells
     float ClampPower(ObjectType type, float power);
     void CleanRemovedObjectsIfNeeded();
+    void AddToObjectIndex(CObject* object);
+    void RemoveFromObjectIndex(CObject* object);
 
 private:
+    //! State in which an object was last added to the index
+    struct ObjectIndexEntry
+    {
+        ObjectType type = OBJECT_NULL;
+        int team = 0;
+        bool active = false;
+        bool transported = false;
+    };
+
     CObjectMap m_objects;
+    //! Objects by type
+    std::map<ObjectType, std::vector<CObject*>> m_objectsByType;
+    //! Objects by implemented interface
+    std::array<std::vector<CObject*>, static_cast<std::size_t>(ObjectInterfaceType::Max)> m_objectsByInterface;
+    //! Counts of active objects by type and team
+    std::map<ObjectType, std::map<int, ObjectCount>> m_objectCounts;
+    std::map<CObject*, ObjectIndexEntry> m_objectIndex;
+    CObjectUpdateList m_updateObjects;
+    CObjectUpdateList m_transportedObjects;
     std::unique_ptr<CObjectFactory> m_objectFactory;
     int m_nextId;
     int m_activeObjectIterators;
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_part.h"
+
+#include <array>
+
+void ComputePartUpdateOrder(const ObjectPart* parts, int totalPart, std::vector<int>& order)
+{
+    order.clear();
+    if (totalPart <= 0 || !parts[0].bUsed) return;
+
+    // children of each part, in order of their numbers
+    std::array<int, OBJECTMAXPART> firstChild, nextSibling, lastChild;
+    firstChild.fill(-1);
+    nextSibling.fill(-1);
+    lastChild.fill(-1);
+    for (int i = 0; i < totalPart; i++)
+    {
+        int parent = parts[i].parentPart;
+        if (!parts[i].bUsed || parent < 0 || parent >= totalPart || parent == i) continue;
+
+        if (lastChild[parent] == -1)
+            firstChild[parent] = i;
+        else
+            nextSibling[lastChild[parent]] = i;
+        lastChild[parent] = i;
+    }
+
+    // depth first walk from part 0
+    std::array<int, OBJECTMAXPARTDEPTH + 1> stack;
+    int depth = 0;
+    stack[0] = 0;
+    order.push_back(0);
+    while (depth >= 0)
+    {
+        int part = stack[depth];
+        int child = (depth < OBJECTMAXPARTDEPTH) ? firstChild[part] : -1;
+        if (child != -1)
+        {
+            stack[++depth] = child;
+            order.push_back(child);
+            continue;
+        }
+
+        // no more children, go to the next sibling of this part or of its ancestors
+        while (depth > 0)
+        {
+            int sibling = nextSibling[stack[depth]];
+            if (sibling != -1)
+            {
+                stack[depth] = sibling;
+                order.push_back(sibling);
+                break;
+            }
+            depth--;
+        }
+        if (depth == 0) break;
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/object_part.h
+ * \brief ObjectPart - movable part of an object, and the order of updating their transforms
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// The father of all parts must always be the part number zero!
+const int OBJECTMAXPART         = 40;
+
+//! Number of levels of parts below part 0 whose transforms are updated
+const int OBJECTMAXPARTDEPTH    = 4;
+
+struct ObjectPart
+{
+    bool         bUsed = false;
+    int          object = -1;         // number of the object in CEngine
+    int          parentPart = -1;     // number of father part
+    int          masterParti = -1;        // master canal of the particle
+    glm::vec3    position = { 0, 0, 0 };
+    glm::vec3    angle = { 0, 0, 0 };
+    glm::vec3    zoom = { 0, 0, 0 };
+    bool         bTranslate = false;
+    bool         bRotate = false;
+    bool         bZoom = false;
+    glm::mat4    matTranslate;
+    glm::mat4    matRotate;
+    glm::mat4    matTransform;
+    glm::mat4    matWorld;
+};
+
+/**
+ * \brief Computes the order in which transforms of parts are updated
+ *
+ * The order contains part 0 and its descendants up to OBJECTMAXPARTDEPTH levels below it,
+ * depth first with children in order of their numbers, so that every part comes after its parent.
+ * Updating matrices in this order is then a single linear pass.
+ *
+ * \param parts Array of parts
+ * \param totalPart Number of parts to consider
+ * \param[out] order Part numbers
+ */
+void ComputePartUpdateOrder(const ObjectPart* parts, int totalPart, std::vector<int>& order);
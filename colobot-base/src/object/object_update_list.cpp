@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_update_list.h"
+
+#include "object/object.h"
+
+#include "object/interface/interactive_object.h"
+
+#include <algorithm>
+
+namespace
+{
+
+bool CompareById(const ObjectUpdateEntry& a, const ObjectUpdateEntry& b)
+{
+    return a.object->GetID() < b.object->GetID();
+}
+
+} // namespace
+
+void CObjectUpdateList::Add(CObject* object)
+{
+    ObjectUpdateEntry entry;
+    entry.object = object;
+    if (object->Implements(ObjectInterfaceType::Interactive))
+        entry.interactive = dynamic_cast<CInteractiveObject*>(object);
+
+    // New objects usually have the highest id
+    bool inOrder = m_entries.empty() || m_entries.back().object == nullptr || CompareById(m_entries.back(), entry);
+    if (inOrder || m_activeIterations > 0)
+    {
+        m_entries.push_back(entry);
+        if (!inOrder)
+            m_needsCompact = true;
+        return;
+    }
+
+    Compact();
+    m_entries.insert(std::upper_bound(m_entries.begin(), m_entries.end(), entry, CompareById), entry);
+}
+
+void CObjectUpdateList::Remove(CObject* object)
+{
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [object](const ObjectUpdateEntry& entry)
+    {
+        return entry.object == object;
+    });
+    if (it == m_entries.end())
+        return;
+
+    if (m_activeIterations > 0)
+    {
+        it->object = nullptr;
+        it->interactive = nullptr;
+        m_needsCompact = true;
+        return;
+    }
+
+    m_entries.erase(it);
+}
+
+void CObjectUpdateList::Clear()
+{
+    if (m_activeIterations > 0)
+    {
+        for (auto& entry : m_entries)
+            entry = ObjectUpdateEntry{};
+        m_needsCompact = true;
+        return;
+    }
+
+    m_entries.clear();
+    m_needsCompact = false;
+}
+
+void CObjectUpdateList::EndIteration()
+{
+    --m_activeIterations;
+    if (m_activeIterations == 0)
+        Compact();
+}
+
+void CObjectUpdateList::Compact()
+{
+    if (!m_needsCompact)
+        return;
+
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const ObjectUpdateEntry& entry)
+    {
+        return entry.object == nullptr;
+    }), m_entries.end());
+    std::stable_sort(m_entries.begin(), m_entries.end(), CompareById);
+    m_needsCompact = false;
+}
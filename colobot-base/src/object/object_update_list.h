@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/object_update_list.h
+ * \brief CObjectUpdateList class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class CObject;
+class CInteractiveObject;
+
+/**
+ * \struct ObjectUpdateEntry
+ * \brief Object together with its already resolved CInteractiveObject interface
+ */
+struct ObjectUpdateEntry
+{
+    CObject* object = nullptr;
+    //! Interactive interface of the object, nullptr if it doesn't implement it
+    CInteractiveObject* interactive = nullptr;
+};
+
+/**
+ * \class CObjectUpdateList
+ * \brief Dense list of objects ordered by id, iterated every frame
+ *
+ * Objects can be added and removed while the list is being iterated:
+ * removed objects leave empty entries until no iteration is in progress,
+ * and objects added during iteration are visited by the same loop,
+ * same as with CObjectManager::GetAllObjects().
+ */
+class CObjectUpdateList
+{
+public:
+    class Iterator
+    {
+    public:
+        ObjectUpdateEntry operator*() const
+        {
+            return (*m_entries)[m_index];
+        }
+
+        void operator++()
+        {
+            ++m_index;
+            SkipEmpty();
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            // end() is only known when comparing, as the list may grow during iteration
+            return m_index >= other.m_entries->size();
+        }
+
+    private:
+        friend class CObjectUpdateList;
+
+        Iterator(const std::vector<ObjectUpdateEntry>* entries, std::size_t index)
+         : m_entries(entries), m_index(index)
+        {
+            SkipEmpty();
+        }
+
+        void SkipEmpty()
+        {
+            while (m_index < m_entries->size() && (*m_entries)[m_index].object == nullptr)
+                ++m_index;
+        }
+
+        const std::vector<ObjectUpdateEntry>* m_entries;
+        std::size_t m_index;
+    };
+
+    class Proxy
+    {
+    public:
+        Proxy(const Proxy&) = delete;
+        ~Proxy()
+        {
+            m_list.EndIteration();
+        }
+
+        Iterator begin() const { return Iterator(&m_list.m_entries, 0); }
+        Iterator end() const { return Iterator(&m_list.m_entries, m_list.m_entries.size()); }
+
+    private:
+        friend class CObjectUpdateList;
+
+        explicit Proxy(CObjectUpdateList& list)
+         : m_list(list)
+        {
+            ++m_list.m_activeIterations;
+        }
+
+        CObjectUpdateList& m_list;
+    };
+
+    //! Adds object to the list, keeping the order by id
+    void Add(CObject* object);
+    //! Removes object from the list
+    void Remove(CObject* object);
+    //! Removes all objects
+    void Clear();
+
+    //! Returns all objects in the list; they may be added and removed while iterating
+    Proxy GetObjects()
+    {
+        return Proxy(*this);
+    }
+
+private:
+    void EndIteration();
+    void Compact();
+
+    std::vector<ObjectUpdateEntry> m_entries;
+    int m_activeIterations = 0;
+    //! Entries contain removed objects or are out of order
+    bool m_needsCompact = false;
+};
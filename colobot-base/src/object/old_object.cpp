@@ -23,6 +23,7 @@
 #include "app/app.h"
 
 #include "common/global.h"
+#include "common/profiler.h"
 #include "common/settings.h"
 #include "common/stringutils.h"
 
@@ -65,6 +66,7 @@
 
 #include "ui/controls/edit.h"
 
+#include <array>
 #include <iomanip>
 
 
@@ -160,6 +162,8 @@ COldObject::COldObject(int id)
         m_objectPart[i].bUsed = false;
     }
     m_totalPart = 0;
+    m_partOrderDirty = true;
+    m_mainPartPending = false;
 
     for (int i=0 ; i<4 ; i++ )
     {
@@ -237,6 +241,7 @@ void COldObject::DeleteObject(bool bAll)
     }
 
     m_type = OBJECT_NULL;  // invalid object until complete destruction
+    UpdateObjectIndex();
 
     if ( m_shadowLight != -1 )
     {
@@ -606,6 +611,7 @@ void COldObject::DestroyObject(DestructionType type, CObject* killer)
         scoreboard->ProcessKill(this, killer);
 
     m_team = 0; // Back to neutral on destruction
+    UpdateObjectIndex();
 
     if ( m_botVar != nullptr )
     {
@@ -644,6 +650,8 @@ void COldObject::InitPart(int part)
     m_objectPart[part].matWorld = glm::mat4(1.0f);
 
     m_objectPart[part].masterParti = -1;
+
+    m_partOrderDirty = true;
 }
 
 // Removes part.
@@ -661,6 +669,7 @@ void COldObject::DeletePart(int part)
     m_objectPart[part].bUsed = false;
     m_engine->DeleteObject(m_objectPart[part].object);
     UpdateTotalPart();
+    m_partOrderDirty = true;
 }
 
 void COldObject::UpdateTotalPart()
@@ -705,6 +714,7 @@ int COldObject::GetObjectRank(int part)
 void COldObject::SetObjectParent(int part, int parent)
 {
     m_objectPart[part].parentPart = parent;
+    m_partOrderDirty = true;
 }
 
 
@@ -714,6 +724,7 @@ void COldObject::SetType(ObjectType type)
 {
     m_type = type;
     m_name = GetObjectName(m_type);
+    UpdateObjectIndex();
 
     SetSelectable(IsSelectableByDefault(m_type));
 
@@ -1306,24 +1317,6 @@ void COldObject::Read(CLevelParserLine* line)
 
 
 
-// Seeking the nth son of a father.
-
-int COldObject::SearchDescendant(int parent, int n)
-{
-    int     i;
-
-    for ( i=0 ; i<m_totalPart ; i++ )
-    {
-        if ( !m_objectPart[i].bUsed )  continue;
-
-        if ( parent == m_objectPart[i].parentPart )
-        {
-            if ( n-- == 0 )  return i;
-        }
-    }
-    return -1;
-}
-
 void COldObject::TransformCrashSphere(Math::Sphere& crashSphere)
 {
     if(!Implements(ObjectInterfaceType::Jostleable)) crashSphere.radius *= GetScaleX();
@@ -1341,15 +1334,25 @@ void COldObject::TransformCrashSphere(Math::Sphere& crashSphere)
         return;
     }
 
-    if (m_objectPart[0].bTranslate ||
-        m_objectPart[0].bRotate)
-    {
-        UpdateTransformObject();
-    }
+    UpdateWorldTransform();
 
     crashSphere.pos = Math::Transform(m_objectPart[0].matWorld, crashSphere.pos);
 }
 
+// Updates only the world matrix of the main part, which is all crash spheres need.
+// Its sons and the matrices in the engine are updated by UpdateTransformObject(),
+// once per frame. Transported objects follow their transporter, so they are left to it too.
+
+void COldObject::UpdateWorldTransform()
+{
+    if ( m_transporter != nullptr )  return;
+
+    if ( UpdateTransformObject(0, false) )
+    {
+        m_mainPartPending = true;
+    }
+}
+
 void COldObject::TransformCameraCollisionSphere(Math::Sphere& collisionSphere)
 {
     collisionSphere.pos = Math::Transform(m_objectPart[0].matWorld, collisionSphere.pos);
@@ -1831,6 +1834,7 @@ void COldObject::SetPowerPosition(const glm::vec3& powerPosition)
 void COldObject::SetTransporter(CObject* transporter)
 {
     m_transporter = transporter;
+    UpdateObjectIndex();
 
     // Invisible shadow if the object is transported.
     m_engine->SetObjectShadowSpotHide(m_objectPart[0].object, (m_transporter != nullptr));
@@ -1859,7 +1863,8 @@ glm::mat4 COldObject::GetRotateMatrix(int part)
 glm::mat4 COldObject::GetWorldMatrix(int part)
 {
     if ( m_objectPart[0].bTranslate ||
-         m_objectPart[0].bRotate    )
+         m_objectPart[0].bRotate    ||
+         m_mainPartPending          )
     {
         UpdateTransformObject();
     }
@@ -1945,7 +1950,7 @@ bool COldObject::CreateShadowCircle(float radius, float intensity,
 }
 
 // Calculates the matrix for transforming the object.
-// Returns true if the matrix has changed.
+// Returns true if the matrix has changed, the caller passes it to the engine.
 // The rotations occur in the order Y, Z and X.
 
 bool COldObject::UpdateTransformObject(int part, bool bForceUpdate)
@@ -2029,10 +2034,9 @@ bool COldObject::UpdateTransformObject(int part, bool bForceUpdate)
         bModif = true;
     }
 
-    if ( bModif )
+    if ( part == 0 && bModif )
     {
-        m_engine->SetObjectTransform(m_objectPart[part].object,
-                                     m_objectPart[part].matWorld);
+        InvalidateCrashSpheres();
     }
 
     m_objectPart[part].bTranslate = false;
@@ -2041,65 +2045,58 @@ bool COldObject::UpdateTransformObject(int part, bool bForceUpdate)
     return bModif;
 }
 
-// Updates all matrices to transform the object father and all his sons.
-// Assume a maximum of 4 degrees of freedom.
-// Appropriate, for example, to a body, an arm, forearm, hand and fingers.
+// Updates all matrices to transform the object father and all his sons,
+// in one pass over parts sorted so that fathers come before their sons.
+// Changed matrices are passed to the engine at once.
 
 bool COldObject::UpdateTransformObject()
 {
-    bool    bUpdate1, bUpdate2, bUpdate3, bUpdate4;
-    int     level1, level2, level3, level4, rank;
-    int     parent1, parent2, parent3, parent4;
+    std::array<int, OBJECTMAXPART> ranks;
+    std::array<glm::mat4, OBJECTMAXPART> transforms;
+    std::array<bool, OBJECTMAXPART> updated;
+    int count = 0;
+
+    auto update = [&](int part, bool bForceUpdate)
+    {
+        updated[part] = UpdateTransformObject(part, bForceUpdate);
+        if ( part == 0 && m_mainPartPending )
+        {
+            updated[part] = true;
+            m_mainPartPending = false;
+        }
+        if ( updated[part] )
+        {
+            ranks[count] = m_objectPart[part].object;
+            transforms[count] = m_objectPart[part].matWorld;
+            count++;
+        }
+    };
 
     if ( m_bFlat )
     {
-        for ( level1=0 ; level1<m_totalPart ; level1++ )
+        for ( int i=0 ; i<m_totalPart ; i++ )
         {
-            if ( !m_objectPart[level1].bUsed )  continue;
-            UpdateTransformObject(level1, false);
+            if ( !m_objectPart[i].bUsed )  continue;
+            update(i, false);
         }
     }
     else
     {
-        parent1 = 0;
-        bUpdate1 = UpdateTransformObject(parent1, false);
-
-        for ( level1=0 ; level1<m_totalPart ; level1++ )
+        if ( m_partOrderDirty )
         {
-            rank = SearchDescendant(parent1, level1);
-            if ( rank == -1 )  break;
-
-            parent2 = rank;
-            bUpdate2 = UpdateTransformObject(rank, bUpdate1);
-
-            for ( level2=0 ; level2<m_totalPart ; level2++ )
-            {
-                rank = SearchDescendant(parent2, level2);
-                if ( rank == -1 )  break;
-
-                parent3 = rank;
-                bUpdate3 = UpdateTransformObject(rank, bUpdate2);
-
-                for ( level3=0 ; level3<m_totalPart ; level3++ )
-                {
-                    rank = SearchDescendant(parent3, level3);
-                    if ( rank == -1 )  break;
-
-                    parent4 = rank;
-                    bUpdate4 = UpdateTransformObject(rank, bUpdate3);
-
-                    for ( level4=0 ; level4<m_totalPart ; level4++ )
-                    {
-                        rank = SearchDescendant(parent4, level4);
-                        if ( rank == -1 )  break;
+            ComputePartUpdateOrder(m_objectPart, m_totalPart, m_partOrder);
+            m_partOrderDirty = false;
+        }
 
-                        UpdateTransformObject(rank, bUpdate4);
-                    }
-                }
-            }
+        for ( int part : m_partOrder )
+        {
+            int parent = m_objectPart[part].parentPart;
+            update(part, part != 0 && updated[parent]);
         }
     }
 
+    m_engine->SetObjectTransforms({ranks.data(), static_cast<std::size_t>(count)},
+                                  {transforms.data(), static_cast<std::size_t>(count)});
     return true;
 }
 
@@ -2129,6 +2126,9 @@ void COldObject::FlatParent()
     }
 
     m_bFlat = true;
+    m_partOrderDirty = true;
+    InvalidateCrashSpheres();
+    UpdateObjectIndex();
 }
 
 
@@ -2295,6 +2295,7 @@ bool COldObject::EventProcess(const Event &event)
     {
         if (!GetLock())
         {
+            CProfilerScope scope("Auto");
             m_auto->EventProcess(event);
         }
 
@@ -2308,6 +2309,7 @@ bool COldObject::EventProcess(const Event &event)
 
     if ( m_motion != nullptr )
     {
+        CProfilerScope scope("Motion");
         if (!m_motion->EventProcess(event)) return false;
     }
 
@@ -2879,6 +2881,7 @@ void COldObject::SetDying(DeathType deathType)
 {
     m_dying = deathType;
     m_burnTime = 0.0f;
+    UpdateObjectIndex();
 
     if ( IsDying() && Implements(ObjectInterfaceType::Programmable) )
     {
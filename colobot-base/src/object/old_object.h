@@ -27,6 +27,7 @@
 #include "common/event.h"
 
 #include "object/object.h"
+#include "object/object_part.h"
 
 #include "object/implementation/power_container_impl.h"
 #include "object/implementation/program_storage_impl.h"
@@ -48,27 +49,6 @@
 #include "object/interface/trace_drawing_object.h"
 #include "object/interface/transportable_object.h"
 
-// The father of all parts must always be the part number zero!
-const int OBJECTMAXPART         = 40;
-
-struct ObjectPart
-{
-    bool         bUsed = false;
-    int          object = -1;         // number of the object in CEngine
-    int          parentPart = -1;     // number of father part
-    int          masterParti = -1;        // master canal of the particle
-    glm::vec3    position = { 0, 0, 0 };
-    glm::vec3    angle = { 0, 0, 0 };
-    glm::vec3    zoom = { 0, 0, 0 };
-    bool         bTranslate = false;
-    bool         bRotate = false;
-    bool         bZoom = false;
-    glm::mat4    matTranslate;
-    glm::mat4    matRotate;
-    glm::mat4    matTransform;
-    glm::mat4    matWorld;
-};
-
 namespace Ui
 {
 class CObjectInterface;
@@ -309,12 +289,12 @@ protected:
     void        PartiFrame(float rTime);
     void        InitPart(int part);
     void        UpdateTotalPart();
-    int         SearchDescendant(int parent, int n);
     void        UpdateEnergyMapping();
     bool        UpdateTransformObject(int part, bool bForceUpdate);
     bool        UpdateTransformObject();
     void        UpdateSelectParticle();
     void        TransformCrashSphere(Math::Sphere &crashSphere) override;
+    void        UpdateWorldTransform() override;
     void TransformCameraCollisionSphere(Math::Sphere& collisionSphere) override;
 
     /**
@@ -386,6 +366,12 @@ protected:
 
     int         m_totalPart;
     ObjectPart  m_objectPart[OBJECTMAXPART];
+    //! Order of updating part transforms, see ComputePartUpdateOrder()
+    std::vector<int> m_partOrder;
+    //! Part hierarchy changed since m_partOrder was computed
+    bool        m_partOrderDirty;
+    //! Main part's world matrix was updated by UpdateWorldTransform(), but its sons and the engine weren't
+    bool        m_mainPartPending;
 
     int         m_partiSel[4];
 
@@ -340,7 +340,7 @@ std::unique_ptr<CBaseBuilding> CBaseBuilding::Create(
 
     if ( params.type == OBJECT_ENERGY )
     {
-        modelManager->AddModelCopy("energy", false, rank, params.team);
+        modelManager->AddModelReference("energy", false, rank, params.team);
         obj->SetPosition(params.pos);
         obj->SetRotationY(params.angle);
         obj->SetFloorHeight(0.0f);
@@ -523,7 +523,7 @@ std::unique_ptr<CBaseBuilding> CBaseBuilding::Create(
 
     if ( params.type == OBJECT_STATION )
     {
-        modelManager->AddModelCopy("station", false, rank, params.team);
+        modelManager->AddModelReference("station", false, rank, params.team);
         obj->SetPosition(params.pos);
         obj->SetRotationY(params.angle);
         obj->SetFloorHeight(0.0f);
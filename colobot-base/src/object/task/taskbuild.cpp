@@ -959,17 +959,12 @@ void CTaskBuild::DeleteMark(glm::vec3 pos, float radius)
 {
     std::vector<CObject*> objectsToDelete;
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    std::vector<CObject*> objects = CObjectManager::GetInstancePointer()->GetObjectsOfTypes({
+        OBJECT_MARKSTONE,   OBJECT_MARKURANIUM, OBJECT_MARKKEYa,    OBJECT_MARKKEYb,    OBJECT_MARKKEYc,
+        OBJECT_MARKKEYd,    OBJECT_MARKPOWER
+    });
+    for (CObject* obj : objects)
     {
-        ObjectType type = obj->GetType();
-        if ( type != OBJECT_MARKSTONE   &&
-             type != OBJECT_MARKURANIUM &&
-             type != OBJECT_MARKKEYa    &&
-             type != OBJECT_MARKKEYb    &&
-             type != OBJECT_MARKKEYc    &&
-             type != OBJECT_MARKKEYd    &&
-             type != OBJECT_MARKPOWER   )  continue;
-
         glm::vec3 oPos = obj->GetPosition();
         float distance = glm::distance(oPos, pos);
         if ( distance <= radius )
@@ -212,26 +212,12 @@ CObject* CTaskFlag::SearchNearest(glm::vec3 pos, ObjectType type)
 
 int CTaskFlag::CountObject(ObjectType type)
 {
-    int count = 0;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    if ( type == OBJECT_NULL )
     {
-        ObjectType  oType = obj->GetType();
-        if ( type == OBJECT_NULL )
-        {
-            if ( oType != OBJECT_FLAGb &&
-                 oType != OBJECT_FLAGr &&
-                 oType != OBJECT_FLAGg &&
-                 oType != OBJECT_FLAGy &&
-                 oType != OBJECT_FLAGv )  continue;
-        }
-        else
-        {
-            if ( oType != type )  continue;
-        }
-
-        count ++;
+        return objectManager->GetObjectsOfTypes({OBJECT_FLAGb, OBJECT_FLAGr, OBJECT_FLAGg, OBJECT_FLAGy, OBJECT_FLAGv}).size();
     }
-    return count;
+    return objectManager->GetObjectsOfType(type).size();
 }
 
 // Creates a color indicator.
@@ -543,59 +543,14 @@ CObject* CTaskGoto::WormSearch(glm::vec3 &impact)
     float min = 1000000.0f;
 
     CObject* best = nullptr;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    std::vector<CObject*> objects = CObjectManager::GetInstancePointer()->GetObjectsOfTypes({
+        OBJECT_DERRICK,   OBJECT_STATION,   OBJECT_FACTORY,   OBJECT_REPAIR,    OBJECT_DESTROYER,
+        OBJECT_CONVERT,   OBJECT_TOWER,     OBJECT_RESEARCH,  OBJECT_RADAR,     OBJECT_INFO,
+        OBJECT_ENERGY,    OBJECT_LABO,      OBJECT_NUCLEAR,   OBJECT_PARA,      OBJECT_SAFE,
+        OBJECT_HUSTON
+    }, {ROBOT_OBJECT_TYPES});
+    for (CObject* obj : objects)
     {
-        ObjectType oType = obj->GetType();
-        if ( oType != OBJECT_MOBILEfa &&
-             oType != OBJECT_MOBILEta &&
-             oType != OBJECT_MOBILEwa &&
-             oType != OBJECT_MOBILEia &&
-             oType != OBJECT_MOBILEfb &&
-             oType != OBJECT_MOBILEtb &&
-             oType != OBJECT_MOBILEwb &&
-             oType != OBJECT_MOBILEib &&
-             oType != OBJECT_MOBILEfc &&
-             oType != OBJECT_MOBILEtc &&
-             oType != OBJECT_MOBILEwc &&
-             oType != OBJECT_MOBILEic &&
-             oType != OBJECT_MOBILEfi &&
-             oType != OBJECT_MOBILEti &&
-             oType != OBJECT_MOBILEwi &&
-             oType != OBJECT_MOBILEii &&
-             oType != OBJECT_MOBILEfs &&
-             oType != OBJECT_MOBILEts &&
-             oType != OBJECT_MOBILEws &&
-             oType != OBJECT_MOBILEis &&
-             oType != OBJECT_MOBILErt &&
-             oType != OBJECT_MOBILErc &&
-             oType != OBJECT_MOBILErr &&
-             oType != OBJECT_MOBILErs &&
-             oType != OBJECT_MOBILEsa &&
-             oType != OBJECT_MOBILEtg &&
-             oType != OBJECT_MOBILEft &&
-             oType != OBJECT_MOBILEtt &&
-             oType != OBJECT_MOBILEwt &&
-             oType != OBJECT_MOBILEit &&
-             oType != OBJECT_MOBILErp &&
-             oType != OBJECT_MOBILEst &&
-             oType != OBJECT_MOBILEdr &&
-             oType != OBJECT_DERRICK  &&
-             oType != OBJECT_STATION  &&
-             oType != OBJECT_FACTORY  &&
-             oType != OBJECT_REPAIR   &&
-             oType != OBJECT_DESTROYER &&
-             oType != OBJECT_CONVERT  &&
-             oType != OBJECT_TOWER    &&
-             oType != OBJECT_RESEARCH &&
-             oType != OBJECT_RADAR    &&
-             oType != OBJECT_INFO     &&
-             oType != OBJECT_ENERGY   &&
-             oType != OBJECT_LABO     &&
-             oType != OBJECT_NUCLEAR  &&
-             oType != OBJECT_PARA     &&
-             oType != OBJECT_SAFE     &&
-             oType != OBJECT_HUSTON   )  continue;
-
         if ( obj->GetVirusMode() )  continue;  // object infected?
 
         if (obj->GetCrashSphereCount() == 0) continue;
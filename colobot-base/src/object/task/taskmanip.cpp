@@ -707,10 +707,8 @@ CObject* CTaskManip::SearchTakeUnderObject(glm::vec3 &pos, float dLimit)
 
     min = 1000000.0f;
     pBest = nullptr;
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Transportable))
     {
-        if ( !pObj->Implements(ObjectInterfaceType::Transportable) )  continue;
-
         if (IsObjectBeingTransported(pObj))  continue;
         if ( pObj->GetLock() )  continue;
         if ( pObj->GetScaleY() != 1.0f )  continue;
@@ -759,10 +757,8 @@ CObject* CTaskManip::SearchTakeFrontObject(bool bAdvance, glm::vec3 &pos,
     min = 1000000.0f;
     pBest = nullptr;
     bAngle = 0.0f;
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Transportable))
     {
-        if ( !pObj->Implements(ObjectInterfaceType::Transportable) )  continue;
-
         if (IsObjectBeingTransported(pObj))  continue;
         if ( pObj->GetLock() )  continue;
         if ( pObj->GetScaleY() != 1.0f )  continue;
@@ -826,10 +822,8 @@ CObject* CTaskManip::SearchTakeBackObject(bool bAdvance, glm::vec3 &pos,
     min = 1000000.0f;
     pBest = nullptr;
     bAngle = 0.0f;
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Transportable))
     {
-        if ( !pObj->Implements(ObjectInterfaceType::Transportable) )  continue;
-
         if (IsObjectBeingTransported(pObj))  continue;
         if ( pObj->GetLock() )  continue;
         if ( pObj->GetScaleY() != 1.0f )  continue;
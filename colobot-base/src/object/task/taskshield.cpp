@@ -542,9 +542,8 @@ bool CTaskShield::CreateLight(glm::vec3 pos)
 
 void CTaskShield::IncreaseShield()
 {
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Shielded))
     {
-        if (!obj->Implements(ObjectInterfaceType::Shielded)) continue;
         CShieldedObject* shielded = dynamic_cast<CShieldedObject*>(obj);
         if (!shielded->IsRepairable()) continue; // NOTE: Looks like the original code forgot to check that
 
@@ -304,10 +304,8 @@ CObject* CTaskTake::SearchTakeObject(float &angle,
     min = 1000000.0f;
     pBest = nullptr;
     bAngle = 0.0f;
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Transportable))
     {
-        if ( !pObj->Implements(ObjectInterfaceType::Transportable) )  continue;
-
         if (IsObjectBeingTransported(pObj))  continue;
         if ( pObj->GetLock() )  continue;
         if ( pObj->GetScaleY() != 1.0f )  continue;
@@ -350,10 +348,9 @@ CObject* CTaskTake::SearchFriendObject(float &angle,
     float iAngle = m_object->GetRotationY();
     iAngle = Math::NormAngle(iAngle);  // 0..2*Math::PI
 
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsImplementing(ObjectInterfaceType::Slotted))
     {
         if ( pObj == m_object )  continue;  // yourself?
-        if (!pObj->Implements(ObjectInterfaceType::Slotted)) continue;
 
         CSlottedObject *obj = dynamic_cast<CSlottedObject*>(pObj);
 
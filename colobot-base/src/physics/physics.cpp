@@ -24,6 +24,7 @@
 
 #include "common/event.h"
 #include "common/global.h"
+#include "common/profiler.h"
 
 #include "graphics/engine/camera.h"
 #include "graphics/engine/engine.h"
@@ -1446,6 +1447,8 @@ bool CPhysics::EventFrame(const Event &event)
 
     if ( m_engine->GetPause() )  return true;
 
+    CProfilerScope scope("Physics");
+
     m_time += event.rTime;
     m_timeUnderWater += event.rTime;
     m_soundTimeJostle += event.rTime;
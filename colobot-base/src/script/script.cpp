@@ -44,6 +44,8 @@
 #include "ui/controls/interface.h"
 #include "ui/controls/list.h"
 
+#include <algorithm>
+
 #include <libintl.h>
 
 const int CBOT_IPF = 100;       // CBOT: default number of instructions / frame
@@ -243,6 +245,7 @@ bool CScript::Compile()
     if (m_botProg == nullptr)
     {
         m_botProg = std::make_unique<CBot::CBotProgram>(m_object->GetBotVar());
+        m_botProg->SetProfiling(m_bProfiling);
     }
 
     if ( m_botProg->Compile(m_script, functionList, this) )
@@ -327,10 +330,10 @@ bool CScript::Run()
     return true;
 }
 
-// Continues the execution of current program.
+// Continues the execution of current program, runs at most ipf instructions.
 // Returns true when execution is finished.
 
-bool CScript::Continue()
+bool CScript::Continue(int ipf)
 {
     if (m_botProg == nullptr)  return true;
     if ( !m_bRun )  return true;
@@ -366,7 +369,7 @@ bool CScript::Continue()
         return false;
     }
 
-    if ( m_botProg->Run(this, m_ipf) )
+    if ( m_botProg->Run(this, ipf) )
     {
         m_botProg->GetError(m_error, m_cursor1, m_cursor2);
         if ( !isValidRange(m_script, m_cursor1, m_cursor2) )
@@ -457,6 +460,22 @@ bool CScript::IsContinue()
 }
 
 
+// Gives the number of instructions/frame the program asked for.
+
+int CScript::GetIpf()
+{
+    return m_ipf;
+}
+
+// Gives the number of instructions executed by the last Continue().
+
+int CScript::GetExecutedInstructions()
+{
+    if (m_botProg == nullptr)  return 0;
+    return m_botProg->GetTimerUsed();
+}
+
+
 // Gives the position of the cursor during the execution.
 
 bool CScript::GetCursor(int &cursor1, int &cursor2)
@@ -590,6 +609,70 @@ void CScript::UpdateList(Ui::CList* list)
     list->SetState(Ui::STATE_ENABLE);
 }
 
+// Enables or disables collecting of execution statistics.
+
+void CScript::SetProfiling(bool bProfiling)
+{
+    m_bProfiling = bProfiling;
+    if (m_botProg != nullptr)
+    {
+        m_botProg->SetProfiling(bProfiling);
+    }
+}
+
+bool CScript::GetProfiling()
+{
+    return m_bProfiling;
+}
+
+// Fills a list with execution statistics, by function and the hottest lines.
+
+void CScript::UpdateProfileList(Ui::CList* list)
+{
+    if (m_botProg == nullptr) return;
+    CBot::CBotProfiler* profiler = m_botProg->GetProfiler();
+    if (profiler == nullptr) return;
+
+    int select = list->GetSelect();
+    list->Flush();  // empty list
+
+    std::string totalName, entryFormat, lineFormat;
+    GetResource(RES_TEXT, RT_STUDIO_PROFILE_TOTAL, totalName);
+    GetResource(RES_TEXT, RT_STUDIO_PROFILE_ENTRY, entryFormat);
+    GetResource(RES_TEXT, RT_STUDIO_PROFILE_LINE, lineFormat);
+
+    CBot::CBotProfileEntry total = profiler->GetTotal();
+    auto format = [&](const std::string& name, const CBot::CBotProfileEntry& entry)
+    {
+        float percent = total.instructions > 0 ? 100.0f * entry.instructions / total.instructions : 0.0f;
+        return StrUtils::Format(entryFormat.c_str(), name.c_str(),
+                                entry.instructions, percent, entry.time / 1e6, entry.allocations);
+    };
+    auto lineOf = [&](int position)
+    {
+        position = std::clamp(position, 0, static_cast<int>(m_script.size()));
+        return 1 + static_cast<int>(std::count(m_script.begin(), m_script.begin() + position, '\n'));
+    };
+
+    int rank = 0;
+    list->SetItemName(rank++, format(totalName, total));
+    for (const auto& entry : profiler->GetFunctions())
+    {
+        list->SetItemName(rank++, format(entry.function + "()", entry));
+    }
+
+    const std::size_t MAX_LINES = 10;
+    auto positions = profiler->GetPositions();
+    for (std::size_t i = 0; i < positions.size() && i < MAX_LINES; ++i)
+    {
+        list->SetItemName(rank++, format(StrUtils::Format(lineFormat.c_str(), lineOf(positions[i].start)), positions[i]));
+    }
+
+    list->SetSelect(select);
+    list->SetTooltip("");
+    list->SetState(Ui::STATE_ENABLE);
+}
+
 // Colorize a string or character literal with escape sequences also colored
 
 static void HighlightString(Ui::CEdit* edit, const std::string& s, int start)
@@ -76,13 +76,18 @@ public:
     void        SetStepMode(bool bStep);
     bool        GetStepMode();
     bool        Run();
-    bool        Continue();
+    bool        Continue(int ipf);
     bool        Step();
     void        Stop();
     bool        IsRunning();
     bool        IsContinue();
+    int         GetIpf();
+    int         GetExecutedInstructions();
     bool        GetCursor(int &cursor1, int &cursor2);
     void        UpdateList(Ui::CList* list);
+    void        SetProfiling(bool bProfiling);
+    bool        GetProfiling();
+    void        UpdateProfileList(Ui::CList* list);
     static void ColorizeScript(Ui::CEdit* edit, int rangeStart = 0, int rangeEnd = std::numeric_limits<int>::max());
     bool        IntroduceVirus();
 
@@ -123,6 +128,7 @@ protected:
     bool    m_bStepMode = false;        // step by step
     bool    m_bContinue = false;        // external function to continue
     bool    m_bCompile = false;     // compilation ok?
+    bool    m_bProfiling = false;   // collect execution statistics?
     std::string m_title = "";        // script title
     std::string m_mainFunction = "";
     std::filesystem::path m_filename = "";     // file name
@@ -0,0 +1,358 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "script/script_scheduler.h"
+
+#include "common/profiler.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+
+//! Weight of the last frame in the average time of one instruction
+const double INSTRUCTION_TIME_SMOOTHING = 0.1;
+
+//! Gives everyone what they need, or an equal share of what is left if they need more
+std::vector<int> ShareFairly(const std::vector<int>& demands, int budget)
+{
+    std::vector<std::size_t> order(demands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+    {
+        return demands[a] < demands[b];
+    });
+
+    std::vector<int> grants(demands.size(), 0);
+    int left = static_cast<int>(order.size());
+    for (std::size_t i : order)
+    {
+        grants[i] = std::min(demands[i], budget / left);
+        budget -= grants[i];
+        --left;
+    }
+    return grants;
+}
+
+} // anonymous namespace
+
+void CScriptScheduler::SetInstructionBudget(int instructions)
+{
+    m_instructionBudget = std::max(instructions, 0);
+}
+
+int CScriptScheduler::GetInstructionBudget() const
+{
+    return m_instructionBudget;
+}
+
+void CScriptScheduler::SetTimeBudget(float time)
+{
+    m_timeBudget = std::max(time, 0.0f);
+}
+
+float CScriptScheduler::GetTimeBudget() const
+{
+    return m_timeBudget;
+}
+
+void CScriptScheduler::SetDeterministic(bool deterministic)
+{
+    m_deterministic = deterministic;
+}
+
+bool CScriptScheduler::GetDeterministic() const
+{
+    return m_deterministic;
+}
+
+void CScriptScheduler::SetTeamQuotas(bool teamQuotas)
+{
+    m_teamQuotas = teamQuotas;
+}
+
+bool CScriptScheduler::GetTeamQuotas() const
+{
+    return m_teamQuotas;
+}
+
+void CScriptScheduler::Reset()
+{
+    m_slices.clear();
+    m_sliceIndexes.clear();
+    m_history.clear();
+    m_lastServed.clear();
+    m_budget = 0;
+    m_spare = 0;
+    m_current = -1;
+    m_frameTime = 0;
+    m_frameExecuted = 0;
+    m_stats = ScriptSchedulerStats();
+}
+
+void CScriptScheduler::AddProgram(int id, int team, int instructions)
+{
+    Slice slice;
+    slice.id = id;
+    slice.team = m_teamQuotas ? team : 0;
+    slice.wanted = std::max(instructions, 0);
+    m_slices.push_back(slice);
+}
+
+void CScriptScheduler::Schedule()
+{
+    CProfilerScope scope("CBot scheduling");
+
+    std::sort(m_slices.begin(), m_slices.end(), [](const Slice& a, const Slice& b)
+    {
+        return a.team != b.team ? a.team < b.team : a.id < b.id;
+    });
+    m_sliceIndexes.clear();
+    for (std::size_t i = 0; i < m_slices.size(); ++i)
+        m_sliceIndexes[m_slices[i].id] = i;
+
+    m_budget = m_instructionBudget;
+    if (!m_deterministic && m_timeBudget > 0.0f && m_instructionTime > 0.0)
+    {
+        double instructions = m_timeBudget * 1e6 / m_instructionTime;
+        int timeBudget = static_cast<int>(std::clamp(instructions, static_cast<double>(SCRIPT_MIN_SLICE), 1e9));
+        m_budget = m_budget > 0 ? std::min(m_budget, timeBudget) : timeBudget;
+    }
+
+    long long wanted = 0;
+    for (const Slice& slice : m_slices)
+        wanted += slice.wanted;
+
+    if (m_budget == 0 || wanted <= m_budget)
+    {
+        for (Slice& slice : m_slices)
+            slice.granted = slice.wanted;
+        m_spare = m_budget > 0 ? m_budget - wanted : 0;
+        return;
+    }
+
+    std::vector<int> demands;
+    demands.reserve(m_slices.size());
+    for (const Slice& slice : m_slices)
+        demands.push_back(GetDemand(slice.id, slice.wanted));
+
+    // Teams are contiguous, without team quotas everyone is in team 0
+    std::vector<std::size_t> teamStarts;
+    std::vector<int> teamDemands;
+    for (std::size_t i = 0; i < m_slices.size(); ++i)
+    {
+        if (i == 0 || m_slices[i].team != m_slices[i - 1].team)
+        {
+            teamStarts.push_back(i);
+            teamDemands.push_back(0);
+        }
+        teamDemands.back() = static_cast<int>(std::min<long long>(static_cast<long long>(teamDemands.back()) + demands[i], m_budget));
+    }
+    teamStarts.push_back(m_slices.size());
+
+    std::vector<int> teamBudgets = ShareFairly(teamDemands, m_budget);
+    for (std::size_t team = 0; team < teamBudgets.size(); ++team)
+        ShareBudget(teamStarts[team], teamStarts[team + 1], demands, teamBudgets[team]);
+
+    m_spare = m_budget;
+    for (const Slice& slice : m_slices)
+        m_spare -= slice.granted;
+}
+
+int CScriptScheduler::GetDemand(int id, int instructions) const
+{
+    auto it = m_history.find(id);
+    if (it == m_history.end() || it->second.given <= 0 || it->second.executed >= it->second.given)
+        return instructions;
+
+    // Stopped early last time, most likely waiting for something
+    return std::min(instructions, it->second.executed + SCRIPT_MIN_SLICE);
+}
+
+void CScriptScheduler::ShareBudget(std::size_t begin, std::size_t end, const std::vector<int>& demands, int budget)
+{
+    std::vector<std::size_t> chosen;
+
+    long long minimum = 0;
+    for (std::size_t i = begin; i < end; ++i)
+        minimum += std::min(demands[i], SCRIPT_MIN_SLICE);
+
+    if (minimum <= budget)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            chosen.push_back(i);
+    }
+    else
+    {
+        // Not enough for everyone, take turns starting after the last program served
+        int team = m_slices[begin].team;
+        std::size_t first = begin;
+        auto lastServed = m_lastServed.find(team);
+        if (lastServed != m_lastServed.end())
+        {
+            auto next = std::upper_bound(m_slices.begin() + begin, m_slices.begin() + end, lastServed->second,
+                                         [](int id, const Slice& slice) { return id < slice.id; });
+            first = next != m_slices.begin() + end ? next - m_slices.begin() : begin;
+        }
+
+        std::size_t count = end - begin;
+        int left = budget;
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            std::size_t i = begin + (first - begin + n) % count;
+            int minimumSlice = std::min(demands[i], SCRIPT_MIN_SLICE);
+            if (minimumSlice > left)
+                break;
+
+            chosen.push_back(i);
+            left -= minimumSlice;
+        }
+
+        if (!chosen.empty())
+            m_lastServed[team] = m_slices[chosen.back()].id;
+    }
+
+    std::vector<int> chosenDemands;
+    chosenDemands.reserve(chosen.size());
+    for (std::size_t i : chosen)
+        chosenDemands.push_back(demands[i]);
+
+    std::vector<int> grants = ShareFairly(chosenDemands, budget);
+    for (std::size_t n = 0; n < chosen.size(); ++n)
+        m_slices[chosen[n]].granted = grants[n];
+}
+
+int CScriptScheduler::StartSlice(int id, int instructions)
+{
+    auto it = m_sliceIndexes.find(id);
+    if (it == m_sliceIndexes.end())
+    {
+        // Started during this frame, can only get what others didn't take
+        Slice slice;
+        slice.id = id;
+        slice.wanted = std::max(instructions, 0);
+        it = m_sliceIndexes.emplace(id, m_slices.size()).first;
+        m_slices.push_back(slice);
+    }
+
+    Slice& slice = m_slices[it->second];
+    if (m_budget == 0 || instructions <= 0)
+    {
+        slice.given = instructions;
+    }
+    else
+    {
+        long long extra = std::clamp<long long>(instructions - slice.granted, 0, std::max(m_spare, 0LL));
+        m_spare -= extra;
+        slice.given = slice.granted + static_cast<int>(extra);
+
+        if (slice.given == 0)
+            return -1;
+    }
+
+    m_current = static_cast<int>(it->second);
+    m_sliceStart = TimeUtils::GetCurrentTimeStamp();
+    return slice.given;
+}
+
+void CScriptScheduler::EndSlice(int executed)
+{
+    if (m_current < 0)
+        return;
+
+    Slice& slice = m_slices[m_current];
+    slice.executed = executed;
+    m_current = -1;
+
+    m_frameTime += TimeUtils::ExactDiff(m_sliceStart, TimeUtils::GetCurrentTimeStamp());
+    m_frameExecuted += executed;
+
+    // Instructions not used go to programs running later
+    if (m_budget > 0)
+        m_spare += slice.given - executed;
+}
+
+void CScriptScheduler::EndFrame()
+{
+    long long totalStarved = m_stats.totalStarved;
+    int longestStarvation = m_stats.longestStarvation;
+
+    m_stats = ScriptSchedulerStats();
+    m_stats.budget = m_budget;
+    m_stats.executed = m_frameExecuted;
+    m_stats.time = m_frameTime;
+
+    std::unordered_map<int, History> history;
+    for (const Slice& slice : m_slices)
+    {
+        if (slice.given < 0)
+            continue;
+
+        m_stats.programs++;
+
+        History& entry = history[slice.id];
+        entry.given = slice.given;
+        entry.executed = slice.executed;
+
+        if (slice.given == 0 && slice.wanted > 0)
+        {
+            m_stats.starved++;
+            auto last = m_history.find(slice.id);
+            entry.waiting = (last != m_history.end() ? last->second.waiting : 0) + 1;
+            longestStarvation = std::max(longestStarvation, entry.waiting);
+        }
+        else
+        {
+            m_stats.scheduled++;
+            if (slice.given < slice.wanted)
+                m_stats.throttled++;
+        }
+    }
+    m_history.swap(history);
+
+    m_stats.totalStarved = totalStarved + m_stats.starved;
+    m_stats.longestStarvation = longestStarvation;
+
+    if (m_frameExecuted > 0 && m_frameTime > 0)
+    {
+        double instructionTime = static_cast<double>(m_frameTime) / m_frameExecuted;
+        if (m_instructionTime > 0.0)
+            m_instructionTime += (instructionTime - m_instructionTime) * INSTRUCTION_TIME_SMOOTHING;
+        else
+            m_instructionTime = instructionTime;
+    }
+
+    CProfiler::RecordCounter("CBot budget", m_stats.budget);
+    CProfiler::RecordCounter("CBot instructions", m_stats.executed);
+    CProfiler::RecordCounter("CBot scheduled programs", m_stats.scheduled);
+    CProfiler::RecordCounter("CBot throttled programs", m_stats.throttled);
+    CProfiler::RecordCounter("CBot starved programs", m_stats.starved);
+
+    m_slices.clear();
+    m_sliceIndexes.clear();
+    m_current = -1;
+    m_frameTime = 0;
+    m_frameExecuted = 0;
+}
+
+const ScriptSchedulerStats& CScriptScheduler::GetStats() const
+{
+    return m_stats;
+}
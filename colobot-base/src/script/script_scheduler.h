@@ -0,0 +1,183 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file script/script_scheduler.h
+ * \brief Sharing CBot execution time between programs
+ */
+
+#pragma once
+
+#include "common/timeutils.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+//! Smallest slice worth running a program for; the CBot timer can overflow by about as much
+const int SCRIPT_MIN_SLICE = 10;
+
+/**
+ * \struct ScriptSchedulerStats
+ * \brief Decisions of CScriptScheduler in one frame
+ */
+struct ScriptSchedulerStats
+{
+    //! Number of programs that wanted to run
+    int programs = 0;
+    //! Number of programs that ran
+    int scheduled = 0;
+    //! Number of programs that ran fewer instructions than they asked for
+    int throttled = 0;
+    //! Number of programs that had to wait for a later frame
+    int starved = 0;
+    //! Instructions available to all programs, 0 if unlimited
+    int budget = 0;
+    //! Instructions executed by all programs
+    int executed = 0;
+    //! Time spent running programs, in nanoseconds
+    long long time = 0;
+    //! Slices skipped since Reset()
+    long long totalStarved = 0;
+    //! Most frames in a row any program had to wait since Reset()
+    int longestStarvation = 0;
+};
+
+/**
+ * \class CScriptScheduler
+ * \brief Shares a budget of CBot instructions per frame between all running programs
+ *
+ * Every frame, each running program asks for ipf() instructions. When all of them fit
+ * in the budget, every program gets what it asked for, just like without a budget.
+ * Otherwise the budget is shared fairly: programs expected to need less than an equal share
+ * get what they need, the rest is split equally between the others. A program that stopped
+ * early in the last frame (e.g. waiting for move() to finish) is expected to need only a bit
+ * more than it used then. When there isn't even SCRIPT_MIN_SLICE instructions for every
+ * program, programs take turns in round-robin order of their ids and the others wait.
+ * Instructions given but not used go to programs running later in the same frame.
+ *
+ * With team quotas, used in code battles, the budget is first shared fairly between teams,
+ * so a team can't get more instructions by running more programs.
+ *
+ * The budget can also be limited by time: the scheduler measures the average time of one
+ * instruction and lowers the budget so that all programs should fit in the time budget.
+ * Slices then depend on how fast the computer is, so there is no time budget by default.
+ * Deterministic mode ignores the time budget even if it is set.
+ *
+ * Every frame: AddProgram() for every running program, Schedule(), StartSlice() and EndSlice()
+ * around running each program, EndFrame().
+ */
+class CScriptScheduler
+{
+public:
+    //! Sets number of instructions all programs can execute in one frame, 0 for no limit
+    void SetInstructionBudget(int instructions);
+    int GetInstructionBudget() const;
+
+    //! Sets time all programs can run in one frame, in milliseconds, 0 for no limit
+    void SetTimeBudget(float time);
+    float GetTimeBudget() const;
+
+    //! Enables ignoring the time budget, so that slices don't depend on measured time
+    void SetDeterministic(bool deterministic);
+    bool GetDeterministic() const;
+
+    //! Enables sharing the budget between teams first
+    void SetTeamQuotas(bool teamQuotas);
+    bool GetTeamQuotas() const;
+
+    //! Forgets all programs and statistics, e.g. when a level is loaded
+    void Reset();
+
+    //! Adds program which wants to execute \a instructions in this frame
+    void AddProgram(int id, int team, int instructions);
+    //! Shares the budget between programs added in this frame
+    void Schedule();
+
+    /**
+     * \brief Starts running a program
+     * \param id Identifier of the program given in AddProgram()
+     * \param instructions Number of instructions the program wants to execute
+     * \return Number of instructions the program can execute now, or -1 if it has to wait for a later frame
+     */
+    int StartSlice(int id, int instructions);
+    //! Finishes running the program given in last StartSlice()
+    void EndSlice(int executed);
+
+    //! Updates statistics and sends them to the profiler
+    void EndFrame();
+
+    //! Returns statistics of the last frame
+    const ScriptSchedulerStats& GetStats() const;
+
+private:
+    //! Returns number of instructions the program is expected to need
+    int GetDemand(int id, int instructions) const;
+    //! Shares \a budget between programs from \a begin to \a end
+    void ShareBudget(std::size_t begin, std::size_t end, const std::vector<int>& demands, int budget);
+
+private:
+    struct Slice
+    {
+        int id = 0;
+        int team = 0;
+        //! Instructions the program asked for
+        int wanted = 0;
+        //! Instructions the program is guaranteed in this frame
+        int granted = 0;
+        //! Instructions given in StartSlice(), 0 if the program had to wait, -1 if it wasn't started
+        int given = -1;
+        int executed = 0;
+    };
+
+    struct History
+    {
+        int given = 0;
+        int executed = 0;
+        //! Frames in a row the program had to wait
+        int waiting = 0;
+    };
+
+    int m_instructionBudget = 0;
+    float m_timeBudget = 0.0f;
+    bool m_deterministic = false;
+    bool m_teamQuotas = false;
+
+    //! Programs of the current frame, by team (with team quotas) and id
+    std::vector<Slice> m_slices;
+    std::unordered_map<int, std::size_t> m_sliceIndexes;
+    //! Slices of the last frame
+    std::unordered_map<int, History> m_history;
+    //! Id of the program which was the last to get its turn, by team
+    std::map<int, int> m_lastServed;
+
+    //! Budget of the current frame, 0 if unlimited
+    int m_budget = 0;
+    //! Instructions not given to any program yet
+    long long m_spare = 0;
+    //! Index of the running slice, -1 if none
+    int m_current = -1;
+    TimeUtils::TimeStamp m_sliceStart;
+    long long m_frameTime = 0;
+    int m_frameExecuted = 0;
+    //! Average time of one instruction, in nanoseconds
+    double m_instructionTime = 0.0;
+
+    ScriptSchedulerStats m_stats;
+};
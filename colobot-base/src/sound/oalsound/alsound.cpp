@@ -23,6 +23,8 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <utility>
+#include <vector>
 
 
 CALSound::CALSound()
@@ -31,7 +33,9 @@ CALSound::CALSound()
       m_musicVolume(1.0f),
       m_channelsLimit(2048),
       m_device{},
-      m_context{}
+      m_context{},
+      m_streamUpdatePending(false),
+      m_workQueue(*GetThreadPool(), "Sound")
 {
 }
 
@@ -42,6 +46,10 @@ CALSound::~CALSound()
 
 void CALSound::CleanUp()
 {
+    // background loading must not touch the context after it's destroyed
+    m_workQueue.Clear();
+    m_streamUpdatePending = false;
+
     if (m_enabled)
     {
         GetLogger()->Info("Unloading files and closing device...");
@@ -85,6 +93,8 @@ bool CALSound::Create()
 void CALSound::Reset()
 {
     StopAll();
+
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     StopMusic();
 
     m_channels.clear();
@@ -121,6 +131,8 @@ int CALSound::GetAudioVolume()
 void CALSound::SetMusicVolume(int volume)
 {
     m_musicVolume = static_cast<float>(volume) / MAXVOLUME;
+
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     if (m_currentMusic)
     {
         m_currentMusic->SetVolume(m_musicVolume);
@@ -148,15 +160,19 @@ bool CALSound::Cache(SoundType sound, const std::filesystem::path &filename)
 
 void CALSound::CacheMusic(const std::filesystem::path &filename)
 {
-    m_thread.Start([this, filename]()
+    m_workQueue.Post([this, filename]()
     {
-        if (m_music.find(filename) == m_music.end())
         {
-            auto buffer = std::make_unique<CBuffer>();
-            if (buffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
-            {
-                m_music[filename] = std::move(buffer);
-            }
+            std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+            if (m_music.find(filename) != m_music.end())
+                return;
+        }
+
+        // music is streamed when played, so only check that the file can be decoded
+        if (CStream::CanDecode(filename))
+        {
+            std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+            m_music.insert(filename);
         }
     });
 }
@@ -168,6 +184,7 @@ bool CALSound::IsCached(SoundType sound)
 
 bool CALSound::IsCachedMusic(const std::filesystem::path &filename)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     return m_music.find(filename) != m_music.end();
 }
 
@@ -540,6 +557,8 @@ void CALSound::FrameMove(float rTime)
         }
     }
 
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+
     auto it = m_oldMusic.begin();
     while (it != m_oldMusic.end())
     {
@@ -567,6 +586,50 @@ void CALSound::FrameMove(float rTime)
             m_previousMusic.music->SetVolume(((m_previousMusic.fadeTime-m_previousMusic.currentTime) / m_previousMusic.fadeTime) * m_musicVolume);
         }
     }
+
+    // don't pile up refills if the worker thread is busy loading something
+    if (!m_streamUpdatePending.exchange(true))
+    {
+        m_workQueue.Post([this]()
+        {
+            UpdateMusicStreams();
+            m_streamUpdatePending = false;
+        });
+    }
+}
+
+void CALSound::UpdateMusicStreams()
+{
+    std::vector<std::pair<std::shared_ptr<CStream>, bool>> streams;
+    {
+        std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+
+        auto addStream = [&](CChannel* channel)
+        {
+            if (channel != nullptr && channel->GetStream() != nullptr)
+                streams.emplace_back(channel->GetStream(), channel->GetLoop());
+        };
+
+        addStream(m_currentMusic.get());
+        for (auto& old : m_oldMusic)
+            addStream(old.music.get());
+        addStream(m_previousMusic.music.get());
+    }
+
+    // decoding can be slow, don't make FrameMove() wait for it
+    for (auto& [stream, loop] : streams)
+        stream->Decode(loop);
+
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+
+    if (m_currentMusic)
+        m_currentMusic->UpdateStream();
+
+    for (auto& old : m_oldMusic)
+        old.music->UpdateStream();
+
+    if (m_previousMusic.music)
+        m_previousMusic.music->UpdateStream();
 }
 
 void CALSound::SetListener(const glm::vec3 &eye, const glm::vec3 &lookat)
@@ -587,29 +650,17 @@ void CALSound::PlayMusic(const std::filesystem::path& filename, bool repeat, flo
         return;
     }
 
-    m_thread.Start([this, filename, repeat, fadeTime]()
+    m_workQueue.Post([this, filename, repeat, fadeTime]()
     {
-        CBuffer* buffer = nullptr;
-
-        // check if we have music in cache
-        if (m_music.find(filename) == m_music.end())
+        auto stream = std::make_unique<CStream>();
+        if (!stream->Open(filename))
         {
-            GetLogger()->Debug("Music %% was not cached!", filename);
-
-            auto newBuffer = std::make_unique<CBuffer>();
-            buffer = newBuffer.get();
-            if (!newBuffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
-            {
-                return;
-            }
-            m_music[filename] = std::move(newBuffer);
-        }
-        else
-        {
-            GetLogger()->Debug("Music loaded from cache");
-            buffer = m_music[filename].get();
+            return;
         }
 
+        std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
+        m_music.insert(filename);
+
         if (m_currentMusic)
         {
             OldMusic old;
@@ -620,7 +671,7 @@ void CALSound::PlayMusic(const std::filesystem::path& filename, bool repeat, flo
         }
 
         m_currentMusic = std::make_unique<CChannel>();
-        m_currentMusic->SetBuffer(buffer);
+        m_currentMusic->SetStream(std::move(stream));
         m_currentMusic->SetVolume(m_musicVolume);
         m_currentMusic->SetLoop(repeat);
         m_currentMusic->Play();
@@ -629,6 +680,7 @@ void CALSound::PlayMusic(const std::filesystem::path& filename, bool repeat, flo
 
 void CALSound::PlayPauseMusic(const std::filesystem::path& filename, bool repeat)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     if (m_previousMusic.fadeTime > 0.0f)
     {
         if (m_currentMusic != nullptr)
@@ -654,6 +706,7 @@ void CALSound::PlayPauseMusic(const std::filesystem::path& filename, bool repeat
 
 void CALSound::StopPauseMusic()
 {
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     if (m_previousMusic.fadeTime > 0.0f)
     {
         StopMusic();
@@ -673,6 +726,7 @@ void CALSound::StopPauseMusic()
 
 void CALSound::StopMusic(float fadeTime)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     if (!m_enabled || m_currentMusic == nullptr)
     {
         return;
@@ -687,6 +741,7 @@ void CALSound::StopMusic(float fadeTime)
 
 bool CALSound::IsPlayingMusic()
 {
+    std::lock_guard<std::recursive_mutex> lock{m_musicMutex};
     if (!m_enabled || m_currentMusic == nullptr)
     {
         return false;
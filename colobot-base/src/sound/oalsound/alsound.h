@@ -26,14 +26,18 @@
 
 #include "sound/sound.h"
 
-#include "common/thread/worker_thread.h"
+#include "common/thread/thread_pool.h"
 
 #include "sound/oalsound/buffer.h"
 #include "sound/oalsound/channel.h"
 #include "sound/oalsound/check.h"
+#include "sound/oalsound/stream.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <list>
 #include <filesystem>
@@ -122,6 +126,8 @@ private:
     int GetPriority(SoundType);
     bool SearchFreeBuffer(SoundType sound, int &channel, bool &alreadyLoaded);
     bool CheckChannel(int &channel);
+    //! Refills music streams, runs on the worker thread
+    void UpdateMusicStreams();
 
     bool m_enabled;
     float m_audioVolume;
@@ -130,12 +136,17 @@ private:
     ALCdevice* m_device;
     ALCcontext* m_context;
     std::map<SoundType, std::unique_ptr<CBuffer>> m_sounds;
-    std::map<std::filesystem::path, std::unique_ptr<CBuffer>> m_music;
+    //! Music files known to be playable; music is streamed, so nothing is kept in memory
+    std::set<std::filesystem::path> m_music;
     std::map<int, std::unique_ptr<CChannel>> m_channels;
     std::unique_ptr<CChannel> m_currentMusic;
     std::list<OldMusic> m_oldMusic;
     OldMusic m_previousMusic;
     glm::vec3 m_eye;
     glm::vec3 m_lookat;
-    CWorkerThread m_thread;
+    //! Guards music channels, which are shared with the worker thread
+    std::recursive_mutex m_musicMutex;
+    std::atomic<bool> m_streamUpdatePending;
+    //! Runs file loading and stream updates in background, one at a time
+    CSerialQueue m_workQueue;
 };
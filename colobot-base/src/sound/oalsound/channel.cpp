@@ -21,6 +21,7 @@
 #include "sound/oalsound/channel.h"
 
 #include "sound/oalsound/buffer.h"
+#include "sound/oalsound/stream.h"
 
 CChannel::CChannel()
     : m_buffer(nullptr),
@@ -34,7 +35,8 @@ CChannel::CChannel()
       m_volume(0.0f),
       m_ready(false),
       m_loop(false),
-      m_mute(false)
+      m_mute(false),
+      m_streamPlaying(false)
 {
     alGenSources(1, &m_source);
 
@@ -63,12 +65,32 @@ CChannel::~CChannel()
 
 bool CChannel::Play()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
 
-    alSourcei(m_source, AL_LOOPING, static_cast<ALint>(m_loop));
+    if (m_stream != nullptr)
+    {
+        // looping is done by the stream itself, the source would only loop the queued buffers
+        alSourcei(m_source, AL_LOOPING, AL_FALSE);
+
+        ALint status;
+        alGetSourcei(m_source, AL_SOURCE_STATE, &status);
+        if (status == AL_PLAYING)
+            return true;
+
+        if (status != AL_PAUSED)
+        {
+            m_stream->Rewind(m_source, 0.0f);
+            m_stream->Start(m_source, m_loop);
+        }
+        m_streamPlaying = true;
+    }
+    else
+    {
+        alSourcei(m_source, AL_LOOPING, static_cast<ALint>(m_loop));
+    }
     alSourcei(m_source, AL_REFERENCE_DISTANCE, 10.0f);
     alSourcei(m_source, AL_MAX_DISTANCE, 110.0f);
     alSourcePlay(m_source);
@@ -86,6 +108,7 @@ bool CChannel::Pause()
         return false;
     }
 
+    m_streamPlaying = false;
     alSourcePause(m_source);
     if (CheckOpenALError())
     {
@@ -96,7 +119,7 @@ bool CChannel::Pause()
 
 bool CChannel::SetPosition(const glm::vec3 &pos, bool relativeToListener)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -113,7 +136,7 @@ bool CChannel::SetPosition(const glm::vec3 &pos, bool relativeToListener)
 
 bool CChannel::SetFrequency(float freq)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -130,7 +153,7 @@ bool CChannel::SetFrequency(float freq)
 float CChannel::GetFrequency()
 {
     ALfloat freq;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0;
     }
@@ -147,7 +170,7 @@ float CChannel::GetFrequency()
 
 bool CChannel::SetVolume(float vol)
 {
-    if (!m_ready || vol < 0 || m_buffer == nullptr)
+    if (!m_ready || vol < 0 || !IsLoaded())
     {
         return false;
     }
@@ -164,7 +187,7 @@ bool CChannel::SetVolume(float vol)
 float CChannel::GetVolume()
 {
     ALfloat vol;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0;
     }
@@ -260,6 +283,11 @@ bool CChannel::SetBuffer(CBuffer *buffer)
         return false;
 
     Stop();
+    if (m_stream != nullptr)
+    {
+        alSourcei(m_source, AL_BUFFER, 0);
+        m_stream.reset();
+    }
     m_buffer = buffer;
     if (buffer == nullptr)
     {
@@ -277,10 +305,63 @@ bool CChannel::SetBuffer(CBuffer *buffer)
     return true;
 }
 
+bool CChannel::SetStream(std::unique_ptr<CStream> stream)
+{
+    if (!m_ready)
+        return false;
+
+    SetBuffer(nullptr);
+    if (stream == nullptr || !stream->IsOpen())
+        return false;
+
+    m_stream = std::move(stream);
+    m_initFrequency = GetFrequency();
+    return true;
+}
+
+void CChannel::UpdateStream()
+{
+    if (!m_ready || m_stream == nullptr)
+    {
+        return;
+    }
+
+    bool hasData = m_stream->Update(m_source, m_loop);
+    if (!m_streamPlaying)
+    {
+        return;
+    }
+
+    if (!hasData)
+    {
+        m_streamPlaying = false;
+        return;
+    }
+
+    // source ran out of queued data before we could refill it
+    ALint status;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &status);
+    if (status == AL_STOPPED)
+    {
+        GetLogger()->Debug("Audio stream buffer underrun, restarting");
+        alSourcePlay(m_source);
+    }
+}
+
+std::shared_ptr<CStream> CChannel::GetStream()
+{
+    return m_stream;
+}
+
+bool CChannel::IsStreaming()
+{
+    return m_stream != nullptr;
+}
+
 bool CChannel::IsPlaying()
 {
     ALint status;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -292,7 +373,7 @@ bool CChannel::IsPlaying()
         return false;
     }
 
-    return status == AL_PLAYING;
+    return status == AL_PLAYING || m_streamPlaying;
 }
 
 bool CChannel::IsReady()
@@ -302,16 +383,17 @@ bool CChannel::IsReady()
 
 bool CChannel::IsLoaded()
 {
-    return m_buffer != nullptr;
+    return m_buffer != nullptr || m_stream != nullptr;
 }
 
 bool CChannel::Stop()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
 
+    m_streamPlaying = false;
     alSourceStop(m_source);
     if (CheckOpenALError())
     {
@@ -323,11 +405,16 @@ bool CChannel::Stop()
 
 float CChannel::GetCurrentTime()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0.0f;
     }
 
+    if (m_stream != nullptr)
+    {
+        return m_stream->GetCurrentTime(m_source);
+    }
+
     ALfloat current;
     alGetSourcef(m_source, AL_SEC_OFFSET, &current);
     if (CheckOpenALError())
@@ -340,8 +427,18 @@ float CChannel::GetCurrentTime()
 
 void CChannel::SetCurrentTime(float current)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
+    {
+        return;
+    }
+
+    if (m_stream != nullptr)
     {
+        bool playing = m_streamPlaying;
+        m_stream->Rewind(m_source, current);
+        m_stream->Start(m_source, m_loop);
+        if (playing)
+            alSourcePlay(m_source);
         return;
     }
 
@@ -354,11 +451,16 @@ void CChannel::SetCurrentTime(float current)
 
 float CChannel::GetDuration()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0.0f;
     }
 
+    if (m_stream != nullptr)
+    {
+        return m_stream->GetDuration();
+    }
+
     return m_buffer->GetDuration();
 }
 
@@ -382,6 +484,11 @@ void CChannel::SetLoop(bool loop)
     m_loop = loop;
 }
 
+bool CChannel::GetLoop()
+{
+    return m_loop;
+}
+
 void CChannel::Mute(bool mute)
 {
     m_mute = mute;
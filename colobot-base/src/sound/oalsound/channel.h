@@ -33,11 +33,13 @@
 #include <string>
 #include <deque>
 #include <cassert>
+#include <memory>
 
 #include <al.h>
 #include <alc.h>
 
 class CBuffer;
+class CStream;
 
 struct SoundOper
 {
@@ -78,6 +80,13 @@ public:
     bool IsLoaded();
 
     bool SetBuffer(CBuffer *buffer);
+    //! Switches the channel to streaming mode, playing from \a stream instead of a cached buffer
+    bool SetStream(std::unique_ptr<CStream> stream);
+    //! Refills consumed stream buffers, called periodically for streaming channels
+    void UpdateStream();
+    //! Returns the stream of a streaming channel, nullptr otherwise
+    std::shared_ptr<CStream> GetStream();
+    bool IsStreaming();
 
     bool HasEnvelope();
     SoundOper& GetEnvelope();
@@ -99,6 +108,7 @@ public:
     void ResetOper();
     SoundType GetSoundType();
     void SetLoop(bool loop);
+    bool GetLoop();
     void Mute(bool mute);
     bool IsMuted();
 
@@ -107,6 +117,8 @@ public:
 
 private:
     CBuffer *m_buffer;
+    //! Shared so that the stream can be decoded without holding the lock of the channel's owner
+    std::shared_ptr<CStream> m_stream;
     ALuint m_source;
 
     int m_priority;
@@ -120,6 +132,8 @@ private:
     bool m_ready;
     bool m_loop;
     bool m_mute;
+    //! Whether the stream should keep playing, as opposed to being stopped or paused by the user
+    bool m_streamPlaying;
     glm::vec3 m_position;
 };
 
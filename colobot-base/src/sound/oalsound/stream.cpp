@@ -0,0 +1,274 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "sound/oalsound/stream.h"
+
+#include "common/logger.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "sound/oalsound/check.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+CStream::CStream()
+    : m_buffers(),
+      m_format(AL_FORMAT_MONO16),
+      m_channels(0),
+      m_sampleRate(0),
+      m_frames(0),
+      m_position(0),
+      m_loaded(false),
+      m_finished(false)
+{}
+
+CStream::~CStream()
+{
+    if (m_loaded)
+    {
+        alDeleteBuffers(BUFFER_COUNT, m_buffers.data());
+        if (CheckOpenALError())
+            GetLogger()->Debug("Failed to unload stream buffers. Code %%", GetOpenALErrorCode());
+    }
+}
+
+bool CStream::Open(const std::filesystem::path& filename)
+{
+    GetLogger()->Debug("Opening audio stream: %%", filename);
+
+    m_file = CResourceManager::GetSNDFileHandler(filename);
+    if (!m_file->IsOpen())
+    {
+        GetLogger()->Warn("Could not load file %%. Reason: %%", filename, m_file->GetLastError());
+        m_file.reset();
+        return false;
+    }
+
+    alGenBuffers(BUFFER_COUNT, m_buffers.data());
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not create stream buffers. Code: %%", GetOpenALErrorCode());
+        m_file.reset();
+        return false;
+    }
+
+    m_channels = m_file->GetFileInfo().channels;
+    m_sampleRate = m_file->GetFileInfo().samplerate;
+    m_frames = m_file->GetFileInfo().frames;
+    m_format = m_channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+    m_position = 0;
+    m_finished = false;
+    m_loaded = true;
+    return true;
+}
+
+bool CStream::IsOpen()
+{
+    return m_loaded;
+}
+
+bool CStream::CanDecode(const std::filesystem::path& filename)
+{
+    auto file = CResourceManager::GetSNDFileHandler(filename);
+    if (!file->IsOpen())
+    {
+        GetLogger()->Warn("Could not load file %%. Reason: %%", filename, file->GetLastError());
+        return false;
+    }
+    return true;
+}
+
+bool CStream::DecodeBlock(Block& block, bool loop)
+{
+    if (m_finished)
+        return false;
+
+    block.start = m_position;
+    block.data.resize(BUFFER_FRAMES * m_channels);
+
+    std::size_t filled = 0;
+    bool rewound = false;
+    while (filled < block.data.size())
+    {
+        std::size_t read = m_file->Read(block.data.data() + filled, block.data.size() - filled);
+        filled += read;
+        m_position += read / m_channels;
+        if (read != 0)
+            continue;
+
+        // end of file; start over if looping, but only once per buffer to not spin on empty files
+        if (!loop || rewound)
+            break;
+
+        m_file->Seek(0);
+        m_position = 0;
+        rewound = true;
+    }
+
+    block.data.resize(filled);
+    if (filled == 0)
+    {
+        m_finished = true;
+        return false;
+    }
+    return true;
+}
+
+void CStream::Decode(bool loop)
+{
+    if (!m_loaded)
+        return;
+
+    // lock for one block at a time, so that Rewind() doesn't wait for all of them
+    while (true)
+    {
+        std::lock_guard<std::mutex> lock{m_decodeMutex};
+        if (m_decoded.size() >= BUFFER_COUNT)
+            break;
+
+        Block block;
+        if (!DecodeBlock(block, loop))
+            break;
+
+        m_decoded.push_back(std::move(block));
+    }
+}
+
+bool CStream::FillBuffer(ALuint buffer, bool loop, sf_count_t& start)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_decodeMutex};
+        if (!m_decoded.empty())
+        {
+            std::swap(m_block, m_decoded.front());
+            m_decoded.pop_front();
+        }
+        else if (!DecodeBlock(m_block, loop))
+        {
+            return false;
+        }
+    }
+
+    start = m_block.start;
+    alBufferData(buffer, m_format, m_block.data.data(), m_block.data.size() * sizeof(int16_t), m_sampleRate);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not fill stream buffer. Code: %%", GetOpenALErrorCode());
+        std::lock_guard<std::mutex> lock{m_decodeMutex};
+        m_finished = true;
+        m_decoded.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CStream::Start(ALuint source, bool loop)
+{
+    if (!m_loaded)
+        return false;
+
+    for (ALuint buffer : m_buffers)
+    {
+        sf_count_t start = 0;
+        if (!FillBuffer(buffer, loop, start))
+            break;
+
+        alSourceQueueBuffers(source, 1, &buffer);
+        m_queued.push_back(start);
+    }
+
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not queue stream buffers. Code: %%", GetOpenALErrorCode());
+        return false;
+    }
+    return !m_queued.empty();
+}
+
+bool CStream::Update(ALuint source, bool loop)
+{
+    if (!m_loaded)
+        return false;
+
+    ALint processed = 0;
+    alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+    while (processed-- > 0)
+    {
+        ALuint buffer;
+        alSourceUnqueueBuffers(source, 1, &buffer);
+        if (!m_queued.empty())
+            m_queued.pop_front();
+
+        sf_count_t start = 0;
+        if (FillBuffer(buffer, loop, start))
+        {
+            alSourceQueueBuffers(source, 1, &buffer);
+            m_queued.push_back(start);
+        }
+    }
+
+    if (CheckOpenALError())
+    {
+        GetLogger()->Debug("Could not update audio stream. Code: %%", GetOpenALErrorCode());
+    }
+    return !m_queued.empty();
+}
+
+void CStream::Rewind(ALuint source, float time)
+{
+    if (!m_loaded)
+        return;
+
+    alSourceStop(source);
+    alSourcei(source, AL_BUFFER, 0);
+    m_queued.clear();
+
+    std::lock_guard<std::mutex> lock{m_decodeMutex};
+    m_decoded.clear();
+    m_position = std::clamp(static_cast<sf_count_t>(time * m_sampleRate), sf_count_t{0}, m_frames);
+    m_file->Seek(m_position);
+    m_finished = false;
+}
+
+float CStream::GetDuration()
+{
+    if (!m_loaded)
+        return 0.0f;
+
+    return static_cast<float>(m_frames) / m_sampleRate;
+}
+
+float CStream::GetCurrentTime(ALuint source)
+{
+    if (!m_loaded || m_queued.empty())
+        return 0.0f;
+
+    ALfloat offset = 0.0f;
+    alGetSourcef(source, AL_SEC_OFFSET, &offset);
+    float current = static_cast<float>(m_queued.front()) / m_sampleRate + offset;
+
+    // buffer filled across the loop point
+    float duration = GetDuration();
+    if (duration > 0.0f)
+        current = std::fmod(current, duration);
+    return current;
+}
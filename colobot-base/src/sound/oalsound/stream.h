@@ -0,0 +1,109 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file stream.h
+ * \brief OpenAL streamed audio source
+ */
+
+#pragma once
+
+#include "common/resources/sndfile_wrapper.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <al.h>
+
+/**
+ * \class CStream
+ * \brief Audio file decoded incrementally into a small ring of OpenAL buffers
+ *
+ * Used for music, so that tracks don't have to be decoded whole into memory.
+ * The buffers are queued on a source and refilled with Update() as the source
+ * consumes them. Decode() can decode the next buffers ahead of time on another
+ * thread, so that Update() only has to hand them to OpenAL.
+ */
+class CStream
+{
+public:
+    //! Number of buffers in the ring
+    static constexpr int BUFFER_COUNT = 4;
+    //! Number of frames decoded into one buffer
+    static constexpr int BUFFER_FRAMES = 16384;
+
+    CStream();
+    ~CStream();
+
+    bool Open(const std::filesystem::path& filename);
+    bool IsOpen();
+
+    //! Checks that the file can be decoded, without creating any OpenAL objects
+    static bool CanDecode(const std::filesystem::path& filename);
+
+    //! Fills the buffers from the current position and queues them on \a source
+    bool Start(ALuint source, bool loop);
+    //! Decodes data for the next buffers ahead of time; doesn't use OpenAL and can run in parallel with other calls
+    void Decode(bool loop);
+    //! Refills buffers already consumed by \a source; returns false when nothing is left to play
+    bool Update(ALuint source, bool loop);
+    //! Unqueues all buffers from \a source and moves the decoder to given time
+    void Rewind(ALuint source, float time);
+
+    float GetDuration();
+    //! Returns play position of \a source within the file
+    float GetCurrentTime(ALuint source);
+
+private:
+    //! Data of one buffer
+    struct Block
+    {
+        //! Frame offset in the file at which the block starts
+        sf_count_t start = 0;
+        std::vector<int16_t> data;
+    };
+
+    //! Decodes next block; returns false at the end of file; m_decodeMutex must be locked
+    bool DecodeBlock(Block& block, bool loop);
+    //! Fills \a buffer with the next decoded block, decoding it now if Decode() didn't
+    bool FillBuffer(ALuint buffer, bool loop, sf_count_t& start);
+
+    std::unique_ptr<CSNDFileWrapper> m_file;
+    std::array<ALuint, BUFFER_COUNT> m_buffers;
+    //! Frame offsets in the file at which queued buffers start
+    std::deque<sf_count_t> m_queued;
+    //! Guards the decoder state below
+    std::mutex m_decodeMutex;
+    //! Blocks decoded ahead by Decode()
+    std::deque<Block> m_decoded;
+    //! Block being handed to OpenAL, kept to reuse its memory; only used by Start() and Update()
+    Block m_block;
+    ALenum m_format;
+    int m_channels;
+    int m_sampleRate;
+    sf_count_t m_frames;
+    sf_count_t m_position;
+    bool m_loaded;
+    bool m_finished;
+};
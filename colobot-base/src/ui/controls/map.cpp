@@ -37,6 +37,8 @@
 #include "object/interface/controllable_object.h"
 #include "object/interface/transportable_object.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
@@ -68,7 +70,7 @@ CMap::CMap() : CControl()
 
     m_half = m_terrain->GetMosaicCount() * m_terrain->GetBrickCount() * m_terrain->GetBrickSize() / 2.0f;
 
-    m_highlightRank = -1;
+    m_highlightObject = nullptr;
     m_totalFix  = 0;
     m_totalMove = 0;
     m_bRadar = false;
@@ -78,6 +80,9 @@ CMap::CMap() : CControl()
     m_mode = 0;
     m_bToy = false;
     m_bDebug = false;
+
+    m_batchIcons = false;
+    m_iconTransparency = Gfx::TransparencyMode::NONE;
 }
 
 // Object's destructor.
@@ -250,23 +255,12 @@ glm::vec2 CMap::AdjustOffset(const glm::vec2& offset)
 
 void CMap::SetHighlight(CObject* pObj)
 {
-    m_highlightRank = -1;
+    m_highlightObject = nullptr;
     if ( m_bToy || !m_fixImage.empty())
         return;  // card with still image?
-    if ( pObj == nullptr )
-        return;
 
-    for (int i = 0; i < MAPMAXOBJECT; i++)
-    {
-        if ( !m_map[i].bUsed )
-            continue;
-
-        if ( m_map[i].object == pObj )
-        {
-            m_highlightRank = i;
-            break;
-        }
-    }
+    // ranks change each time the objects are updated, so the object is looked up in Draw()
+    m_highlightObject = pObj;
 }
 
 // Detects an object in the map.
@@ -350,8 +344,27 @@ void CMap::Draw()
     if (m_fixImage.empty() && m_map[MAPMAXOBJECT - 1].bUsed)
         m_offset = AdjustOffset(m_map[MAPMAXOBJECT - 1].pos);
 
+    m_button2 = m_engine->LoadTexture("textures/interface/button2.png");
+    m_button3 = m_engine->LoadTexture("textures/interface/button3.png");
+    m_button4 = m_engine->LoadTexture("textures/interface/button4.png");
+
+    int highlightRank = -1;
+    if ( m_highlightObject != nullptr )
+    {
+        for ( i=0 ; i<MAPMAXOBJECT ; i++ )
+        {
+            if ( m_map[i].bUsed && m_map[i].object == m_highlightObject )
+            {
+                highlightRank = i;
+                break;
+            }
+        }
+    }
+
     if (m_fixImage.empty()) // drawing of the relief?
     {
+        UpdateTerrainChange();
+
         auto texture = m_engine->LoadTexture("textures/interface/map.png");
         renderer->SetTransparency(Gfx::TransparencyMode::NONE);
         renderer->SetTexture(texture);
@@ -381,27 +394,34 @@ void CMap::Draw()
     if ( m_map[i].bUsed )  // selection:
         DrawFocus(m_map[i].pos, m_map[i].dir, m_map[i].type, m_map[i].color);
 
+    // icons of other objects are collected, backgrounds are drawn before pictures,
+    // and consecutive icons of a layer with the same texture are drawn with one call
+    m_batchIcons = true;
+
     for ( i=0 ; i<m_totalFix ; i++ ) // fixed objects:
     {
-        if ( i == m_highlightRank )
+        if ( i == highlightRank )
             continue;
         DrawObject(m_map[i].pos, m_map[i].dir, m_map[i].type, m_map[i].color, false, false);
     }
 
     for ( i=MAPMAXOBJECT-2 ; i>m_totalMove ; i-- ) // moving objects:
     {
-        if ( i == m_highlightRank )
+        if ( i == highlightRank )
             continue;
         DrawObject(m_map[i].pos, m_map[i].dir, m_map[i].type, m_map[i].color, false, false);
     }
 
+    m_batchIcons = false;
+    FlushIcons();
+
     i = MAPMAXOBJECT-1;
-    if ( m_map[i].bUsed && i != m_highlightRank )  // selection:
+    if ( m_map[i].bUsed && i != highlightRank )  // selection:
         DrawObject(m_map[i].pos, m_map[i].dir, m_map[i].type, m_map[i].color, true, false);
 
-    if ( m_highlightRank != -1 && m_map[m_highlightRank].bUsed )
+    if ( highlightRank != -1 )
     {
-        i = m_highlightRank;
+        i = highlightRank;
         DrawObject(m_map[i].pos, m_map[i].dir, m_map[i].type, m_map[i].color, false, true);
         DrawHighlight(m_map[i].pos);
     }
@@ -563,8 +583,6 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
     dim.x = 2.0f/128.0f*0.75f;
     dim.y = 2.0f/128.0f;
 
-    auto renderer = m_engine->GetUIRenderer();
-
     if ( bOut )  // outside the map?
     {
         if ( color == MAPCOLOR_BBOX  && !m_bRadar )  return;
@@ -575,9 +593,7 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
             return;  // flashes
         }
 
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
 
         if ( bUp )
         {
@@ -609,7 +625,7 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
         }
         pos.x -= dim.x/2.0f;
         pos.y -= dim.y/2.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
         return;
     }
 
@@ -720,9 +736,7 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
     {
         if ( bSelect )
         {
-            auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-            renderer->SetTransparency(Gfx::TransparencyMode::NONE);
-            renderer->SetTexture(texture);
+            SetIconState(m_button2, Gfx::TransparencyMode::NONE);
 
             if ( m_bToy )
             {
@@ -748,14 +762,12 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
     {
         if ( m_bRadar )
         {
-            auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-            renderer->SetTransparency(Gfx::TransparencyMode::WHITE);
-            renderer->SetTexture(texture);
+            SetIconState(m_button2, Gfx::TransparencyMode::WHITE);
             uv1.x =  64.5f/256.0f;  // blue triangle
             uv1.y = 240.5f/256.0f;
             uv2.x =  79.0f/256.0f;
             uv2.y = 255.0f/256.0f;
-            DrawIcon(pos, dim, uv1, uv2);
+            DrawMapIcon(pos, dim, uv1, uv2);
         }
     }
 
@@ -769,58 +781,48 @@ void CMap::DrawObject(const glm::vec2& position, float dir, ObjectType type, Map
 
     if ( color == MAPCOLOR_WAYPOINTb )
     {
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
         uv1.x = 192.5f/256.0f;  // blue cross
         uv1.y = 240.5f/256.0f;
         uv2.x = 207.0f/256.0f;
         uv2.y = 255.0f/256.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
     }
     if ( color == MAPCOLOR_WAYPOINTr )
     {
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
         uv1.x = 208.5f/256.0f;  // red cross
         uv1.y = 240.5f/256.0f;
         uv2.x = 223.0f/256.0f;
         uv2.y = 255.0f/256.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
     }
     if ( color == MAPCOLOR_WAYPOINTg )
     {
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
         uv1.x = 224.5f/256.0f;  // green cross
         uv1.y = 240.5f/256.0f;
         uv2.x = 239.0f/256.0f;
         uv2.y = 255.0f/256.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
     }
     if ( color == MAPCOLOR_WAYPOINTy )
     {
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
         uv1.x = 240.5f/256.0f;  // yellow cross
         uv1.y = 240.5f/256.0f;
         uv2.x = 255.0f/256.0f;
         uv2.y = 255.0f/256.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
     }
     if ( color == MAPCOLOR_WAYPOINTv )
     {
-        auto texture = m_engine->LoadTexture("textures/interface/button2.png");
-        renderer->SetTransparency(Gfx::TransparencyMode::BLACK);
-        renderer->SetTexture(texture);
+        SetIconState(m_button2, Gfx::TransparencyMode::BLACK);
         uv1.x = 192.5f/256.0f;  // violet cross
         uv1.y = 224.5f/256.0f;
         uv2.x = 207.0f/256.0f;
         uv2.y = 239.0f/256.0f;
-        DrawIcon(pos, dim, uv1, uv2);
+        DrawMapIcon(pos, dim, uv1, uv2);
     }
 }
 
@@ -835,11 +837,7 @@ void CMap::DrawObjectIcon(const glm::vec2& pos, const glm::vec2& dim, MapColor c
 
     dp = 0.5f/256.0f;
 
-    auto renderer = m_engine->GetUIRenderer();
-
-    auto texture = m_engine->LoadTexture("textures/interface/button3.png");
-    renderer->SetTransparency(Gfx::TransparencyMode::NONE);
-    renderer->SetTexture(texture);
+    SetIconState(m_button3, Gfx::TransparencyMode::NONE);
 
     if ( color == MAPCOLOR_MOVE )
     {
@@ -862,7 +860,7 @@ void CMap::DrawObjectIcon(const glm::vec2& pos, const glm::vec2& dim, MapColor c
     uv1.y += dp;
     uv2.x -= dp;
     uv2.y -= dp;
-    DrawIcon(pos, dim, uv1, uv2);  // background colors
+    DrawMapIcon(pos, dim, uv1, uv2);  // background colors
 
     if ( bHilite )
     {
@@ -943,15 +941,12 @@ void CMap::DrawObjectIcon(const glm::vec2& pos, const glm::vec2& dim, MapColor c
             case OBJECT_MOBILEit:
             case OBJECT_MOBILErp:
             case OBJECT_MOBILEst:
-            {
-                auto texture = m_engine->LoadTexture("textures/interface/button4.png");
-                renderer->SetTexture(texture);
+                SetIconState(m_button4, Gfx::TransparencyMode::WHITE);
                 break;
-            }
-            default: ; // button3.png
+            default:
+                SetIconState(m_button3, Gfx::TransparencyMode::WHITE);
         }
 
-        renderer->SetTransparency(Gfx::TransparencyMode::WHITE);
         uv1.x = (32.0f/256.0f)*(icon%8);
         uv1.y = (32.0f/256.0f)*(icon/8);
         uv2.x = uv1.x+32.0f/256.0f;
@@ -960,7 +955,7 @@ void CMap::DrawObjectIcon(const glm::vec2& pos, const glm::vec2& dim, MapColor c
         uv1.y += dp;
         uv2.x -= dp;
         uv2.y -= dp;
-        DrawIcon(pos, dim, uv1, uv2);  // icon
+        DrawMapIcon(pos, dim, uv1, uv2, MAPLAYER_FRONT);  // icon
     }
 }
 
@@ -999,6 +994,92 @@ void CMap::DrawHighlight(const glm::vec2& position)
     DrawIcon(pos, dim, uv1, uv2);
 }
 
+// Sets texture and transparency of the following icons.
+
+void CMap::SetIconState(const Gfx::Texture& texture, Gfx::TransparencyMode mode)
+{
+    m_iconTexture = texture;
+    m_iconTransparency = mode;
+
+    if ( m_batchIcons )
+        return;
+
+    auto renderer = m_engine->GetUIRenderer();
+    renderer->SetTransparency(mode);
+    renderer->SetTexture(texture);
+}
+
+// Draws an icon of an object, or adds it to the last batch of its layer if it has the same texture,
+// so that icons of a layer are still drawn in order.
+
+void CMap::DrawMapIcon(const glm::vec2& pos, const glm::vec2& dim, const glm::vec2& uv1, const glm::vec2& uv2, MapIconLayer layer)
+{
+    if ( !m_batchIcons )
+    {
+        DrawIcon(pos, dim, uv1, uv2);
+        return;
+    }
+
+    MapIconBatches& batches = m_iconLayers[layer];
+
+    MapIconBatch* batch = nullptr;
+    if ( batches.count > 0 )
+    {
+        batch = &batches.batches[batches.count-1];
+        if ( batch->texture != m_iconTexture || batch->transparency != m_iconTransparency )
+            batch = nullptr;
+    }
+
+    if (batch == nullptr)
+    {
+        if ( batches.count == batches.batches.size() )
+            batches.batches.emplace_back();
+
+        batch = &batches.batches[batches.count++];
+        batch->texture = m_iconTexture;
+        batch->transparency = m_iconTransparency;
+    }
+
+    glm::vec2 p1 = pos;
+    glm::vec2 p2 = pos + dim;
+
+    batch->vertices.push_back({ { p1.x, p1.y }, { uv1.x, uv2.y } });
+    batch->vertices.push_back({ { p1.x, p2.y }, { uv1.x, uv1.y } });
+    batch->vertices.push_back({ { p2.x, p1.y }, { uv2.x, uv2.y } });
+    batch->vertices.push_back({ { p2.x, p2.y }, { uv2.x, uv1.y } });
+}
+
+// Draws all collected icons, layer by layer.
+
+void CMap::FlushIcons()
+{
+    auto renderer = m_engine->GetUIRenderer();
+
+    for (MapIconBatches& batches : m_iconLayers)
+    {
+        for (std::size_t i = 0; i < batches.count; i++)
+        {
+            MapIconBatch& batch = batches.batches[i];
+
+            int count = static_cast<int>(batch.vertices.size() / 4);
+            if (static_cast<int>(m_iconCounts.size()) < count)
+                m_iconCounts.resize(count, 4);
+
+            renderer->SetTransparency(batch.transparency);
+            renderer->SetTexture(batch.texture);
+
+            auto vertices = renderer->BeginPrimitives(Gfx::PrimitiveType::TRIANGLE_STRIP, count, m_iconCounts.data());
+            std::copy(batch.vertices.begin(), batch.vertices.end(), vertices);
+            renderer->EndPrimitive();
+
+            m_engine->AddStatisticTriangle(count * 2);
+            batch.vertices.clear();
+        }
+
+        batches.count = 0;
+    }
+}
+
 // Draws a triangular icon.
 
 void CMap::DrawTriangle(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& uv1, const glm::vec2& uv2)
@@ -1075,17 +1156,50 @@ void CMap::UpdateTerrain()
 {
     if (! m_fixImage.empty()) return;  // still image?
 
-    CImage img(glm::ivec2(256, 256));
+    if (m_terrainImage == nullptr)
+        m_terrainImage = std::make_unique<CImage>(glm::ivec2(256, 256));
+
+    m_terrain->ResetReliefChange();
+    UpdateTerrainImage(0, 0, 256, 256);
+
+    auto renderer = m_engine->GetUIRenderer();
+
+    m_engine->DeleteTexture("interface/map.png");
+    m_engine->LoadTexture("textures/interface/map.png", m_terrainImage.get());
 
+    auto texture = m_engine->LoadTexture("textures/interface/map.png");
+    renderer->SetTexture(texture);
+}
+
+// Updates the field in the map.
+
+void CMap::UpdateTerrain(int bx, int by, int ex, int ey)
+{
+    if (! m_fixImage.empty())  return;  // still image?
+
+    if (m_terrainImage == nullptr)
+    {
+        UpdateTerrain();
+        return;
+    }
+
+    UpdateTerrainImage(bx, by, ex, ey);
+    m_engine->CreateOrUpdateTexture("textures/interface/map.png", m_terrainImage.get());
+}
+
+// Computes the pixels of the relief image in the given range.
+
+void CMap::UpdateTerrainImage(int bx, int by, int ex, int ey)
+{
     float scale = m_terrain->GetReliefScale();
     float water = m_water->GetLevel();
 
     Gfx::Color color;
     color.a = 0.0f;
 
-    for (int y = 0; y < 256; y++)
+    for (int y = std::max(by, 0); y < std::min(ey, 256); y++)
     {
-        for (int x = 0; x < 256; x++)
+        for (int x = std::max(bx, 0); x < std::min(ex, 256); x++)
         {
             glm::vec3 pos{};
             pos.x =  (static_cast<float>(x) - 128.0f) * m_half / 128.0f;
@@ -1121,81 +1235,27 @@ void CMap::UpdateTerrain()
                 color.b = Math::Norm(m_waterColor.b + (intensity - 0.5f));
             }
 
-            img.SetPixel({ x, y }, color);
+            m_terrainImage->SetPixel({ x, y }, color);
         }
     }
-
-    auto renderer = m_engine->GetUIRenderer();
-
-    m_engine->DeleteTexture("interface/map.png");
-    m_engine->LoadTexture("textures/interface/map.png", &img);
-
-    auto texture = m_engine->LoadTexture("textures/interface/map.png");
-    renderer->SetTexture(texture);
 }
 
-// Updates the field in the map.
+// Redraws the part of the relief image modified since the last update.
 
-void CMap::UpdateTerrain(int bx, int by, int ex, int ey)
+void CMap::UpdateTerrainChange()
 {
-    Gfx::Color   color;
-    glm::vec3        pos;
-    float           scale, water, level, intensity;
-    int             x, y;
-
-    if (! m_fixImage.empty())  return;  // still image?
-
-    // TODO: map texture manipulation
-    return;
-
-    //if ( !m_engine->OpenImage("map.png") )  return;
-    //m_engine->LoadImage();
-
-    scale = m_terrain->GetReliefScale();
-    water = m_water->GetLevel();
-    color.a = 0.0f;
-
-    for ( y=by ; y<ey ; y++ )
-    {
-        for ( x=bx ; x<ex ; x++ )
-        {
-            pos.x =  (static_cast<float>(x)-128.0f)*m_half/128.0f;
-            pos.z = -(static_cast<float>(y)-128.0f)*m_half/128.0f;
-            pos.y = 0.0f;
-
-            if ( pos.x >= -m_half && pos.x <= m_half &&
-                 pos.z >= -m_half && pos.z <= m_half )
-            {
-                level = m_terrain->GetFloorLevel(pos, true)/scale;
-            }
-            else
-            {
-                level = 1000.0f;
-            }
+    glm::vec3 min, max;
+    if (!m_terrain->GetReliefChange(min, max))
+        return;
 
-            intensity = level/256.0f;
-            if ( intensity < 0.0f )  intensity = 0.0f;
-            if ( intensity > 1.0f )  intensity = 1.0f;
+    m_terrain->ResetReliefChange();
 
-            if ( level > water )  // on water?
-            {
-                color.r = m_floorColor.r + (intensity-0.5f);
-                color.g = m_floorColor.g + (intensity-0.5f);
-                color.b = m_floorColor.b + (intensity-0.5f);
-            }
-            else    // underwater?
-            {
-                color.r = m_waterColor.r + (intensity-0.5f);
-                color.g = m_waterColor.g + (intensity-0.5f);
-                color.b = m_waterColor.b + (intensity-0.5f);
-            }
-
-            //m_engine->SetDot(x, y, color);
-        }
-    }
+    int bx = static_cast<int>(std::floor(min.x * 128.0f / m_half + 128.0f));
+    int ex = static_cast<int>(std::ceil(max.x * 128.0f / m_half + 128.0f)) + 1;
+    int by = static_cast<int>(std::floor(128.0f - max.z * 128.0f / m_half));
+    int ey = static_cast<int>(std::ceil(128.0f - min.z * 128.0f / m_half)) + 1;
 
-    //m_engine->CopyImage();  // copy the ground drawing
-    //m_engine->CloseImage();
+    UpdateTerrain(bx, by, ex, ey);
 }
 
 
@@ -1213,6 +1273,105 @@ void CMap::FlushObject()
     }
 }
 
+// Returns the color of an object of given type in the map.
+
+MapColor CMap::GetObjectColor(ObjectType type)
+{
+    switch ( type )
+    {
+        case OBJECT_BASE:
+            return MAPCOLOR_BASE;
+
+        case OBJECT_DERRICK:
+        case OBJECT_FACTORY:
+        case OBJECT_STATION:
+        case OBJECT_CONVERT:
+        case OBJECT_REPAIR:
+        case OBJECT_DESTROYER:
+        case OBJECT_TOWER:
+        case OBJECT_RESEARCH:
+        case OBJECT_RADAR:
+        case OBJECT_INFO:
+        case OBJECT_ENERGY:
+        case OBJECT_LABO:
+        case OBJECT_NUCLEAR:
+        case OBJECT_PARA:
+        case OBJECT_SAFE:
+        case OBJECT_HUSTON:
+        case OBJECT_TARGET1:
+        case OBJECT_START:
+        case OBJECT_END:
+        case OBJECT_TEEN28:
+        case OBJECT_TEEN34:
+            return MAPCOLOR_FIX;  // stationary object, bottle or stone
+
+        case OBJECT_BBOX:
+        case OBJECT_KEYa:
+        case OBJECT_KEYb:
+        case OBJECT_KEYc:
+        case OBJECT_KEYd:
+            return MAPCOLOR_BBOX;
+
+        case OBJECT_HUMAN:
+        case OBJECT_MOBILEwa:
+        case OBJECT_MOBILEta:
+        case OBJECT_MOBILEfa:
+        case OBJECT_MOBILEia:
+        case OBJECT_MOBILEwb:
+        case OBJECT_MOBILEtb:
+        case OBJECT_MOBILEfb:
+        case OBJECT_MOBILEib:
+        case OBJECT_MOBILEwc:
+        case OBJECT_MOBILEtc:
+        case OBJECT_MOBILEfc:
+        case OBJECT_MOBILEic:
+        case OBJECT_MOBILEwi:
+        case OBJECT_MOBILEti:
+        case OBJECT_MOBILEfi:
+        case OBJECT_MOBILEii:
+        case OBJECT_MOBILEws:
+        case OBJECT_MOBILEts:
+        case OBJECT_MOBILEfs:
+        case OBJECT_MOBILEis:
+        case OBJECT_MOBILErt:
+        case OBJECT_MOBILErc:
+        case OBJECT_MOBILErr:
+        case OBJECT_MOBILErs:
+        case OBJECT_MOBILEsa:
+        case OBJECT_MOBILEtg:
+        case OBJECT_MOBILEwt:
+        case OBJECT_MOBILEtt:
+        case OBJECT_MOBILEft:
+        case OBJECT_MOBILEit:
+        case OBJECT_MOBILErp:
+        case OBJECT_MOBILEst:
+        case OBJECT_MOBILEdr:
+        case OBJECT_APOLLO2:
+            return MAPCOLOR_MOVE;  // moving vehicle
+
+        case OBJECT_ANT:
+        case OBJECT_BEE:
+        case OBJECT_WORM:
+        case OBJECT_SPIDER:
+            return MAPCOLOR_ALIEN;  // mobile enemy
+
+        case OBJECT_WAYPOINT:
+        case OBJECT_FLAGb:
+            return MAPCOLOR_WAYPOINTb;
+        case OBJECT_FLAGr:
+            return MAPCOLOR_WAYPOINTr;
+        case OBJECT_FLAGg:
+            return MAPCOLOR_WAYPOINTg;
+        case OBJECT_FLAGy:
+            return MAPCOLOR_WAYPOINTy;
+        case OBJECT_FLAGv:
+            return MAPCOLOR_WAYPOINTv;
+
+        default:
+            return MAPCOLOR_NULL;
+    }
+}
+
 // Updates an object in the map.
 
 void CMap::UpdateObject(CObject* pObj)
@@ -1227,6 +1386,11 @@ void CMap::UpdateObject(CObject* pObj)
     if ( m_totalFix >= m_totalMove )  return;  // full table?
 
     type = pObj->GetType();
+
+    // most objects are not shown at all, reject them before the more expensive checks
+    color = GetObjectColor(type);
+    if ( color == MAPCOLOR_NULL )  return;
+
     if ( !pObj->GetDetectable() )  return;
     if ( type != OBJECT_MOTHER   &&
          type != OBJECT_ANT      &&
@@ -1251,112 +1415,6 @@ void CMap::UpdateObject(CObject* pObj)
         dir += m_angle;
     }
 
-    color = MAPCOLOR_NULL;
-    if ( type == OBJECT_BASE )
-    {
-        color = MAPCOLOR_BASE;
-    }
-    if ( type == OBJECT_DERRICK  ||
-         type == OBJECT_FACTORY  ||
-         type == OBJECT_STATION  ||
-         type == OBJECT_CONVERT  ||
-         type == OBJECT_REPAIR   ||
-         type == OBJECT_DESTROYER||
-         type == OBJECT_TOWER    ||
-         type == OBJECT_RESEARCH ||
-         type == OBJECT_RADAR    ||
-         type == OBJECT_INFO     ||
-         type == OBJECT_ENERGY   ||
-         type == OBJECT_LABO     ||
-         type == OBJECT_NUCLEAR  ||
-         type == OBJECT_PARA     ||
-         type == OBJECT_SAFE     ||
-         type == OBJECT_HUSTON   ||
-         type == OBJECT_TARGET1  ||
-         type == OBJECT_START    ||
-         type == OBJECT_END      ||  // stationary object?
-         type == OBJECT_TEEN28    ||  // bottle?
-         type == OBJECT_TEEN34    )   // stone?
-    {
-        color = MAPCOLOR_FIX;
-    }
-    if ( type == OBJECT_BBOX ||
-         type == OBJECT_KEYa ||
-         type == OBJECT_KEYb ||
-         type == OBJECT_KEYc ||
-         type == OBJECT_KEYd )
-    {
-        color = MAPCOLOR_BBOX;
-    }
-    if ( type == OBJECT_HUMAN    ||
-         type == OBJECT_MOBILEwa ||
-         type == OBJECT_MOBILEta ||
-         type == OBJECT_MOBILEfa ||
-         type == OBJECT_MOBILEia ||
-         type == OBJECT_MOBILEwb ||
-         type == OBJECT_MOBILEtb ||
-         type == OBJECT_MOBILEfb ||
-         type == OBJECT_MOBILEib ||
-         type == OBJECT_MOBILEwc ||
-         type == OBJECT_MOBILEtc ||
-         type == OBJECT_MOBILEfc ||
-         type == OBJECT_MOBILEic ||
-         type == OBJECT_MOBILEwi ||
-         type == OBJECT_MOBILEti ||
-         type == OBJECT_MOBILEfi ||
-         type == OBJECT_MOBILEii ||
-         type == OBJECT_MOBILEws ||
-         type == OBJECT_MOBILEts ||
-         type == OBJECT_MOBILEfs ||
-         type == OBJECT_MOBILEis ||
-         type == OBJECT_MOBILErt ||
-         type == OBJECT_MOBILErc ||
-         type == OBJECT_MOBILErr ||
-         type == OBJECT_MOBILErs ||
-         type == OBJECT_MOBILEsa ||
-         type == OBJECT_MOBILEtg ||
-         type == OBJECT_MOBILEwt ||
-         type == OBJECT_MOBILEtt ||
-         type == OBJECT_MOBILEft ||
-         type == OBJECT_MOBILEit ||
-         type == OBJECT_MOBILErp ||
-         type == OBJECT_MOBILEst ||
-         type == OBJECT_MOBILEdr ||
-         type == OBJECT_APOLLO2  )  // moving vehicle?
-    {
-        color = MAPCOLOR_MOVE;
-    }
-    if ( type == OBJECT_ANT      ||
-         type == OBJECT_BEE      ||
-         type == OBJECT_WORM     ||
-         type == OBJECT_SPIDER   )  // mobile enemy?
-    {
-        color = MAPCOLOR_ALIEN;
-    }
-    if ( type == OBJECT_WAYPOINT ||
-         type == OBJECT_FLAGb    )
-    {
-        color = MAPCOLOR_WAYPOINTb;
-    }
-    if ( type == OBJECT_FLAGr )
-    {
-        color = MAPCOLOR_WAYPOINTr;
-    }
-    if ( type == OBJECT_FLAGg )
-    {
-        color = MAPCOLOR_WAYPOINTg;
-    }
-    if ( type == OBJECT_FLAGy )
-    {
-        color = MAPCOLOR_WAYPOINTy;
-    }
-    if ( type == OBJECT_FLAGv )
-    {
-        color = MAPCOLOR_WAYPOINTv;
-    }
-
-    if ( color == MAPCOLOR_NULL )  return;
-
     /*if (!m_fixImage.empty() && !m_bDebug)  // map with still image?
     {
         if ( (type == OBJECT_TEEN28 ||
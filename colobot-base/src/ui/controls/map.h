@@ -23,10 +23,18 @@
 
 #include "common/event.h"
 
+#include "graphics/core/texture.h"
+#include "graphics/core/transparency.h"
+#include "graphics/core/vertex.h"
+
 #include "object/object_type.h"
 
+#include <array>
 #include <filesystem>
+#include <memory>
+#include <vector>
 
+class CImage;
 class CObject;
 
 namespace Gfx
@@ -66,6 +74,30 @@ struct MapObject
     float       dir = 0.0f;
 };
 
+//! Layers of map icons, every layer is drawn over the previous one
+enum MapIconLayer
+{
+    MAPLAYER_BACK,      // colored backgrounds, crosses and triangles
+    MAPLAYER_FRONT,     // pictures of objects, drawn over their backgrounds
+    MAPLAYER_COUNT,
+};
+
+//! Consecutive icons of one layer sharing texture and transparency, drawn with one call
+struct MapIconBatch
+{
+    Gfx::Texture            texture;
+    Gfx::TransparencyMode   transparency = Gfx::TransparencyMode::NONE;
+    std::vector<Gfx::Vertex2D> vertices;
+};
+
+//! Icons collected for one layer
+struct MapIconBatches
+{
+    //! Batches are kept between frames to reuse their memory, only the first count are used
+    std::vector<MapIconBatch> batches;
+    std::size_t count = 0;
+};
+
 
 
 class CMap : public CControl
@@ -108,11 +140,17 @@ public:
 protected:
     glm::vec2   AdjustOffset(const glm::vec2& offset);
     void        SelectObject(const glm::vec2& pos);
+    void        UpdateTerrainImage(int bx, int by, int ex, int ey);
+    void        UpdateTerrainChange();
+    MapColor    GetObjectColor(ObjectType type);
     glm::vec2   MapInter(const glm::vec2& pos, float dir);
     void        DrawFocus(const glm::vec2& pos, float dir, ObjectType type, MapColor color);
     void        DrawObject(const glm::vec2& pos, float dir, ObjectType type, MapColor color, bool bSelect, bool bHilite);
     void        DrawObjectIcon(const glm::vec2& pos, const glm::vec2& dim, MapColor color, ObjectType type, bool bHilite);
     void        DrawHighlight(const glm::vec2& pos);
+    void        SetIconState(const Gfx::Texture& texture, Gfx::TransparencyMode mode);
+    void        DrawMapIcon(const glm::vec2& pos, const glm::vec2& dim, const glm::vec2& uv1, const glm::vec2& uv2, MapIconLayer layer = MAPLAYER_BACK);
+    void        FlushIcons();
     void        DrawTriangle(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& uv1, const glm::vec2& uv2);
     void        DrawPenta(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& p4, const glm::vec2& p5, const glm::vec2& uv1, const glm::vec2& uv2);
     void        DrawVertex(const glm::vec2& uv1, const glm::vec2& uv2, float zoom);
@@ -133,7 +171,7 @@ protected:
     MapObject       m_map[MAPMAXOBJECT];
     int             m_totalFix;
     int             m_totalMove;
-    int             m_highlightRank;
+    CObject*        m_highlightObject;
     glm::vec2       m_mapPos;
     glm::vec2       m_mapDim;
     bool            m_bRadar;
@@ -141,6 +179,21 @@ protected:
     int             m_mode;
     bool            m_bToy;
     bool            m_bDebug;
+
+    //! Relief image of the map, kept until the terrain changes
+    std::unique_ptr<CImage> m_terrainImage;
+
+    //! Interface textures loaded once per Draw()
+    Gfx::Texture    m_button2;
+    Gfx::Texture    m_button3;
+    Gfx::Texture    m_button4;
+
+    //! true means icons are collected in m_iconLayers instead of drawn right away
+    bool            m_batchIcons;
+    Gfx::Texture    m_iconTexture;
+    Gfx::TransparencyMode m_iconTransparency;
+    std::array<MapIconBatches, MAPLAYER_COUNT> m_iconLayers;
+    std::vector<int> m_iconCounts;
 };
 
 
@@ -22,9 +22,13 @@
 #include "app/app.h"
 
 #include "common/event.h"
+#include "common/logger.h"
+#include "common/profiler.h"
 #include "common/stringutils.h"
 #include "common/global.h"
 
+#include "common/resources/outputstream.h"
+
 #include "graphics/engine/engine.h"
 #include "graphics/engine/lightning.h"
 #include "graphics/engine/terrain.h"
@@ -109,6 +113,8 @@ void CDebugMenu::CreateInterface()
     pc = pw->CreateCheck(pos, ddim, -1, EVENT_DBG_STATS);
     pc->SetName("Display stats");
     pos.y -= 0.048f;
+    pc = pw->CreateCheck(pos, ddim, -1, EVENT_DBG_PROFILER);
+    pc->SetName("Record profiler trace");
     pos.y -= 0.048f;
     pc = pw->CreateCheck(pos, ddim, -1, EVENT_DBG_RESOURCES);
     pc->SetName("Underground resources");
@@ -226,6 +232,12 @@ void CDebugMenu::UpdateInterface()
         pc->SetState(STATE_CHECK, m_engine->GetShowStats());
     }
 
+    pc = static_cast<CCheck*>(pw->SearchControl(EVENT_DBG_PROFILER));
+    if (pc != nullptr)
+    {
+        pc->SetState(STATE_CHECK, CProfiler::GetTraceEnabled());
+    }
+
     pc = static_cast<CCheck*>(pw->SearchControl(EVENT_DBG_RESOURCES));
     if (pc != nullptr)
     {
@@ -275,6 +287,13 @@ bool CDebugMenu::EventProcess(const Event &event)
             UpdateInterface();
             break;
 
+        case EVENT_DBG_PROFILER:
+            if (CProfiler::GetTraceEnabled())
+                DumpProfilerTrace();
+            CProfiler::SetTraceEnabled(!CProfiler::GetTraceEnabled());
+            UpdateInterface();
+            break;
+
         case EVENT_DBG_SPAWN_OBJ:
             DestroyInterface();
             CreateSpawnInterface();
@@ -483,6 +502,19 @@ bool CDebugMenu::HandleCopy(const glm::vec2& mousePos)
     return true;
 }
 
+void CDebugMenu::DumpProfilerTrace()
+{
+    COutputStream stream("profile.json");
+    if (!stream.is_open())
+    {
+        GetLogger()->Error("Could not write profiler trace");
+        return;
+    }
+
+    CProfiler::WriteChromeTrace(stream);
+    GetLogger()->Info("Profiler trace of last %% frames written to profile.json", CProfiler::GetFrameCount());
+}
+
 bool CDebugMenu::IsActive()
 {
     return m_interface->SearchControl(EVENT_WINDOW7) != nullptr;
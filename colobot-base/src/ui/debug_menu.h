@@ -86,6 +86,8 @@ protected:
     //! Handle ctrl+c (copy coordinates under cursor to clipboard)
     //! \return true on success, false on error
     bool HandleCopy(const glm::vec2& mousePos);
+    //! Writes recorded profiler frames to profile.json in save directory
+    void DumpProfilerTrace();
 
 protected:
     CRobotMain* m_main;
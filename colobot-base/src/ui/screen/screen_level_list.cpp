@@ -26,6 +26,7 @@
 
 #include "common/resources/resourcemanager.h"
 
+#include "level/level_index.h"
 #include "level/player_profile.h"
 
 #include "level/parser/parser.h"
@@ -428,9 +429,8 @@ void CScreenLevelList::UpdateSceneChap(int &chap)
         {
             try
             {
-                CLevelParser levelParser("custom", j+1, 0);
-                levelParser.Load();
-                pl->SetItemName(j, levelParser.Get("Title")->GetParam("text")->AsString());
+                LevelInfo info = LevelIndex::GetLevelInfo(CLevelParser::BuildScenePath("custom", j+1, 0));
+                pl->SetItemName(j, info.title);
                 pl->SetEnable(j, true);
             }
             catch (CLevelParserException& e)
@@ -449,8 +449,8 @@ void CScreenLevelList::UpdateSceneChap(int &chap)
                 break;
             try
             {
-                levelParser.Load();
-                snprintf(line.data(), line.size(), "%d: %s", j+1, levelParser.Get("Title")->GetParam("text")->AsString().c_str());
+                LevelInfo info = LevelIndex::GetLevelInfo(levelParser.GetFilename());
+                snprintf(line.data(), line.size(), "%d: %s", j+1, info.title.c_str());
             }
             catch (CLevelParserException& e)
             {
@@ -476,6 +476,8 @@ void CScreenLevelList::UpdateSceneChap(int &chap)
         }
     }
 
+    LevelIndex::Save();
+
     if ( chap > j-1 )  chap = j-1;
 
     pl->SetSelect(chap);
@@ -516,8 +518,8 @@ void CScreenLevelList::UpdateSceneList(int chap, int &sel)
         }
         try
         {
-            levelParser.Load();
-            snprintf(line.data(), line.size(), "%d: %s", j+1, levelParser.Get("Title")->GetParam("text")->AsString().c_str());
+            LevelInfo info = LevelIndex::GetLevelInfo(levelParser.GetFilename());
+            snprintf(line.data(), line.size(), "%d: %s", j+1, info.title.c_str());
         }
         catch (CLevelParserException& e)
         {
@@ -535,6 +537,8 @@ void CScreenLevelList::UpdateSceneList(int chap, int &sel)
         }
     }
 
+    LevelIndex::Save();
+
     if (readAll)
     {
         m_maxList = j;
@@ -620,9 +624,8 @@ void CScreenLevelList::UpdateSceneResume(int chap, int rank)
 
     try
     {
-        CLevelParser levelParser(m_category, chap, rank);
-        levelParser.Load();
-        pe->SetText(levelParser.Get("Resume")->GetParam("text")->AsString().c_str());
+        LevelInfo info = LevelIndex::GetLevelInfo(CLevelParser::BuildScenePath(m_category, chap, rank));
+        pe->SetText(info.resume.c_str());
     }
     catch (CLevelParserException& e)
     {
@@ -248,6 +248,12 @@ bool CStudio::EventProcess(const Event &event)
         m_script->Step();
     }
 
+    if ( event.type == EVENT_STUDIO_PROFILE )  // profiling?
+    {
+        m_script->SetProfiling(!m_script->GetProfiling());
+        UpdateButtons();
+    }
+
     if ( event.type == EVENT_WINDOW3 )  // window is moved?
     {
         m_editActualPos = m_editFinalPos = pw->GetPos();
@@ -376,9 +382,16 @@ bool CStudio::EventFrame(const Event &event)
         m_bRunning = false;
         UpdateFlux();  // stop
         AdjustEditScript();
-        std::string res;
-        GetResource(RES_TEXT, RT_STUDIO_PROGSTOP, res);
-        SetInfoText(res, false);
+        if ( m_script->GetProfiling() )
+        {
+            m_script->UpdateProfileList(list);  // keeps the statistics of the finished run
+        }
+        else
+        {
+            std::string res;
+            GetResource(RES_TEXT, RT_STUDIO_PROGSTOP, res);
+            SetInfoText(res, false);
+        }
 
         m_event->AddEvent(Event(EVENT_OBJECT_PROGSTOP));
     }
@@ -402,7 +415,14 @@ bool CStudio::EventFrame(const Event &event)
             edit->ShowSelect();
         }
 
-        m_script->UpdateList(list);  // updates the list of variables
+        if ( m_script->GetProfiling() )
+        {
+            m_script->UpdateProfileList(list);  // updates the execution statistics
+        }
+        else
+        {
+            m_script->UpdateList(list);  // updates the list of variables
+        }
     }
     else
     {
@@ -684,6 +704,8 @@ void CStudio::StartEditScript(CScript *script, std::string name, Program* progra
     button->SetState(STATE_SHADOW);
     button = pw->CreateButton(pos, dim, 64+29, EVENT_STUDIO_STEP);
     button->SetState(STATE_SHADOW);
+    button = pw->CreateButton(pos, dim, 64+30, EVENT_STUDIO_PROFILE);
+    button->SetState(STATE_SHADOW);
 
     if (!m_program->runnable)
     {
@@ -895,6 +917,13 @@ void CStudio::AdjustEditScript()
         button->SetPos(pos);
         button->SetDim(dim);
     }
+    pos.x = wpos.x+0.28f+dim.x*4;
+    button = static_cast< CButton* >(pw->SearchControl(EVENT_STUDIO_PROFILE));
+    if ( button != nullptr )
+    {
+        button->SetPos(pos);
+        button->SetDim(dim);
+    }
 }
 
 // Ends edition of a program.
@@ -1197,6 +1226,10 @@ void CStudio::UpdateButtons()
     if ( button == nullptr )  return;
     button->SetState(STATE_ENABLE, (m_bRunning && !m_bRealTime && !m_script->IsContinue()));
 
+    button = static_cast< CButton* >(pw->SearchControl(EVENT_STUDIO_PROFILE));
+    if ( button == nullptr )  return;
+    button->SetState(STATE_CHECK, m_script->GetProfiling());
+
 
     button = static_cast< CButton* >(pw->SearchControl(EVENT_STUDIO_NEW));
     if ( button == nullptr )  return;
@@ -0,0 +1,245 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotClass.h"
+#include "CBot/CBotContext.h"
+#include "CBot/CBotProgram.h"
+#include "CBot/CBotSymbolTable.h"
+#include "CBot/CBotToken.h"
+
+#include "CBot/CBotVar/CBotVarClass.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CBot;
+
+class CBotContextUT : public testing::Test
+{
+public:
+    CBotContextUT()
+    {
+        CBotProgram::Init();
+        CBotProgram::AddFunction("RESULT", rResult, cResult);
+    }
+
+    ~CBotContextUT()
+    {
+        CBotProgram::Free();
+    }
+
+protected:
+    //! Compiles and runs function "Test" of given program, returns value passed to RESULT() or -1
+    static int Run(CBotProgram& program, const std::string& code)
+    {
+        std::vector<std::string> externFunctions;
+        if (!program.Compile(code, externFunctions)) return -1;
+        if (!program.Start("Test")) return -1;
+
+        int result = -1;
+        while (!program.Run(&result, 10));
+        if (program.GetError() != CBotNoErr) return -1;
+        return result;
+    }
+
+private:
+    static CBotTypResult cResult(CBotVar* &var, void* user)
+    {
+        if (var == nullptr) return CBotTypResult(CBotErrLowParam);
+        if (var->GetType() > CBotTypDouble) return CBotTypResult(CBotErrBadNum);
+        var = var->GetNext();
+        if (var != nullptr) return CBotTypResult(CBotErrOverParam);
+        return CBotTypResult(CBotTypVoid);
+    }
+
+    static bool rResult(CBotVar* var, CBotVar* result, int& exception, void* user)
+    {
+        *static_cast<int*>(user) = var->GetValInt();
+        return true;
+    }
+};
+
+TEST_F(CBotContextUT, PublicDefinitionsAreIsolated)
+{
+    const std::string library =
+        "public class Counter\n"
+        "{\n"
+        "    int value = VALUE;\n"
+        "}\n"
+        "public int Twice(int x) { return 2 * x; }\n";
+    const std::string user =
+        "extern void Test()\n"
+        "{\n"
+        "    Counter c();\n"
+        "    RESULT(Twice(c.value));\n"
+        "}\n";
+
+    CBotContext first, second;
+    EXPECT_TRUE(first.DefineNum("VALUE", 1));
+    EXPECT_TRUE(second.DefineNum("VALUE", 10));
+
+    CBotProgram firstLibrary(first), secondLibrary(second);
+    CBotProgram firstUser(first), secondUser(second);
+    EXPECT_EQ(Run(firstLibrary, library + "extern void Test() { RESULT(0); }\n"), 0);
+    EXPECT_EQ(Run(secondLibrary, library + "extern void Test() { RESULT(0); }\n"), 0);
+
+    EXPECT_EQ(Run(firstUser, user), 2);
+    EXPECT_EQ(Run(secondUser, user), 20);
+
+    // nothing leaked to the global context
+    CBotProgram global;
+    EXPECT_EQ(Run(global, user), -1);
+    long value;
+    EXPECT_FALSE(CBotContext::GetGlobal().FindDefineNum("VALUE", value));
+}
+
+TEST_F(CBotContextUT, GlobalDefinitionsAreShared)
+{
+    CBotContext context;
+    EXPECT_FALSE(context.DefineNum("CBotErrZeroDiv", 1));
+
+    CBotProgram program(context);
+    EXPECT_EQ(Run(program, "extern void Test() { RESULT(CBotErrZeroDiv); }"), CBotErrZeroDiv);
+}
+
+TEST_F(CBotContextUT, SymbolsArePerContext)
+{
+    CBotContext first, second;
+    CBotTokenUPtr firstTokens, secondTokens;
+    {
+        CBotContext::Scope scope(first);
+        firstTokens = CBotToken::CompileTokens("alpha beta");
+    }
+    {
+        CBotContext::Scope scope(second);
+        secondTokens = CBotToken::CompileTokens("beta");
+    }
+    ASSERT_TRUE(firstTokens != nullptr && secondTokens != nullptr);
+
+    CBotToken* firstAlpha = firstTokens->GetNext();
+    CBotToken* firstBeta = firstAlpha->GetNext();
+    CBotToken* secondBeta = secondTokens->GetNext();
+
+    EXPECT_NE(first.GetSymbols().GetId(), second.GetSymbols().GetId());
+    EXPECT_EQ(first.GetSymbols().Find("beta"), firstBeta->GetSymbol());
+    EXPECT_EQ(second.GetSymbols().Find("beta"), secondBeta->GetSymbol());
+    EXPECT_EQ(second.GetSymbols().Find("alpha"), CBotSymbolTable::NO_SYMBOL);
+
+    // both tables give their first identifier the same symbol, tokens of different tables compare by text
+    EXPECT_EQ(firstAlpha->GetSymbol(), secondBeta->GetSymbol());
+    EXPECT_FALSE(firstAlpha->HasSameName(*secondBeta));
+    EXPECT_TRUE(firstBeta->HasSameName(*secondBeta));
+}
+
+TEST_F(CBotContextUT, ConcurrentPrograms)
+{
+    const std::string library =
+        "public class Node\n"
+        "{\n"
+        "    int value;\n"
+        "    Node next;\n"
+        "}\n"
+        "public int Fib(int n) { if (n < 2) return n; return Fib(n - 1) + Fib(n - 2); }\n"
+        "extern void Test() { RESULT(0); }\n";
+    const std::string user =
+        "extern void Test()\n"
+        "{\n"
+        "    Node list = null;\n"
+        "    for (int i = 0; i < 50; i++)\n"
+        "    {\n"
+        "        Node n = new Node();\n"
+        "        n.value = i;\n"
+        "        n.next = list;\n"
+        "        list = n;\n"
+        "    }\n"
+        "    int sum = 0;\n"
+        "    string text = \"\";\n"
+        "    while (list != null)\n"
+        "    {\n"
+        "        sum += list.value;\n"
+        "        text += \"x\";\n"
+        "        list = list.next;\n"
+        "    }\n"
+        "    RESULT(sum + strlen(text) + Fib(12) + OFFSET);\n"
+        "}\n";
+    const int expected = 1225 + 50 + 144;
+
+    constexpr int threadCount = 8;
+    constexpr int iterations = 20;
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                CBotContext context;
+                context.DefineNum("OFFSET", t);
+                CBotProgram libraryProgram(context);
+                CBotProgram userProgram(context);
+                if (Run(libraryProgram, library) != 0 || Run(userProgram, user) != expected + t)
+                    ++failures;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(failures, 0);
+}
+
+TEST_F(CBotContextUT, InstancesAreFoundByIdentifier)
+{
+    CBotContext context;
+    CBotContext::Scope scope(context);
+    CBotClass* itemClass = CBotClass::Create("Item", nullptr);
+
+    std::vector<std::unique_ptr<CBotVar>> items;
+    for (int i = 0; i < 100; ++i)
+    {
+        items.emplace_back(CBotVar::Create("", CBotTypResult(CBotTypClass, itemClass)));
+        items.back()->SetIdent(1000 + i);
+    }
+
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(context.FindInstance(1000 + i), items[i]->GetPointer());
+
+    // an instance can be found under its new identifier only
+    CBotVarClass* first = items[0]->GetPointer();
+    first->SetIdent(-5);
+    EXPECT_EQ(context.FindInstance(-5), first);
+    EXPECT_EQ(context.FindInstance(1000), nullptr);
+
+    // with two instances sharing an identifier, either one is found until both are gone
+    CBotVarClass* second = items[1]->GetPointer();
+    second->SetIdent(-5);
+    items[0].reset();
+    EXPECT_EQ(context.FindInstance(-5), second);
+    items[1].reset();
+    EXPECT_EQ(context.FindInstance(-5), nullptr);
+
+    items.clear();
+    EXPECT_EQ(CBotContext::GetGlobal().FindInstance(-5), nullptr);
+}
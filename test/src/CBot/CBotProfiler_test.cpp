@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotProfiler.h"
+#include "CBot/CBotProgram.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace CBot;
+
+class CBotProfilerUT : public testing::Test
+{
+public:
+    CBotProfilerUT()
+    {
+        CBotProgram::Init();
+    }
+
+    ~CBotProfilerUT()
+    {
+        CBotProgram::Free();
+    }
+
+protected:
+    std::unique_ptr<CBotProgram> Run(const std::string& code, int timer = -1)
+    {
+        auto program = std::make_unique<CBotProgram>();
+        std::vector<std::string> externFunctions;
+        EXPECT_TRUE(program->Compile(code, externFunctions));
+        EXPECT_EQ(externFunctions.size(), 1u);
+
+        program->SetProfiling(true);
+        EXPECT_TRUE(program->Start(externFunctions[0]));
+        while (!program->Run(nullptr, timer));
+        EXPECT_EQ(program->GetError(), CBotNoErr);
+        return program;
+    }
+
+    static const CBotProfileEntry* Find(const std::vector<CBotProfileEntry>& entries, const std::string& function)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(), [&](const CBotProfileEntry& e) { return e.function == function; });
+        return it != entries.end() ? &(*it) : nullptr;
+    }
+};
+
+TEST_F(CBotProfilerUT, DisabledByDefault)
+{
+    CBotProgram program;
+    EXPECT_FALSE(program.GetProfiling());
+    EXPECT_EQ(program.GetProfiler(), nullptr);
+}
+
+TEST_F(CBotProfilerUT, CountsByFunction)
+{
+    auto program = Run(
+        "void Heavy()\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for (int i = 0; i < 1000; i++) sum += i;\n"
+        "}\n"
+        "void Light()\n"
+        "{\n"
+        "    int x = 1;\n"
+        "}\n"
+        "extern void Test()\n"
+        "{\n"
+        "    Heavy();\n"
+        "    Light();\n"
+        "}\n");
+
+    auto functions = program->GetProfiler()->GetFunctions();
+    const CBotProfileEntry* heavy = Find(functions, "Heavy");
+    const CBotProfileEntry* light = Find(functions, "Light");
+    ASSERT_NE(heavy, nullptr);
+    ASSERT_NE(light, nullptr);
+    EXPECT_GT(heavy->instructions, 1000);
+    EXPECT_GT(heavy->instructions, 10 * light->instructions);
+    EXPECT_GT(light->allocations, 0);
+    EXPECT_EQ(functions.front().function, "Heavy");
+
+    CBotProfileEntry total = program->GetProfiler()->GetTotal();
+    long sum = 0;
+    for (const auto& entry : functions) sum += entry.instructions;
+    EXPECT_EQ(total.instructions, sum);
+}
+
+TEST_F(CBotProfilerUT, HottestPositionIsInLoop)
+{
+    std::string code =
+        "extern void Test()\n"
+        "{\n"
+        "    float sum = 0;\n"
+        "    for (int i = 0; i < 1000; i++)\n"
+        "    {\n"
+        "        sum = sum + i * 2;\n"
+        "    }\n"
+        "}\n";
+    auto program = Run(code, 50);
+
+    auto positions = program->GetProfiler()->GetPositions();
+    ASSERT_FALSE(positions.empty());
+    int loopStart = code.find("for");
+    int loopEnd = code.rfind('}');
+    EXPECT_GE(positions.front().start, loopStart);
+    EXPECT_LT(positions.front().start, loopEnd);
+
+    std::stringstream report;
+    program->GetProfiler()->Dump(report, code);
+    EXPECT_NE(report.str().find("Test:"), std::string::npos);
+}
+
+TEST_F(CBotProfilerUT, ClearedOnRecompile)
+{
+    auto program = Run("extern void Test() { int a = 1; }");
+    EXPECT_GT(program->GetProfiler()->GetTotal().instructions, 0);
+
+    std::vector<std::string> externFunctions;
+    ASSERT_TRUE(program->Compile("extern void Test() { int a = 1; }", externFunctions));
+    EXPECT_EQ(program->GetProfiler()->GetTotal().instructions, 0);
+    EXPECT_TRUE(program->GetProfiler()->GetPositions().empty());
+}
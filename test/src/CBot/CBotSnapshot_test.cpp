@@ -0,0 +1,189 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotContext.h"
+#include "CBot/CBotFileUtils.h"
+#include "CBot/CBotProgram.h"
+#include "CBot/CBotSnapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CBot;
+
+class CBotSnapshotUT : public testing::Test
+{
+public:
+    CBotSnapshotUT()
+    {
+        CBotProgram::Init();
+    }
+
+    ~CBotSnapshotUT()
+    {
+        CBotProgram::Free();
+    }
+
+protected:
+    static bool ReadText(const CBotSnapshot::Record& record, std::string& text)
+    {
+        return record.Read([&](std::istream& istr) { return ReadString(istr, text); });
+    }
+};
+
+TEST_F(CBotSnapshotUT, RecordsRoundTrip)
+{
+    CBotSnapshot snapshot;
+    EXPECT_TRUE(WriteString(snapshot.BeginRecord(1), "first"));
+    snapshot.EndRecord();
+    EXPECT_TRUE(WriteString(snapshot.BeginRecord(2), "failed"));
+    snapshot.CancelRecord();
+    EXPECT_TRUE(WriteString(snapshot.BeginRecord(-1), "static"));
+    snapshot.EndRecord();
+
+    std::stringstream stream;
+    EXPECT_TRUE(snapshot.Write(stream));
+    EXPECT_TRUE(WriteString(stream, "after"));
+
+    CBotSnapshot loaded;
+    EXPECT_TRUE(loaded.Read(stream));
+
+    std::string text;
+    EXPECT_TRUE(ReadText(loaded.GetRecord(1), text));
+    EXPECT_EQ(text, "first");
+    EXPECT_TRUE(ReadText(loaded.GetRecord(-1), text));
+    EXPECT_EQ(text, "static");
+    EXPECT_TRUE(loaded.GetRecord(2).IsEmpty());
+
+    // the snapshot is length-prefixed, data after it stays in the stream
+    EXPECT_TRUE(ReadString(stream, text));
+    EXPECT_EQ(text, "after");
+}
+
+TEST_F(CBotSnapshotUT, RecordsOutliveSnapshot)
+{
+    CBotSnapshot snapshot;
+    EXPECT_TRUE(WriteString(snapshot.BeginRecord(7), "robot"));
+    snapshot.EndRecord();
+    std::stringstream stream;
+    EXPECT_TRUE(snapshot.Write(stream));
+
+    CBotSnapshot loaded;
+    EXPECT_TRUE(loaded.Read(stream));
+    CBotSnapshot::Record record = loaded.GetRecord(7);
+
+    // records are copies, so saving again doesn't change them
+    loaded.Clear();
+    EXPECT_TRUE(WriteString(loaded.BeginRecord(7), "other"));
+    loaded.EndRecord();
+
+    std::string text;
+    EXPECT_TRUE(ReadText(record, text));
+    EXPECT_EQ(text, "robot");
+}
+
+TEST_F(CBotSnapshotUT, ReadingPastRecordFails)
+{
+    CBotSnapshot snapshot;
+    EXPECT_TRUE(WriteLong(snapshot.BeginRecord(1), 42));
+    snapshot.EndRecord();
+    std::stringstream stream;
+    EXPECT_TRUE(snapshot.Write(stream));
+
+    CBotSnapshot loaded;
+    EXPECT_TRUE(loaded.Read(stream));
+    EXPECT_FALSE(loaded.GetRecord(1).Read([](std::istream& istr)
+    {
+        long first, second;
+        return ReadLong(istr, first) && ReadLong(istr, second);
+    }));
+}
+
+TEST_F(CBotSnapshotUT, BadSnapshotsAreRejected)
+{
+    CBotSnapshot snapshot;
+    std::stringstream stream;
+    EXPECT_TRUE(snapshot.Write(stream));
+    std::string data = stream.str();
+
+    std::string badMagic = data;
+    badMagic[0] = 'X';
+    std::stringstream badMagicStream(badMagic);
+    EXPECT_FALSE(snapshot.Read(badMagicStream));
+
+    std::string badVersion = data;
+    badVersion[8] ^= 1; // CBot version
+    std::stringstream badVersionStream(badVersion);
+    EXPECT_FALSE(snapshot.Read(badVersionStream));
+
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_FALSE(snapshot.Read(truncated));
+}
+
+TEST_F(CBotSnapshotUT, ProgramStateRoundTrip)
+{
+    const std::string code =
+        "public class Counter { int value = 0; }\n"
+        "extern void Test()\n"
+        "{\n"
+        "    Counter counter = new Counter();\n"
+        "    string text = \"\";\n"
+        "    for (int i = 0; i < 100; i++)\n"
+        "    {\n"
+        "        counter.value += i;\n"
+        "        text += \"x\";\n"
+        "    }\n"
+        "    if (counter.value != 4950 || strlen(text) != 100) 1 / 0;\n"
+        "}\n";
+
+    CBotContext context;
+    CBotSnapshot snapshot;
+    std::stringstream stream;
+    std::vector<std::string> externFunctions;
+    {
+        CBotProgram program(context);
+        ASSERT_TRUE(program.Compile(code, externFunctions));
+        ASSERT_TRUE(program.Start("Test"));
+        EXPECT_FALSE(program.Run(nullptr, 50));
+
+        CBotContext::Scope scope(context);
+        EXPECT_TRUE(program.SaveState(snapshot.BeginRecord(1)));
+        snapshot.EndRecord();
+        EXPECT_TRUE(snapshot.Write(stream));
+        program.Stop();
+    }
+
+    CBotProgram program(context);
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+
+    CBotSnapshot loaded;
+    {
+        CBotContext::Scope scope(context);
+        long last = context.GetLastUniqNum();
+        EXPECT_TRUE(loaded.Read(stream));
+        EXPECT_GE(context.GetLastUniqNum(), last);
+    }
+    EXPECT_TRUE(loaded.GetRecord(1).Read([&](std::istream& istr) { return program.RestoreState(istr); }));
+
+    while (!program.Run(nullptr, 50));
+    EXPECT_EQ(program.GetError(), CBotNoErr);
+}
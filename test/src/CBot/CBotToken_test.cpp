@@ -18,7 +18,9 @@
  */
 
 #include "CBot/CBotToken.h"
+#include "CBot/CBotContext.h"
 #include "CBot/CBotProgram.h"
+#include "CBot/CBotSymbolTable.h"
 
 #include <gtest/gtest.h>
 
@@ -122,3 +124,53 @@ TEST_F(CBotTokenUT, BasicProgram)
         {"}",           ID_CLBLK},
     });
 }
+
+TEST_F(CBotTokenUT, StoredTokens)
+{
+    auto tokens = CBotToken::CompileTokens("int count = count + total; CBotErrZeroDiv");
+    ASSERT_TRUE(tokens != nullptr);
+
+    std::vector<CBotToken*> list;
+    for (CBotToken* token = tokens->GetNext(); token != nullptr; token = token->GetNext())
+    {
+        ASSERT_EQ(token->GetPrev(), list.empty() ? tokens.get() : list.back());
+        list.push_back(token);
+    }
+    ASSERT_EQ(list.size(), 9u); // including the terminator token
+
+    EXPECT_EQ(list[0]->GetType(), ID_INT);
+    EXPECT_EQ(list[1]->GetString(), "count");
+    EXPECT_EQ(list[5]->GetString(), "total");
+    EXPECT_EQ(list[5]->GetType(), TokenTypVar);
+
+    EXPECT_EQ(list[7]->GetType(), TokenTypDef);
+    EXPECT_EQ(list[7]->GetKeywordId(), CBotErrZeroDiv);
+    EXPECT_EQ(list[8]->GetType(), TokenTypNone);
+}
+
+TEST_F(CBotTokenUT, IdentifierSymbols)
+{
+    auto tokens = CBotToken::CompileTokens("int count = count + total;");
+    ASSERT_TRUE(tokens != nullptr);
+
+    std::vector<CBotToken*> list;
+    for (CBotToken* token = tokens->GetNext(); token != nullptr; token = token->GetNext())
+        list.push_back(token);
+    ASSERT_EQ(list.size(), 8u); // including the terminator token
+
+    const CBotSymbolTable& symbols = CBotContext::GetCurrent().GetSymbols();
+    EXPECT_EQ(list[0]->GetType(), ID_INT);
+    EXPECT_EQ(list[2]->GetSymbol(), CBotSymbolTable::NO_SYMBOL);
+    EXPECT_NE(list[1]->GetSymbol(), CBotSymbolTable::NO_SYMBOL);
+    EXPECT_EQ(list[1]->GetSymbol(), list[3]->GetSymbol());
+    EXPECT_NE(list[1]->GetSymbol(), list[5]->GetSymbol());
+    EXPECT_EQ(symbols.GetText(list[5]->GetSymbol()), "total");
+    EXPECT_EQ(symbols.Find("total"), list[5]->GetSymbol());
+
+    // tokens created from text compare by text
+    CBotToken copy(*list[1]);
+    CBotToken named("count");
+    EXPECT_TRUE(named.HasSameName(*list[1]));
+    EXPECT_TRUE(copy.HasSameName(*list[3]));
+    EXPECT_FALSE(copy.HasSameName(*list[5]));
+}
@@ -2013,6 +2013,59 @@ TEST_F(CBotUT, StringFunctions)
     )");
 }
 
+TEST_F(CBotUT, StringSharedText)
+{
+    ExecuteTest(R"(
+        void Append(string s)
+        {
+            s += "?";
+            ASSERT(s == "abc?");
+        }
+        extern void AppendToCopies()
+        {
+            string a = "ab";
+            string b = a;
+            a += "c";
+            b += "d";
+            ASSERT(a == "abc");
+            ASSERT(b == "abd");
+            string c = a;
+            Append(c);
+            a = a + "!";
+            ASSERT(a == "abc!");
+            ASSERT(c == "abc");
+            a = a + a;
+            ASSERT(a == "abc!abc!");
+        }
+        extern void AppendToSubstrings()
+        {
+            string s = "Colobot";
+            string left = strleft(s, 4);
+            string mid = strmid(s, 2, 3);
+            left += "ny";
+            mid += "!";
+            s += " Gold";
+            ASSERT(left == "Colony");
+            ASSERT(mid == "lob!");
+            ASSERT(s == "Colobot Gold");
+            ASSERT(strmid(strmid(s, 2), 2, 3) == "bot");
+            ASSERT(strlen(strright(s, 4)) == 4);
+        }
+        extern void AppendInLoop()
+        {
+            string line = "";
+            string lines[];
+            for (int i = 0; i < 10; i++)
+            {
+                line += i;
+                lines[i] = line;
+            }
+            ASSERT(lines[3] == "0123");
+            ASSERT(lines[9] == "0123456789");
+        }
+    )");
+}
+
 TEST_F(CBotUT, LiteralCharacters)
 {
     ExecuteTest(R"(
@@ -3670,3 +3723,60 @@ TEST_F(CBotUT, TestByteToString) {
         }
     )");
 }
+
+TEST_F(CBotUT, ResumeInNestedLists)
+{
+    // every test runs in step mode, this one checks that execution continues
+    // at the right statement of long blocks, switch cases and declaration lists
+    ExecuteTest(R"(
+        extern void ResumeInNestedLists() {
+            int[] expected = {123458, 12458, 12678, 12678};
+            int trace = 0;
+            for (int i = 0; i < 4; ++i) {
+                trace = trace * 10 + 1;
+                {
+                    int a = i, b = a + 1, c = b + 1;
+                    trace = trace * 10 + c - i;
+                    switch (i) {
+                        case 0:
+                            trace = trace * 10 + 3;
+                        case 1:
+                            trace = trace * 10 + 4;
+                            trace = trace * 10 + 5;
+                            break;
+                        default:
+                            trace = trace * 10 + 6;
+                            trace = trace * 10 + 7;
+                    }
+                }
+                trace = trace * 10 + 8;
+                ASSERT(trace == expected[i]);
+                trace = 0;
+            }
+        }
+    )");
+}
+
+TEST_F(CBotUT, TimerUsedByRun)
+{
+    auto program = std::make_unique<CBotProgram>();
+    std::vector<std::string> externFunctions;
+    ASSERT_TRUE(program->Compile(R"(
+        extern void TimerUsedByRun() {
+            int sum = 0;
+            for (int i = 0; i < 1000; ++i) sum += i;
+        }
+    )", externFunctions));
+    ASSERT_TRUE(program->Start("TimerUsedByRun"));
+
+    // a suspended run uses its whole timer, with a small overflow allowed
+    ASSERT_FALSE(program->Run(nullptr, 100));
+    EXPECT_GE(program->GetTimerUsed(), 100);
+    EXPECT_LE(program->GetTimerUsed(), 110);
+
+    int runs = 1;
+    while (!program->Run(nullptr, 100)) ++runs;
+    EXPECT_GT(runs, 10);
+    EXPECT_LT(program->GetTimerUsed(), 110);
+    EXPECT_EQ(program->GetError(), CBotNoErr);
+}
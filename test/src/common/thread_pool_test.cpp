@@ -0,0 +1,200 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/task_graph.h"
+#include "common/thread/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class CThreadPoolTest : public testing::Test
+{
+protected:
+    CThreadPool m_pool{4};
+};
+
+TEST_F(CThreadPoolTest, SubmitReturnsResult)
+{
+    auto future = m_pool.Submit("answer", []() { return 42; });
+    EXPECT_EQ(42, future.get());
+}
+
+TEST_F(CThreadPoolTest, SubmitPropagatesException)
+{
+    auto future = m_pool.Submit("throw", []() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST_F(CThreadPoolTest, WaitIdleWaitsForNestedTasks)
+{
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; ++i)
+    {
+        m_pool.Post("outer", [&]()
+        {
+            ++count;
+            m_pool.Post("inner", [&]() { ++count; });
+        });
+    }
+
+    m_pool.WaitIdle();
+    EXPECT_EQ(200, count);
+}
+
+TEST_F(CThreadPoolTest, ProfilingHookSeesTaskNames)
+{
+    std::mutex mutex;
+    std::vector<std::string> names;
+    m_pool.SetProfilingHook([&](std::string_view name, TimeUtils::TimeStamp start, TimeUtils::TimeStamp end)
+    {
+        EXPECT_LE(start, end);
+        std::lock_guard<std::mutex> lock{mutex};
+        names.emplace_back(name);
+    });
+
+    m_pool.Post("profiled", []() {});
+    m_pool.WaitIdle();
+
+    ASSERT_EQ(1u, names.size());
+    EXPECT_EQ("profiled", names[0]);
+}
+
+TEST_F(CThreadPoolTest, SerialQueueRunsTasksInOrder)
+{
+    std::vector<int> order;
+    {
+        CSerialQueue queue{m_pool, "serial"};
+        for (int i = 0; i < 100; ++i)
+            queue.Post([&order, i]() { order.push_back(i); });
+
+        m_pool.WaitIdle();
+    }
+
+    ASSERT_EQ(100u, order.size());
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(i, order[i]);
+}
+
+TEST_F(CThreadPoolTest, SerialQueueContinuesAfterUnknownException)
+{
+    std::atomic<int> count{0};
+    {
+        CSerialQueue queue{m_pool, "serial"};
+        queue.Post([]() { throw 42; });
+        queue.Post([&]() { ++count; });
+
+        m_pool.WaitIdle();
+        queue.Post([&]() { ++count; });
+        m_pool.WaitIdle();
+    }
+
+    EXPECT_EQ(2, count);
+}
+
+TEST_F(CThreadPoolTest, SerialQueueClearWaitsForRunningTask)
+{
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    std::atomic<int> count{0};
+
+    CSerialQueue queue{m_pool, "serial"};
+    queue.Post([&]()
+    {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        finished = true;
+    });
+    queue.Post([&]() { ++count; });
+
+    while (!started)
+        std::this_thread::yield();
+
+    queue.Clear();
+    EXPECT_TRUE(finished);
+
+    m_pool.WaitIdle();
+    EXPECT_EQ(0, count);
+
+    queue.Post([&]() { ++count; });
+    m_pool.WaitIdle();
+    EXPECT_EQ(1, count);
+}
+
+TEST_F(CThreadPoolTest, TaskGraphRespectsDependencies)
+{
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name)
+    {
+        return [&, name]()
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            order.push_back(name);
+        };
+    };
+
+    CTaskGraph graph;
+    auto a = graph.AddTask("a", record("a"));
+    auto b = graph.AddTask("b", record("b"));
+    auto c = graph.AddTask("c", record("c"));
+    auto d = graph.AddTask("d", record("d"));
+    graph.AddDependency(b, a);
+    graph.AddDependency(c, a);
+    graph.AddDependency(d, b);
+    graph.AddDependency(d, c);
+
+    graph.Run(m_pool).get();
+
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ("a", order.front());
+    EXPECT_EQ("d", order.back());
+}
+
+TEST_F(CThreadPoolTest, TaskGraphSkipsDependentsOfFailedTask)
+{
+    std::atomic<bool> dependentRan{false};
+    std::atomic<bool> independentRan{false};
+
+    CTaskGraph graph;
+    auto failing = graph.AddTask("failing", []() { throw std::runtime_error("error"); });
+    auto dependent = graph.AddTask("dependent", [&]() { dependentRan = true; });
+    graph.AddTask("independent", [&]() { independentRan = true; });
+    graph.AddDependency(dependent, failing);
+
+    EXPECT_THROW(graph.Run(m_pool).get(), std::runtime_error);
+    EXPECT_FALSE(dependentRan);
+    EXPECT_TRUE(independentRan);
+}
+
+TEST_F(CThreadPoolTest, TaskGraphRejectsCycles)
+{
+    CTaskGraph graph;
+    auto a = graph.AddTask("a", []() {});
+    auto b = graph.AddTask("b", []() {});
+    graph.AddDependency(a, b);
+    graph.AddDependency(b, a);
+
+    EXPECT_THROW(graph.Run(m_pool).get(), std::logic_error);
+}
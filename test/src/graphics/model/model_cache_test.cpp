@@ -0,0 +1,147 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/* Unit tests for model cache encoding */
+
+#include "graphics/model/model_cache.h"
+
+#include "graphics/model/model_io_exception.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+const std::uint32_t TEST_VERTEX_COUNT = 5;
+const std::uint32_t TEST_INDEX_COUNT = 9;
+
+std::unique_ptr<CModel> CreateTestModel()
+{
+    auto model = std::make_unique<CModel>();
+
+    ModelCrashSphere crashSphere;
+    crashSphere.position = { 1.0f, 2.0f, 3.0f };
+    crashSphere.radius = 4.0f;
+    crashSphere.sound = "metal";
+    crashSphere.hardness = 0.5f;
+    model->AddCrashSphere(crashSphere);
+
+    ModelShadowSpot shadowSpot;
+    shadowSpot.radius = 6.0f;
+    shadowSpot.intensity = 0.75f;
+    model->SetShadowSpot(shadowSpot);
+
+    auto mesh = std::make_unique<CModelMesh>();
+    mesh->SetPosition({ 0.0f, 1.0f, 0.0f });
+
+    CModelPart* part = mesh->AddPart(Material());
+    part->Add(VertexAttribute::UV1);
+    for (std::uint32_t i = 0; i < TEST_VERTEX_COUNT; ++i)
+    {
+        Vertex3D vertex;
+        vertex.position = { 10.0f * i, 20.0f, -30.0f };
+        vertex.uv = { 0.25f * i, 0.5f };
+        part->AddVertex(vertex);
+    }
+    part->SetIndices(TEST_INDEX_COUNT);
+    for (std::uint32_t i = 0; i < TEST_INDEX_COUNT; ++i)
+        part->SetIndex(i, (i * 3) % TEST_VERTEX_COUNT);
+
+    model->AddMesh("main", std::move(mesh));
+    return model;
+}
+
+} // namespace
+
+TEST(ModelCacheTest, RoundTrip)
+{
+    auto model = CreateTestModel();
+    auto data = ModelIO::EncodeCachedModel(*model);
+    auto decoded = ModelIO::DecodeCachedModel(data.data(), data.size());
+    ASSERT_NE(nullptr, decoded);
+
+    ASSERT_EQ(1u, decoded->GetCrashSpheres().size());
+    const auto& crashSphere = decoded->GetCrashSpheres()[0];
+    EXPECT_EQ(glm::vec3(1.0f, 2.0f, 3.0f), crashSphere.position);
+    EXPECT_EQ(4.0f, crashSphere.radius);
+    EXPECT_EQ("metal", crashSphere.sound);
+    EXPECT_EQ(0.5f, crashSphere.hardness);
+
+    ASSERT_TRUE(decoded->HasShadowSpot());
+    EXPECT_EQ(6.0f, decoded->GetShadowSpot().radius);
+    EXPECT_EQ(0.75f, decoded->GetShadowSpot().intensity);
+
+    const CModelMesh* original = model->GetMesh("main");
+    const CModelMesh* mesh = decoded->GetMesh("main");
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_EQ(original->GetPosition(), mesh->GetPosition());
+    ASSERT_EQ(1u, mesh->GetPartCount());
+
+    const CModelPart* expected = original->GetPart(0);
+    const CModelPart* part = mesh->GetPart(0);
+    EXPECT_TRUE(part->Has(VertexAttribute::UV1));
+    EXPECT_FALSE(part->Has(VertexAttribute::NORMAL));
+    ASSERT_EQ(TEST_VERTEX_COUNT, part->GetVertexCount());
+    ASSERT_EQ(TEST_INDEX_COUNT, part->GetIndexCount());
+    EXPECT_TRUE(std::equal(part->GetPositionData(), part->GetPositionData() + TEST_VERTEX_COUNT,
+                           expected->GetPositionData()));
+    EXPECT_EQ(0, std::memcmp(part->GetAttributeData(VertexAttribute::UV1),
+                             expected->GetAttributeData(VertexAttribute::UV1),
+                             TEST_VERTEX_COUNT * CModelPart::GetAttributeSize(VertexAttribute::UV1)));
+    EXPECT_EQ(expected->GetIndices(), part->GetIndices());
+}
+
+TEST(ModelCacheTest, TruncatedData)
+{
+    auto data = ModelIO::EncodeCachedModel(*CreateTestModel());
+
+    for (std::size_t size = 0; size < data.size(); ++size)
+    {
+        EXPECT_THROW(ModelIO::DecodeCachedModel(data.data(), size), CModelIOException) << "size " << size;
+    }
+}
+
+TEST(ModelCacheTest, CorruptVertexCount)
+{
+    auto data = ModelIO::EncodeCachedModel(*CreateTestModel());
+
+    // vertex and index counts are stored next to each other, right before vertex data
+    const std::array<std::uint32_t, 2> counts = { TEST_VERTEX_COUNT, TEST_INDEX_COUNT };
+    auto it = std::search(data.begin(), data.end(),
+                          reinterpret_cast<const char*>(counts.data()),
+                          reinterpret_cast<const char*>(counts.data() + counts.size()));
+    ASSERT_NE(data.end(), it);
+
+    const std::uint32_t corruptCount = 0xFFFFFFFF;
+    std::memcpy(&*it, &corruptCount, sizeof(corruptCount));
+    EXPECT_THROW(ModelIO::DecodeCachedModel(data.data(), data.size()), CModelIOException);
+
+    std::memcpy(&*it + sizeof(corruptCount), &corruptCount, sizeof(corruptCount));
+    std::memcpy(&*it, &TEST_VERTEX_COUNT, sizeof(TEST_VERTEX_COUNT));
+    EXPECT_THROW(ModelIO::DecodeCachedModel(data.data(), data.size()), CModelIOException);
+}
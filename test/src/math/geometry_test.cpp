@@ -19,11 +19,17 @@
 
 /* Unit tests for functions in geometry.h */
 
+#include "graphics/engine/triangle_bvh.h"
+
 #include "math/func.h"
 #include "math/geometry.h"
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <random>
+#include <vector>
+
 
 const float TEST_TOLERANCE = 1e-5;
 
@@ -50,6 +56,161 @@ TEST(GeometryTest, RotateAngleTest)
     EXPECT_TRUE(Math::IsEqual(Math::RotateAngle(1.0f, -1.0f), 1.75f * Math::PI, TEST_TOLERANCE));
 }
 
+TEST(GeometryTest, IntersectRayTriangleTest)
+{
+    const glm::vec3 a(0.0f, 0.0f, 5.0f), b(1.0f, 0.0f, 5.0f), c(0.0f, 1.0f, 5.0f);
+    const float inf = std::numeric_limits<float>::infinity();
+    float t = -1.0f;
+
+    EXPECT_TRUE(Math::IntersectRayTriangle(glm::vec3(0.2f, 0.2f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), a, b, c, 0.0f, inf, t));
+    EXPECT_TRUE(Math::IsEqual(t, 5.0f, TEST_TOLERANCE));
+
+    // both faces are hit
+    t = -1.0f;
+    EXPECT_TRUE(Math::IntersectRayTriangle(glm::vec3(0.2f, 0.2f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f), a, b, c, 0.0f, inf, t));
+    EXPECT_TRUE(Math::IsEqual(t, 5.0f, TEST_TOLERANCE));
+
+    // t is not scaled to the length of the direction
+    EXPECT_TRUE(Math::IntersectRayTriangle(glm::vec3(0.2f, 0.2f, 0.0f), glm::vec3(0.0f, 0.0f, 2.0f), a, b, c, 0.0f, inf, t));
+    EXPECT_TRUE(Math::IsEqual(t, 2.5f, TEST_TOLERANCE));
+
+    // misses beside the triangle and along its plane leave t unchanged
+    t = -1.0f;
+    EXPECT_FALSE(Math::IntersectRayTriangle(glm::vec3(0.6f, 0.6f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), a, b, c, 0.0f, inf, t));
+    EXPECT_FALSE(Math::IntersectRayTriangle(glm::vec3(-1.0f, 0.2f, 5.0f), glm::vec3(1.0f, 0.0f, 0.0f), a, b, c, 0.0f, inf, t));
+    EXPECT_EQ(t, -1.0f);
+
+    // hits outside of [tMin, tMax] are ignored
+    const glm::vec3 origin(0.2f, 0.2f, 0.0f), dir(0.0f, 0.0f, 1.0f);
+    EXPECT_FALSE(Math::IntersectRayTriangle(origin, -dir, a, b, c, 0.0f, inf, t));
+    EXPECT_FALSE(Math::IntersectRayTriangle(origin, dir, a, b, c, 0.0f, 4.0f, t));
+    EXPECT_FALSE(Math::IntersectRayTriangle(origin, dir, a, b, c, 6.0f, inf, t));
+    EXPECT_TRUE(Math::IntersectRayTriangle(origin, dir, a, b, c, 4.0f, 6.0f, t));
+    EXPECT_TRUE(Math::IsEqual(t, 5.0f, TEST_TOLERANCE));
+}
+
+TEST(GeometryTest, IntersectRayBoxTest)
+{
+    const glm::vec3 min(-1.0f, -1.0f, -1.0f), max(1.0f, 1.0f, 1.0f);
+    const float inf = std::numeric_limits<float>::infinity();
+
+    float tMin = 0.0f, tMax = inf;
+    EXPECT_TRUE(Math::IntersectRayBox(glm::vec3(-5.0f, 0.5f, 0.5f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMin, 4.0f, TEST_TOLERANCE));
+    EXPECT_TRUE(Math::IsEqual(tMax, 6.0f, TEST_TOLERANCE));
+
+    // diagonal ray is clipped by different slabs at each end
+    tMin = 0.0f, tMax = inf;
+    EXPECT_TRUE(Math::IntersectRayBox(glm::vec3(-2.0f, -3.0f, 0.0f), 1.0f / glm::vec3(1.0f, 1.0f, 0.0f), min, max, tMin, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMin, 2.0f, TEST_TOLERANCE));
+    EXPECT_TRUE(Math::IsEqual(tMax, 3.0f, TEST_TOLERANCE));
+
+    // the given range is only narrowed
+    tMin = 4.5f, tMax = 5.0f;
+    EXPECT_TRUE(Math::IntersectRayBox(glm::vec3(-5.0f, 0.5f, 0.5f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMin, 4.5f, TEST_TOLERANCE));
+    EXPECT_TRUE(Math::IsEqual(tMax, 5.0f, TEST_TOLERANCE));
+
+    tMin = 0.0f, tMax = 3.0f;
+    EXPECT_FALSE(Math::IntersectRayBox(glm::vec3(-5.0f, 0.5f, 0.5f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+
+    tMin = 0.0f, tMax = inf;
+    EXPECT_FALSE(Math::IntersectRayBox(glm::vec3(5.0f, 0.5f, 0.5f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+
+    // axis-parallel ray outside of a slab
+    tMin = 0.0f, tMax = inf;
+    EXPECT_FALSE(Math::IntersectRayBox(glm::vec3(-5.0f, 2.0f, 0.5f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+
+    // axis-parallel ray in the plane of a face, where 0 * inf gives NaN
+    tMin = 0.0f, tMax = inf;
+    EXPECT_TRUE(Math::IntersectRayBox(glm::vec3(-5.0f, 1.0f, -1.0f), 1.0f / glm::vec3(1.0f, 0.0f, 0.0f), min, max, tMin, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMin, 4.0f, TEST_TOLERANCE));
+    EXPECT_TRUE(Math::IsEqual(tMax, 6.0f, TEST_TOLERANCE));
+}
+
+namespace
+{
+
+bool IntersectAllTriangles(const std::vector<glm::vec3>& vertices, const glm::vec3& origin, const glm::vec3& dir,
+                           float tMin, float& tMax)
+{
+    bool hit = false;
+    for (std::size_t i = 0; i + 2 < vertices.size(); i += 3)
+    {
+        float t = 0.0f;
+        if (Math::IntersectRayTriangle(origin, dir, vertices[i], vertices[i+1], vertices[i+2], tMin, tMax, t))
+        {
+            tMax = t;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+} // namespace
+
+TEST(GeometryTest, TriangleBVHTest)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+
+    Gfx::CTriangleBVH empty{std::vector<glm::vec3>()};
+    float tMax = inf;
+    EXPECT_EQ(empty.GetTriangleCount(), 0);
+    EXPECT_FALSE(empty.Intersect(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), 0.0f, tMax));
+
+    // two parallel triangles, the nearest one within [tMin, tMax] is returned
+    Gfx::CTriangleBVH pair{std::vector<glm::vec3>{
+        glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(1.0f, 0.0f, 10.0f), glm::vec3(0.0f, 1.0f, 10.0f),
+        glm::vec3(0.0f, 0.0f, 5.0f),  glm::vec3(1.0f, 0.0f, 5.0f),  glm::vec3(0.0f, 1.0f, 5.0f),
+    }};
+    const glm::vec3 origin(0.2f, 0.2f, 0.0f), dir(0.0f, 0.0f, 1.0f);
+    tMax = inf;
+    EXPECT_TRUE(pair.Intersect(origin, dir, 0.0f, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMax, 5.0f, TEST_TOLERANCE));
+    tMax = inf;
+    EXPECT_TRUE(pair.Intersect(origin, dir, 6.0f, tMax));
+    EXPECT_TRUE(Math::IsEqual(tMax, 10.0f, TEST_TOLERANCE));
+    tMax = 4.0f;
+    EXPECT_FALSE(pair.Intersect(origin, dir, 0.0f, tMax));
+    EXPECT_EQ(tMax, 4.0f);
+
+    // random triangles against brute force, with axis-parallel rays starting on the grid
+    // of vertices, so that they run along faces of the bounding boxes
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> grid(-10, 10);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::vector<glm::vec3> vertices;
+    for (int i = 0; i < 500; i++)
+    {
+        glm::vec3 corner(grid(random), grid(random), grid(random));
+        for (int j = 0; j < 3; j++)
+            vertices.push_back(corner + glm::vec3(grid(random), grid(random), grid(random)) * 0.25f);
+    }
+    Gfx::CTriangleBVH bvh(vertices);
+    EXPECT_EQ(bvh.GetTriangleCount(), 500);
+
+    int hits = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        glm::vec3 rayOrigin(grid(random), grid(random), grid(random));
+        glm::vec3 rayDir(offset(random), offset(random), offset(random));
+        if (i % 2 == 0)
+        {
+            rayDir = glm::vec3(0.0f, 0.0f, 0.0f);
+            rayDir[i / 2 % 3] = i % 4 == 0 ? 1.0f : -1.0f;
+        }
+        float tMin = i % 3 == 0 ? 2.0f : 0.0f;
+
+        float expected = inf;
+        bool expectedHit = IntersectAllTriangles(vertices, rayOrigin, rayDir, tMin, expected);
+        float actual = inf;
+        ASSERT_EQ(bvh.Intersect(rayOrigin, rayDir, tMin, actual), expectedHit) << "ray " << i;
+        EXPECT_EQ(actual, expected) << "ray " << i;
+        if (expectedHit) hits++;
+    }
+    EXPECT_GT(hits, 100);
+}
+
 // Tests for other altered, complex or uncertain functions
 
 /*
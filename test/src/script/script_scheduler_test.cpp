@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "script/script_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+struct TestProgram
+{
+    int id = 0;
+    int team = 0;
+    //! Instructions the program asks for
+    int instructions = 100;
+    //! Instructions the program executes at most, e.g. when waiting for a task
+    int uses = 1000000;
+};
+
+class CScriptSchedulerTest : public testing::Test
+{
+protected:
+    //! Runs one frame, returns slices given to the programs, -1 for programs that waited
+    std::vector<int> RunFrame(const std::vector<TestProgram>& programs)
+    {
+        for (const auto& program : programs)
+            m_scheduler.AddProgram(program.id, program.team, program.instructions);
+        m_scheduler.Schedule();
+
+        std::vector<int> slices;
+        for (const auto& program : programs)
+        {
+            int slice = m_scheduler.StartSlice(program.id, program.instructions);
+            if (slice >= 0)
+                m_scheduler.EndSlice(std::min(slice, program.uses));
+            slices.push_back(slice);
+        }
+
+        m_scheduler.EndFrame();
+        return slices;
+    }
+
+    CScriptScheduler m_scheduler;
+};
+
+TEST_F(CScriptSchedulerTest, UnlimitedBudgetGivesWhatProgramsAsk)
+{
+    auto slices = RunFrame({{1, 0, 100}, {2, 0, 5000}, {3, 0, 0}});
+    EXPECT_EQ(slices, (std::vector<int>{100, 5000, 0}));
+    EXPECT_EQ(m_scheduler.GetStats().starved, 0);
+    EXPECT_EQ(m_scheduler.GetStats().throttled, 0);
+}
+
+TEST_F(CScriptSchedulerTest, ProgramsWithinBudgetGetWhatTheyAsk)
+{
+    m_scheduler.SetInstructionBudget(1000);
+    auto slices = RunFrame({{1, 0, 100}, {2, 0, 100}, {3, 0, 800}});
+    EXPECT_EQ(slices, (std::vector<int>{100, 100, 800}));
+}
+
+TEST_F(CScriptSchedulerTest, BudgetIsSharedFairly)
+{
+    m_scheduler.SetInstructionBudget(300);
+    auto slices = RunFrame({{1, 0, 50}, {2, 0, 1000}, {3, 0, 1000}});
+    EXPECT_EQ(slices, (std::vector<int>{50, 125, 125}));
+    EXPECT_EQ(m_scheduler.GetStats().throttled, 2);
+    EXPECT_EQ(m_scheduler.GetStats().executed, 300);
+}
+
+TEST_F(CScriptSchedulerTest, ProgramsTakeTurnsWhenBudgetIsTooSmall)
+{
+    m_scheduler.SetInstructionBudget(2 * SCRIPT_MIN_SLICE);
+    std::vector<TestProgram> programs = {{1}, {2}, {3}, {4}, {5}};
+
+    std::vector<int> served(programs.size(), 0);
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        auto slices = RunFrame(programs);
+        EXPECT_EQ(std::count(slices.begin(), slices.end(), SCRIPT_MIN_SLICE), 2);
+        EXPECT_EQ(m_scheduler.GetStats().starved, 3);
+        for (std::size_t i = 0; i < slices.size(); ++i)
+            served[i] += slices[i] > 0;
+    }
+
+    EXPECT_EQ(served, (std::vector<int>{2, 2, 2, 2, 2}));
+    EXPECT_EQ(m_scheduler.GetStats().totalStarved, 15);
+    EXPECT_EQ(m_scheduler.GetStats().longestStarvation, 2);
+}
+
+TEST_F(CScriptSchedulerTest, TeamQuotas)
+{
+    m_scheduler.SetInstructionBudget(400);
+    std::vector<TestProgram> programs = {{1, 1, 1000}, {2, 1, 1000}, {3, 1, 1000}, {4, 1, 1000}, {5, 2, 1000}};
+
+    EXPECT_EQ(RunFrame(programs), (std::vector<int>{80, 80, 80, 80, 80}));
+
+    m_scheduler.SetTeamQuotas(true);
+    EXPECT_EQ(RunFrame(programs), (std::vector<int>{50, 50, 50, 50, 200}));
+}
+
+TEST_F(CScriptSchedulerTest, UnusedInstructionsGoToLaterPrograms)
+{
+    m_scheduler.SetInstructionBudget(200);
+    std::vector<TestProgram> programs = {{1, 0, 200, 5}, {2, 0, 200}};
+
+    EXPECT_EQ(RunFrame(programs), (std::vector<int>{100, 195}));
+
+    // waiting program is expected to need only a bit more than it used
+    EXPECT_EQ(RunFrame(programs), (std::vector<int>{5 + SCRIPT_MIN_SLICE, 200 - 5}));
+}
+
+TEST_F(CScriptSchedulerTest, ProgramStartedDuringFrameGetsSpareInstructions)
+{
+    m_scheduler.SetInstructionBudget(300);
+    m_scheduler.AddProgram(1, 0, 100);
+    m_scheduler.Schedule();
+
+    EXPECT_EQ(m_scheduler.StartSlice(1, 100), 100);
+    m_scheduler.EndSlice(100);
+    EXPECT_EQ(m_scheduler.StartSlice(2, 500), 200);
+    m_scheduler.EndSlice(200);
+    EXPECT_EQ(m_scheduler.StartSlice(3, 100), -1);
+    m_scheduler.EndFrame();
+
+    EXPECT_EQ(m_scheduler.GetStats().programs, 3);
+    EXPECT_EQ(m_scheduler.GetStats().starved, 1);
+}
+
+TEST_F(CScriptSchedulerTest, NoTimeBudgetByDefault)
+{
+    EXPECT_EQ(m_scheduler.GetInstructionBudget(), 0);
+    EXPECT_EQ(m_scheduler.GetTimeBudget(), 0.0f);
+}
+
+TEST_F(CScriptSchedulerTest, DeterministicModeIgnoresTimeBudget)
+{
+    m_scheduler.SetInstructionBudget(1000);
+    m_scheduler.SetTimeBudget(1e-6f);
+    m_scheduler.SetDeterministic(true);
+
+    std::vector<TestProgram> programs = {{1, 0, 400}, {2, 0, 400}};
+    for (int frame = 0; frame < 3; ++frame)
+        EXPECT_EQ(RunFrame(programs), (std::vector<int>{400, 400}));
+
+    m_scheduler.SetDeterministic(false);
+    RunFrame(programs);
+    EXPECT_LT(m_scheduler.GetStats().budget, 1000);
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::size_t g_allocatedBytes = 0;
+std::size_t g_peakBytes = 0;
+
+//! Allocations are prefixed with their size, keeping the default alignment
+constexpr std::size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+} // namespace
+
+namespace AllocationCounter
+{
+
+std::size_t GetAllocatedBytes()
+{
+    return g_allocatedBytes;
+}
+
+std::size_t GetPeakBytes()
+{
+    return g_peakBytes;
+}
+
+void ResetPeak()
+{
+    g_peakBytes = g_allocatedBytes;
+}
+
+} // namespace AllocationCounter
+
+void* operator new(std::size_t size)
+{
+    void* block = std::malloc(size + ALLOCATION_HEADER);
+    if (block == nullptr) throw std::bad_alloc();
+
+    *static_cast<std::size_t*>(block) = size;
+    g_allocatedBytes += size;
+    g_peakBytes = std::max(g_peakBytes, g_allocatedBytes);
+    return static_cast<char*>(block) + ALLOCATION_HEADER;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr) return;
+
+    void* block = static_cast<char*>(pointer) - ALLOCATION_HEADER;
+    g_allocatedBytes -= *static_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
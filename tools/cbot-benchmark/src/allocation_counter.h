@@ -0,0 +1,43 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/*
+ * Counts bytes allocated with the replaced global operator new.
+ *
+ * The replacement operators live in their own translation unit, so that the compiler
+ * doesn't inline them into callers and mistake the size header for a buffer overrun.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace AllocationCounter
+{
+
+//! Returns number of bytes currently allocated with operator new
+std::size_t GetAllocatedBytes();
+
+//! Returns the highest number of allocated bytes since the last ResetPeak()
+std::size_t GetPeakBytes();
+
+//! Starts measuring the peak from the current number of allocated bytes
+void ResetPeak();
+
+} // namespace AllocationCounter
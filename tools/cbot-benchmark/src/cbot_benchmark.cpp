@@ -0,0 +1,399 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/*
+ * Measures compile and execution speed of the CBot interpreter on a corpus of workloads.
+ *
+ * Usage: CBot-Benchmark [options] [workload files or directories]
+ *
+ *   --iterations N       measured compilations and runs of every workload (default 5)
+ *   --format json|csv    output format, json writes one object per line (default json)
+ *   --baseline FILE      json output of an earlier run to compare instructions/sec with
+ *
+ * Without workload arguments, the corpus in tools/cbot-benchmark/workloads is used.
+ * Every workload is a CBot program with one extern function, started like CBot-Console does.
+ * A "// ipf: N" first line sets the number of instructions per Run() call (default 100,
+ * the same as in the game). Besides "message", workloads can call "pause", which suspends
+ * the program until the next Run() call.
+ *
+ * Results go to stdout, errors and messages to stderr. Times are medians over all iterations,
+ * instruction counts come from an extra run with CBotProgram::SetProfiling(). Peak memory
+ * counts bytes allocated with operator new during one compilation and run. Tokenize and
+ * compile throughput is given in kilobytes of source code per second; tokenizing is timed
+ * on its own, compile time includes it.
+ */
+
+#include "allocation_counter.h"
+
+#include "CBot/CBot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CBot;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+const int DEFAULT_IPF = 100;
+
+struct Workload
+{
+    std::string name;
+    std::string code;
+    int ipf = DEFAULT_IPF;
+};
+
+struct Result
+{
+    double tokenizeTime = 0.0;  // ms
+    double compileTime = 0.0;   // ms
+    double runTime = 0.0;       // ms
+    long instructions = 0;
+    long slices = 0;
+    std::size_t peakMemory = 0;
+};
+
+CBotTypResult cMessage(CBotVar* &var, void* user)
+{
+    if ( var == nullptr )  return CBotTypResult(CBotErrLowParam);
+    if ( var->GetType() != CBotTypString &&
+         var->GetType() >  CBotTypDouble )  return CBotTypResult(CBotErrBadNum);
+    var = var->GetNext();
+
+    if ( var == nullptr )  return CBotTypResult(CBotTypFloat);
+    return CBotTypResult(CBotErrOverParam);
+}
+
+bool rMessage(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    std::cerr << var->GetValString() << std::endl;
+    return true;
+}
+
+CBotTypResult cPause(CBotVar* &var, void* user)
+{
+    if ( var != nullptr )  return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypFloat);
+}
+
+bool rPause(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    // every other call finishes, so each pause() suspends exactly once
+    static bool suspended = false;
+    suspended = !suspended;
+    result->SetValFloat(0.0f);
+    return !suspended;
+}
+
+double Milliseconds(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//! Kilobytes of source code processed per second
+double Throughput(const Workload& workload, double time)
+{
+    return time > 0.0 ? workload.code.size() / 1024.0 / (time / 1000.0) : 0.0;
+}
+
+double Median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    std::size_t middle = values.size() / 2;
+    if (values.size() % 2 == 1) return values[middle];
+    return (values[middle - 1] + values[middle]) / 2.0;
+}
+
+bool ReadWorkload(const std::filesystem::path& path, std::vector<Workload>& workloads)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot open workload: " << path.string() << std::endl;
+        return false;
+    }
+
+    std::stringstream code;
+    code << file.rdbuf();
+
+    Workload workload;
+    workload.name = path.stem().string();
+    workload.code = code.str();
+
+    const char* ipfPrefix = "// ipf:";
+    if (workload.code.compare(0, strlen(ipfPrefix), ipfPrefix) == 0)
+        workload.ipf = std::max(1, atoi(workload.code.c_str() + strlen(ipfPrefix)));
+
+    workloads.push_back(std::move(workload));
+    return true;
+}
+
+bool FindWorkloads(const std::filesystem::path& path, std::vector<Workload>& workloads)
+{
+    if (!std::filesystem::is_directory(path))
+        return ReadWorkload(path, workloads);
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(path))
+    {
+        if (entry.path().extension() == ".txt")
+            files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    for (const auto& file : files)
+    {
+        if (!ReadWorkload(file, workloads)) return false;
+    }
+    return true;
+}
+
+//! Compiles the workload, returns its entry point or empty string on error
+std::string Compile(const Workload& workload, CBotProgram& program)
+{
+    std::vector<std::string> externFunctions;
+    if (!program.Compile(workload.code, externFunctions, nullptr))
+    {
+        CBotError error;
+        int cursor1, cursor2;
+        program.GetError(error, cursor1, cursor2);
+        std::cerr << workload.name << ": COMPILE ERROR (code: " << error << ") @ " << cursor1 << " - " << cursor2 << std::endl;
+        return "";
+    }
+    if (externFunctions.empty())
+    {
+        std::cerr << workload.name << ": NO EXTERN FUNCTIONS FOUND" << std::endl;
+        return "";
+    }
+    return externFunctions[0];
+}
+
+//! Runs the compiled program to completion, returns number of Run() calls or -1 on error
+long Execute(const Workload& workload, CBotProgram& program, const std::string& function)
+{
+    if (!program.Start(function)) return -1;
+
+    long slices = 1;
+    while (!program.Run(nullptr, workload.ipf))
+        ++slices;
+
+    if (program.GetError() != CBotNoErr)
+    {
+        std::cerr << workload.name << ": RUNTIME ERROR (code: " << program.GetError() << ")" << std::endl;
+        return -1;
+    }
+    return slices;
+}
+
+bool Measure(const Workload& workload, int iterations, Result& result)
+{
+    // Peak memory of one compilation and run
+    {
+        std::size_t base = AllocationCounter::GetAllocatedBytes();
+        AllocationCounter::ResetPeak();
+
+        auto program = std::make_unique<CBotProgram>();
+        std::string function = Compile(workload, *program);
+        if (function.empty()) return false;
+        result.slices = Execute(workload, *program, function);
+        if (result.slices < 0) return false;
+
+        result.peakMemory = AllocationCounter::GetPeakBytes() - base;
+    }
+
+    // Instruction count, profiling slows down execution so it's not timed
+    {
+        CBotProgram program;
+        std::string function = Compile(workload, program);
+        program.SetProfiling(true);
+        if (Execute(workload, program, function) < 0) return false;
+        result.instructions = program.GetProfiler()->GetTotal().instructions;
+    }
+
+    std::vector<double> tokenizeTimes, compileTimes, runTimes;
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto tokenizeStart = Clock::now();
+        auto tokens = CBotToken::CompileTokens(workload.code);
+        tokenizeTimes.push_back(Milliseconds(tokenizeStart, Clock::now()));
+        tokens.reset();
+
+        CBotProgram program;
+
+        auto start = Clock::now();
+        std::string function = Compile(workload, program);
+        auto compiled = Clock::now();
+        if (Execute(workload, program, function) < 0) return false;
+        auto end = Clock::now();
+
+        compileTimes.push_back(Milliseconds(start, compiled));
+        runTimes.push_back(Milliseconds(compiled, end));
+    }
+
+    result.tokenizeTime = Median(tokenizeTimes);
+    result.compileTime = Median(compileTimes);
+    result.runTime = Median(runTimes);
+    return true;
+}
+
+//! Reads instructions/sec of every workload from json lines written by this program
+std::map<std::string, double> ReadBaseline(const std::filesystem::path& path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot open baseline: " << path.string() << std::endl;
+        return baseline;
+    }
+
+    const std::string nameKey = "\"workload\":\"";
+    const std::string speedKey = "\"instructions_per_sec\":";
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto name = line.find(nameKey);
+        auto speed = line.find(speedKey);
+        if (name == std::string::npos || speed == std::string::npos) continue;
+
+        name += nameKey.size();
+        baseline[line.substr(name, line.find('"', name) - name)] = atof(line.c_str() + speed + speedKey.size());
+    }
+    return baseline;
+}
+
+void WriteResult(std::ostream& ostr, bool csv, const Workload& workload, const Result& result, double speed, double baseline)
+{
+    if (csv)
+    {
+        ostr << workload.name << "," << workload.ipf << "," << workload.code.size() << ","
+             << result.tokenizeTime << "," << Throughput(workload, result.tokenizeTime) << ","
+             << result.compileTime << "," << Throughput(workload, result.compileTime) << "," << result.runTime << ","
+             << result.instructions << "," << speed << "," << result.slices << "," << result.peakMemory;
+        if (baseline > 0.0) ostr << "," << speed / baseline;
+        ostr << std::endl;
+        return;
+    }
+
+    ostr << "{\"workload\":\"" << workload.name << "\""
+         << ",\"ipf\":" << workload.ipf
+         << ",\"source_bytes\":" << workload.code.size()
+         << ",\"tokenize_ms\":" << result.tokenizeTime
+         << ",\"tokenize_kb_per_sec\":" << Throughput(workload, result.tokenizeTime)
+         << ",\"compile_ms\":" << result.compileTime
+         << ",\"compile_kb_per_sec\":" << Throughput(workload, result.compileTime)
+         << ",\"run_ms\":" << result.runTime
+         << ",\"instructions\":" << result.instructions
+         << ",\"instructions_per_sec\":" << speed
+         << ",\"slices\":" << result.slices
+         << ",\"peak_memory_bytes\":" << result.peakMemory;
+    if (baseline > 0.0) ostr << ",\"baseline_ratio\":" << speed / baseline;
+    ostr << "}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = 5;
+    bool csv = false;
+    std::filesystem::path baselinePath;
+    std::vector<std::filesystem::path> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc)
+        {
+            iterations = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            csv = strcmp(argv[++i], "csv") == 0;
+        }
+        else if (arg == "--baseline" && i + 1 < argc)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            std::cerr << "Usage: " << argv[0] << " [--iterations N] [--format json|csv] [--baseline FILE] [workloads...]" << std::endl;
+            return 1;
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty())
+        paths.push_back(CBOT_BENCHMARK_WORKLOADS);
+
+    std::vector<Workload> workloads;
+    for (const auto& path : paths)
+    {
+        if (!FindWorkloads(path, workloads)) return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty())
+        baseline = ReadBaseline(baselinePath);
+
+    CBotProgram::Init();
+    CBotProgram::AddFunction("message", rMessage, cMessage);
+    CBotProgram::AddFunction("pause", rPause, cPause);
+
+    if (csv)
+    {
+        std::cout << "workload,ipf,source_bytes,tokenize_ms,tokenize_kb_per_sec,compile_ms,compile_kb_per_sec,run_ms,instructions,instructions_per_sec,slices,peak_memory_bytes";
+        if (!baseline.empty()) std::cout << ",baseline_ratio";
+        std::cout << std::endl;
+    }
+
+    bool errors = false;
+    for (const auto& workload : workloads)
+    {
+        Result result;
+        if (!Measure(workload, iterations, result))
+        {
+            errors = true;
+            continue;
+        }
+
+        double speed = result.runTime > 0.0 ? result.instructions / (result.runTime / 1000.0) : 0.0;
+        auto it = baseline.find(workload.name);
+        WriteResult(std::cout, csv, workload, result, speed, it != baseline.end() ? it->second : 0.0);
+    }
+
+    CBotProgram::Free();
+    return errors ? 2 : 0;
+}
@@ -17,6 +17,7 @@
  * along with this program. If not, see http://gnu.org/licenses
  */
 
+#include <cstring>
 #include <iostream>
 #include <memory>
 
@@ -53,6 +54,21 @@ bool rMessage(CBotVar* var, CBotVar* result, int& exception, void* user)
 
 int main(int argc, char* argv[])
 {
+    // With --profile, execution statistics are printed to stderr after each extern function
+    bool profile = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--profile") == 0)
+        {
+            profile = true;
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--profile] < program.txt" << std::endl;
+            return 4;
+        }
+    }
+
     // Read program code from stdin
     std::string code = "";
     std::string line;
@@ -90,6 +106,8 @@ int main(int argc, char* argv[])
         std::cerr << "NO EXTERN FUNCTIONS FOUND";
         return 2;
     }
+    program->SetProfiling(profile);
+
     bool runErrors = false;
     for (const std::string& func : externFunctions)
     {
@@ -117,6 +135,13 @@ int main(int argc, char* argv[])
         {
             std::cerr << "Program finished." << std::endl;
         }
+
+        if (profile)
+        {
+            std::cerr << "Profile of " << func << ":" << std::endl;
+            program->GetProfiler()->Dump(std::cerr, code);
+            program->GetProfiler()->Clear();
+        }
     }
 
     return runErrors ? 3 : 0;
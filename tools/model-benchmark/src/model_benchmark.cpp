@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/*
+ * Measures model load times with and without the binary model cache.
+ *
+ * Usage: Colobot-ModelBenchmark [data directory] [cache directory]
+ *
+ * Every model in models/ and models-new/ is loaded three times: parsed from source,
+ * parsed and written to cache, and read back from cache.
+ */
+
+#include "common/logger.h"
+#include "common/stringutils.h"
+#include "common/timeutils.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "graphics/model/model_cache.h"
+#include "graphics/model/model_input.h"
+#include "graphics/model/model_io_exception.h"
+
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Gfx;
+using TimeUtils::TimeUnit;
+
+namespace
+{
+
+void FindModels(const std::filesystem::path& directory, std::vector<std::filesystem::path>& models)
+{
+    for (const auto& name : CResourceManager::ListFiles(directory))
+    {
+        std::filesystem::path path = directory / name;
+        if (CResourceManager::DirectoryExists(path))
+        {
+            FindModels(path, models);
+            continue;
+        }
+
+        auto extension = path.extension();
+        if (extension == ".mod" || extension == ".txt" || extension == ".gltf")
+            models.push_back(path);
+    }
+}
+
+float MeasurePass(const std::string& name, const std::vector<std::filesystem::path>& models,
+                  const std::function<std::unique_ptr<CModel>(const std::filesystem::path&)>& read)
+{
+    int failed = 0;
+    auto start = TimeUtils::GetCurrentTimeStamp();
+    for (const auto& path : models)
+    {
+        try
+        {
+            read(path);
+        }
+        catch (const CModelIOException&)
+        {
+            ++failed;
+        }
+    }
+    auto end = TimeUtils::GetCurrentTimeStamp();
+
+    float time = TimeUtils::Diff<TimeUnit::MILLISECONDS>(start, end);
+    std::cout << name << ": " << time << " ms";
+    if (failed > 0)
+        std::cout << " (" << failed << " failed)";
+    std::cout << std::endl;
+    return time;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    CLogger logger;
+    logger.SetLogLevel(LOG_WARN);
+
+    std::filesystem::path dataPath = argc > 1 ? StrUtils::ToPath(argv[1]) : "data";
+    std::filesystem::path cachePath = argc > 2 ? StrUtils::ToPath(argv[2]) : "model-benchmark-cache";
+    std::filesystem::create_directories(cachePath);
+
+    CResourceManager resourceManager(argv[0]);
+    if (!CResourceManager::AddLocation(dataPath) ||
+        !CResourceManager::SetSaveLocation(cachePath) ||
+        !CResourceManager::AddLocation(cachePath))
+    {
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> models;
+    FindModels("models", models);
+    FindModels("models-new", models);
+    std::cout << "Models: " << models.size() << std::endl;
+
+    CResourceManager::RemoveExistingDirectory("cache/models");
+
+    MeasurePass("Source", models, ModelInput::ReadSource);
+    MeasurePass("Source + cache write", models, ModelInput::Read);
+    MeasurePass("Cache", models, ModelIO::ReadCachedModel);
+
+    return 0;
+}
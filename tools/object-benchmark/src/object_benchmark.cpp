@@ -0,0 +1,743 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2023, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/*
+ * Microbenchmarks of per-frame object code that don't need a running game.
+ *
+ * Usage: Colobot-ObjectBenchmark [benchmark...]
+ *
+ * Without arguments, runs all benchmarks. Each one prints the time taken by the old
+ * and the new implementation on the same data.
+ */
+
+#include "common/timeutils.h"
+
+#include "graphics/engine/triangle_bvh.h"
+
+#include "math/geometry.h"
+
+#include "object/crash_sphere.h"
+#include "object/object_interface_type.h"
+#include "object/object_part.h"
+#include "object/object_type.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using TimeUtils::TimeUnit;
+
+namespace
+{
+
+float Measure(const std::string& name, const std::function<void()>& run)
+{
+    auto start = TimeUtils::GetCurrentTimeStamp();
+    run();
+    auto end = TimeUtils::GetCurrentTimeStamp();
+
+    float time = TimeUtils::Diff<TimeUnit::MILLISECONDS>(start, end);
+    std::cout << "  " << name << ": " << time << " ms" << std::endl;
+    return time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Part transforms (COldObject::UpdateTransformObject)
+
+const int VEHICLE_COUNT = 500;
+const int FRAME_COUNT = 200;
+
+struct Vehicle
+{
+    ObjectPart parts[OBJECTMAXPART];
+    int totalPart = 0;
+    std::vector<int> order;
+};
+
+void AddPart(Vehicle& vehicle, int part, int parent, const glm::vec3& position)
+{
+    vehicle.parts[part].bUsed = true;
+    vehicle.parts[part].object = part;
+    vehicle.parts[part].parentPart = parent;
+    vehicle.parts[part].position = position;
+    vehicle.parts[part].zoom = glm::vec3(1.0f, 1.0f, 1.0f);
+    vehicle.totalPart = std::max(vehicle.totalPart, part + 1);
+}
+
+//! Wheeled grabber: chassis, arm with hand and fingers, 4 wheels and 4 mudguards
+Vehicle CreateVehicle()
+{
+    Vehicle vehicle;
+    AddPart(vehicle, 0, -1, { 0.0f, 1.0f, 0.0f });
+    AddPart(vehicle, 1, 0, { 0.0f, 1.5f, 0.0f });
+    AddPart(vehicle, 2, 1, { 0.0f, 0.0f, 0.0f });
+    AddPart(vehicle, 3, 2, { 3.0f, 0.0f, 0.0f });
+    AddPart(vehicle, 4, 3, { 3.5f, 0.0f, 0.0f });
+    AddPart(vehicle, 5, 4, { 1.0f, 0.0f, 0.5f });
+    AddPart(vehicle, 6, 4, { 1.0f, 0.0f, -0.5f });
+    for (int i = 0; i < 4; i++)
+    {
+        glm::vec3 position(i < 2 ? 2.0f : -2.0f, -0.5f, i % 2 == 0 ? 1.5f : -1.5f);
+        AddPart(vehicle, 7 + i, 0, position);
+        AddPart(vehicle, 11 + i, 0, position);
+    }
+    return vehicle;
+}
+
+void Animate(Vehicle& vehicle, int frame)
+{
+    float time = frame * 0.02f;
+    vehicle.parts[0].position.x = time;
+    vehicle.parts[0].bTranslate = true;
+    for (int part = 1; part <= 6; part++)
+    {
+        vehicle.parts[part].angle.z = std::sin(time + part);
+        vehicle.parts[part].bRotate = true;
+    }
+    for (int part = 7; part <= 10; part++)
+    {
+        vehicle.parts[part].angle.z = time * 3.0f;
+        vehicle.parts[part].bRotate = true;
+    }
+}
+
+//! Same as COldObject::UpdateTransformObject(int, bool), without vibrations and transporters
+bool UpdatePart(Vehicle& vehicle, int part, bool bForceUpdate)
+{
+    ObjectPart& p = vehicle.parts[part];
+    if (!bForceUpdate && !p.bTranslate && !p.bRotate) return false;
+
+    if (p.bTranslate || p.bRotate)
+    {
+        if (p.bTranslate)
+        {
+            p.matTranslate = glm::mat4(1.0f);
+            p.matTranslate[3][0] = p.position.x;
+            p.matTranslate[3][1] = p.position.y;
+            p.matTranslate[3][2] = p.position.z;
+        }
+        if (p.bRotate)
+            Math::LoadRotationZXYMatrix(p.matRotate, p.angle);
+        p.matTransform = p.matTranslate * p.matRotate;
+    }
+
+    if (p.parentPart == -1)
+        p.matWorld = p.matTransform;
+    else
+        p.matWorld = vehicle.parts[p.parentPart].matWorld * p.matTransform;
+
+    p.bTranslate = false;
+    p.bRotate = false;
+    return true;
+}
+
+//! Previous implementation: nested walk with a linear search for each child
+int SearchDescendant(const Vehicle& vehicle, int parent, int n)
+{
+    for (int i = 0; i < vehicle.totalPart; i++)
+    {
+        if (!vehicle.parts[i].bUsed) continue;
+        if (vehicle.parts[i].parentPart == parent && n-- == 0) return i;
+    }
+    return -1;
+}
+
+void UpdateNested(Vehicle& vehicle, std::vector<glm::mat4>& engine, int base)
+{
+    auto update = [&](int part, bool force)
+    {
+        bool modified = UpdatePart(vehicle, part, force);
+        if (modified)
+            engine[base + vehicle.parts[part].object] = vehicle.parts[part].matWorld;
+        return modified;
+    };
+
+    bool update1 = update(0, false);
+    for (int level1 = 0; ; level1++)
+    {
+        int rank1 = SearchDescendant(vehicle, 0, level1);
+        if (rank1 == -1) break;
+        bool update2 = update(rank1, update1);
+        for (int level2 = 0; ; level2++)
+        {
+            int rank2 = SearchDescendant(vehicle, rank1, level2);
+            if (rank2 == -1) break;
+            bool update3 = update(rank2, update2);
+            for (int level3 = 0; ; level3++)
+            {
+                int rank3 = SearchDescendant(vehicle, rank2, level3);
+                if (rank3 == -1) break;
+                bool update4 = update(rank3, update3);
+                for (int level4 = 0; ; level4++)
+                {
+                    int rank4 = SearchDescendant(vehicle, rank3, level4);
+                    if (rank4 == -1) break;
+                    update(rank4, update4);
+                }
+            }
+        }
+    }
+}
+
+//! Current implementation: one pass in precomputed order, batched submission
+void UpdateOrdered(Vehicle& vehicle, std::vector<glm::mat4>& engine, int base)
+{
+    int ranks[OBJECTMAXPART];
+    glm::mat4 transforms[OBJECTMAXPART];
+    bool updated[OBJECTMAXPART];
+    int count = 0;
+
+    for (int part : vehicle.order)
+    {
+        int parent = vehicle.parts[part].parentPart;
+        updated[part] = UpdatePart(vehicle, part, part != 0 && updated[parent]);
+        if (updated[part])
+        {
+            ranks[count] = vehicle.parts[part].object;
+            transforms[count] = vehicle.parts[part].matWorld;
+            count++;
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+        engine[base + ranks[i]] = transforms[i];
+}
+
+void BenchmarkTransforms()
+{
+    std::cout << "Part transforms, " << VEHICLE_COUNT << " vehicles, " << FRAME_COUNT << " frames" << std::endl;
+
+    std::vector<Vehicle> vehicles(VEHICLE_COUNT, CreateVehicle());
+    std::vector<glm::mat4> engineNested(VEHICLE_COUNT * OBJECTMAXPART, glm::mat4(1.0f));
+    std::vector<glm::mat4> engineOrdered = engineNested;
+
+    Measure("Nested walk", [&]()
+    {
+        for (int frame = 0; frame < FRAME_COUNT; frame++)
+        {
+            for (int i = 0; i < VEHICLE_COUNT; i++)
+            {
+                Animate(vehicles[i], frame);
+                UpdateNested(vehicles[i], engineNested, i * OBJECTMAXPART);
+            }
+        }
+    });
+
+    Measure("Ordered pass", [&]()
+    {
+        for (int frame = 0; frame < FRAME_COUNT; frame++)
+        {
+            for (int i = 0; i < VEHICLE_COUNT; i++)
+            {
+                if (vehicles[i].order.empty())
+                    ComputePartUpdateOrder(vehicles[i].parts, vehicles[i].totalPart, vehicles[i].order);
+                Animate(vehicles[i], frame);
+                UpdateOrdered(vehicles[i], engineOrdered, i * OBJECTMAXPART);
+            }
+        }
+    });
+
+    if (engineNested != engineOrdered)
+        std::cout << "  ERROR: results differ" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Crash spheres (CObject::GetAllCrashSpheres in CPhysics::ObjectAdapt)
+
+const int SPHERE_OBJECT_COUNT = 400;
+const int SPHERE_MOVING_COUNT = 60;
+const int SPHERE_FRAME_COUNT = 200;
+
+struct SphereObject
+{
+    std::vector<CrashSphere> crashSpheres;
+    glm::mat4 world = glm::mat4(1.0f);
+
+    std::vector<CrashSphere> worldCrashSpheres;
+    bool worldCrashSpheresValid = false;
+
+    void Move(const glm::vec3& position)
+    {
+        world[3][0] = position.x;
+        world[3][1] = position.y;
+        world[3][2] = position.z;
+        worldCrashSpheresValid = false;
+    }
+
+    //! Previous implementation: new vector on every call
+    std::vector<CrashSphere> GetAllCrashSpheresCopy()
+    {
+        std::vector<CrashSphere> all;
+        for (const auto& crashSphere : crashSpheres)
+        {
+            CrashSphere transformed = crashSphere;
+            transformed.sphere.pos = Math::Transform(world, transformed.sphere.pos);
+            all.push_back(transformed);
+        }
+        return all;
+    }
+
+    //! Current implementation: cached until the object moves
+    std::span<const CrashSphere> GetAllCrashSpheres()
+    {
+        if (!worldCrashSpheresValid)
+        {
+            worldCrashSpheres = crashSpheres;
+            for (auto& crashSphere : worldCrashSpheres)
+                crashSphere.sphere.pos = Math::Transform(world, crashSphere.sphere.pos);
+            worldCrashSpheresValid = true;
+        }
+        return worldCrashSpheres;
+    }
+};
+
+template<typename GetSpheres>
+int CollisionPass(std::vector<SphereObject>& objects, int frame, GetSpheres getSpheres)
+{
+    int collisions = 0;
+    // moving robots test collisions with all other objects, as in CPhysics::ObjectAdapt
+    for (int i = 0; i < SPHERE_MOVING_COUNT; i++)
+    {
+        float t = frame * 0.05f + i;
+        objects[i].Move(glm::vec3(std::cos(t) * 100.0f, 0.0f, std::sin(t) * 100.0f));
+
+        glm::vec3 position(objects[i].world[3][0], objects[i].world[3][1], objects[i].world[3][2]);
+        for (auto& other : objects)
+        {
+            if (&other == &objects[i]) continue;
+            for (const auto& crashSphere : getSpheres(other))
+            {
+                if (glm::distance(crashSphere.sphere.pos, position) < crashSphere.sphere.radius + 2.0f)
+                    collisions++;
+            }
+        }
+    }
+    return collisions;
+}
+
+void BenchmarkCrashSpheres()
+{
+    std::cout << "Crash spheres, " << SPHERE_OBJECT_COUNT << " objects (" << SPHERE_MOVING_COUNT
+              << " moving), " << SPHERE_FRAME_COUNT << " frames" << std::endl;
+
+    auto createObjects = []()
+    {
+        std::vector<SphereObject> objects(SPHERE_OBJECT_COUNT);
+        for (int i = 0; i < SPHERE_OBJECT_COUNT; i++)
+        {
+            for (int j = 0; j < 1 + i % 5; j++)
+                objects[i].crashSpheres.emplace_back(glm::vec3(j * 2.0f, 1.0f, 0.0f), 1.5f);
+            objects[i].Move(glm::vec3((i % 20) * 10.0f - 100.0f, 0.0f, (i / 20) * 10.0f - 100.0f));
+        }
+        return objects;
+    };
+
+    int before = 0, after = 0;
+    std::vector<SphereObject> objects = createObjects();
+    Measure("New vector per call", [&]()
+    {
+        for (int frame = 0; frame < SPHERE_FRAME_COUNT; frame++)
+            before += CollisionPass(objects, frame, [](SphereObject& o) { return o.GetAllCrashSpheresCopy(); });
+    });
+
+    objects = createObjects();
+    Measure("Cached spheres", [&]()
+    {
+        for (int frame = 0; frame < SPHERE_FRAME_COUNT; frame++)
+            after += CollisionPass(objects, frame, [](SphereObject& o) { return o.GetAllCrashSpheres(); });
+    });
+
+    if (before != after)
+        std::cout << "  ERROR: results differ" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Object registries (CObjectManager::GetObjectsOfType, GetObjectsImplementing)
+
+const int REGISTRY_OBJECT_COUNT = 1200;
+const int REGISTRY_FRAME_COUNT = 200;
+
+const ObjectType REGISTRY_VEHICLES[] = {
+    OBJECT_HUMAN,    OBJECT_MOBILEfa, OBJECT_MOBILEta, OBJECT_MOBILEwa, OBJECT_MOBILEia,
+    OBJECT_MOBILEfc, OBJECT_MOBILEtc, OBJECT_MOBILEwc, OBJECT_MOBILEic, OBJECT_MOBILErt,
+};
+
+//! Stand-in for CObject with the virtual calls done by the filtering loops
+class RegistryObject
+{
+public:
+    RegistryObject(int id, ObjectType type, const glm::vec3& position, bool transportable)
+        : m_id(id), m_type(type), m_position(position)
+    {
+        m_implementedInterfaces.fill(false);
+        m_implementedInterfaces[static_cast<int>(ObjectInterfaceType::Transportable)] = transportable;
+    }
+    virtual ~RegistryObject() = default;
+
+    int GetID() const { return m_id; }
+    virtual ObjectType GetType() { return m_type; }
+    virtual glm::vec3 GetPosition() { return m_position; }
+    bool Implements(ObjectInterfaceType type) const { return m_implementedInterfaces[static_cast<int>(type)]; }
+
+private:
+    int m_id;
+    ObjectType m_type;
+    glm::vec3 m_position;
+    ObjectInterfaceTypes m_implementedInterfaces;
+};
+
+struct Registry
+{
+    std::map<int, std::unique_ptr<RegistryObject>> objects;
+    std::map<ObjectType, std::vector<RegistryObject*>> byType;
+    std::array<std::vector<RegistryObject*>, static_cast<std::size_t>(ObjectInterfaceType::Max)> byInterface;
+
+    std::vector<RegistryObject*> GetObjectsOfTypes(std::initializer_list<ObjectType> types)
+    {
+        std::vector<RegistryObject*> result;
+        for (ObjectType type : types)
+        {
+            const auto& list = byType[type];
+            result.insert(result.end(), list.begin(), list.end());
+        }
+        std::sort(result.begin(), result.end(), [](RegistryObject* a, RegistryObject* b)
+        {
+            return a->GetID() < b->GetID();
+        });
+        return result;
+    }
+};
+
+Registry CreateRegistry()
+{
+    const ObjectType scenery[] = { OBJECT_TREE0, OBJECT_STONE, OBJECT_METAL, OBJECT_POWER, OBJECT_URANIUM, OBJECT_BULLET };
+
+    Registry registry;
+    for (int i = 0; i < REGISTRY_OBJECT_COUNT; i++)
+    {
+        ObjectType type = i % 10 == 0 ? REGISTRY_VEHICLES[(i / 10) % 10] : scenery[i % 6];
+        bool transportable = type == OBJECT_STONE || type == OBJECT_METAL || type == OBJECT_POWER || type == OBJECT_URANIUM;
+        glm::vec3 position((i % 40) * 5.0f, 0.0f, (i / 40) * 5.0f);
+
+        auto object = std::make_unique<RegistryObject>(i, type, position, transportable);
+        registry.byType[type].push_back(object.get());
+        if (transportable)
+            registry.byInterface[static_cast<int>(ObjectInterfaceType::Transportable)].push_back(object.get());
+        registry.objects[i] = std::move(object);
+    }
+    return registry;
+}
+
+//! One frame of searches as done by buildings (CAutoPowerStation::SearchVehicle, CAutoNest::SearchCargo)
+//! and robots grabbing things (CTaskManip::SearchTakeFrontObject)
+int SearchFrame(Registry& registry, int frame, bool useRegistry)
+{
+    int found = 0;
+    for (int i = 0; i < 30; i++)
+    {
+        glm::vec3 center(((frame + i * 7) % 40) * 5.0f, 0.0f, ((i * 13) % 30) * 5.0f);
+
+        if (useRegistry)
+        {
+            for (RegistryObject* object : registry.GetObjectsOfTypes({
+                    OBJECT_HUMAN,    OBJECT_MOBILEfa, OBJECT_MOBILEta, OBJECT_MOBILEwa, OBJECT_MOBILEia,
+                    OBJECT_MOBILEfc, OBJECT_MOBILEtc, OBJECT_MOBILEwc, OBJECT_MOBILEic, OBJECT_MOBILErt }))
+            {
+                if (glm::distance(object->GetPosition(), center) <= 5.0f) found++;
+            }
+            for (RegistryObject* object : registry.byType[OBJECT_BULLET])
+            {
+                if (glm::distance(object->GetPosition(), center) <= 1.0f) found++;
+            }
+            for (RegistryObject* object : registry.byInterface[static_cast<int>(ObjectInterfaceType::Transportable)])
+            {
+                if (glm::distance(object->GetPosition(), center) <= 4.0f) found++;
+            }
+            continue;
+        }
+
+        for (const auto& [id, object] : registry.objects)
+        {
+            ObjectType type = object->GetType();
+            if (std::find(std::begin(REGISTRY_VEHICLES), std::end(REGISTRY_VEHICLES), type) == std::end(REGISTRY_VEHICLES)) continue;
+            if (glm::distance(object->GetPosition(), center) <= 5.0f) found++;
+        }
+        for (const auto& [id, object] : registry.objects)
+        {
+            if (object->GetType() != OBJECT_BULLET) continue;
+            if (glm::distance(object->GetPosition(), center) <= 1.0f) found++;
+        }
+        for (const auto& [id, object] : registry.objects)
+        {
+            if (!object->Implements(ObjectInterfaceType::Transportable)) continue;
+            if (glm::distance(object->GetPosition(), center) <= 4.0f) found++;
+        }
+    }
+    return found;
+}
+
+void BenchmarkRegistries()
+{
+    std::cout << "Object registries, " << REGISTRY_OBJECT_COUNT << " objects, "
+              << REGISTRY_FRAME_COUNT << " frames" << std::endl;
+
+    Registry registry = CreateRegistry();
+
+    int before = 0, after = 0;
+    Measure("Scan all objects", [&]()
+    {
+        for (int frame = 0; frame < REGISTRY_FRAME_COUNT; frame++)
+            before += SearchFrame(registry, frame, false);
+    });
+    Measure("Registries", [&]()
+    {
+        for (int frame = 0; frame < REGISTRY_FRAME_COUNT; frame++)
+            after += SearchFrame(registry, frame, true);
+    });
+
+    if (before != after)
+        std::cout << "  ERROR: results differ" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Mouse picking (CEngine::DetectObject)
+
+const int PICK_OBJECT_COUNT = 300;
+const int PICK_MOUSE_COUNT = 200;
+
+struct PickScene
+{
+    //! Mesh shared by all objects, as consecutive triples of vertices
+    std::vector<glm::vec3> mesh;
+    glm::vec3 bboxMin{ 0, 0, 0 };
+    glm::vec3 bboxMax{ 0, 0, 0 };
+    std::vector<glm::mat4> transforms;
+    glm::mat4 view;
+    glm::mat4 proj;
+};
+
+//! Bumpy sphere of about 2000 triangles, roughly as detailed as a building
+std::vector<glm::vec3> CreatePickMesh()
+{
+    const int slices = 40, stacks = 25;
+    auto point = [](int i, int j)
+    {
+        float theta = Math::PI * 2.0f * i / slices;
+        float phi = Math::PI * j / stacks;
+        float radius = 4.0f + 0.3f * std::sin(theta * 5.0f) * std::sin(phi * 3.0f);
+        return glm::vec3(radius * std::sin(phi) * std::cos(theta), 4.0f + radius * std::cos(phi),
+                         radius * std::sin(phi) * std::sin(theta));
+    };
+
+    std::vector<glm::vec3> mesh;
+    for (int j = 0; j < stacks; j++)
+    {
+        for (int i = 0; i < slices; i++)
+        {
+            mesh.insert(mesh.end(), { point(i, j), point(i, j + 1), point(i + 1, j) });
+            mesh.insert(mesh.end(), { point(i + 1, j), point(i, j + 1), point(i + 1, j + 1) });
+        }
+    }
+    return mesh;
+}
+
+PickScene CreatePickScene()
+{
+    PickScene scene;
+    scene.mesh = CreatePickMesh();
+    for (const auto& vertex : scene.mesh)
+    {
+        scene.bboxMin = glm::min(scene.bboxMin, vertex);
+        scene.bboxMax = glm::max(scene.bboxMax, vertex);
+    }
+
+    for (int i = 0; i < PICK_OBJECT_COUNT; i++)
+    {
+        glm::mat4 transform = glm::mat4(1.0f);
+        Math::LoadRotationYMatrix(transform, i * 0.7f);
+        transform[3][0] = (i % 20) * 12.0f - 120.0f;
+        transform[3][2] = (i / 20) * 12.0f;
+        scene.transforms.push_back(transform);
+    }
+
+    Math::LoadViewMatrix(scene.view, glm::vec3(0.0f, 60.0f, -60.0f), glm::vec3(0.0f, 0.0f, 60.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Math::LoadProjectionMatrix(scene.proj, Math::PI / 4.0f, 4.0f / 3.0f, 1.0f, 1000.0f);
+    return scene;
+}
+
+//! Same as CEngine::TransformPoint
+bool ProjectPoint(const PickScene& scene, int object, const glm::vec3& point, glm::vec3& p2D)
+{
+    glm::vec3 p = Math::Transform(scene.view, Math::Transform(scene.transforms[object], point));
+    if (p.z < 2.0f)
+        return false;
+
+    p2D.x = ((p.x / p.z) * scene.proj[0][0] + 1.0f) / 2.0f;
+    p2D.y = ((p.y / p.z) * scene.proj[1][1] + 1.0f) / 2.0f;
+    p2D.z = p.z;
+    return true;
+}
+
+//! Previous implementation: projects the bounding box and then every triangle to the screen
+int PickProjected(const PickScene& scene, const glm::vec2& mouse)
+{
+    float min = 1000000.0f;
+    int nearest = -1;
+
+    for (int object = 0; object < static_cast<int>(scene.transforms.size()); object++)
+    {
+        glm::vec2 boxMin(1000000.0f, 1000000.0f), boxMax(-1000000.0f, -1000000.0f);
+        for (int i = 0; i < 8; i++)
+        {
+            glm::vec3 corner((i & 1) ? scene.bboxMin.x : scene.bboxMax.x,
+                             (i & 2) ? scene.bboxMin.y : scene.bboxMax.y,
+                             (i & 4) ? scene.bboxMin.z : scene.bboxMax.z);
+            glm::vec3 p2D;
+            if (ProjectPoint(scene, object, corner, p2D))
+            {
+                boxMin = glm::min(boxMin, glm::vec2(p2D));
+                boxMax = glm::max(boxMax, glm::vec2(p2D));
+            }
+        }
+        if (mouse.x < boxMin.x || mouse.x > boxMax.x || mouse.y < boxMin.y || mouse.y > boxMax.y)
+            continue;
+
+        for (int i = 0; i < static_cast<int>(scene.mesh.size()); i += 3)
+        {
+            glm::vec3 p2D[3];
+            if (!ProjectPoint(scene, object, scene.mesh[i + 0], p2D[0]) ||
+                !ProjectPoint(scene, object, scene.mesh[i + 1], p2D[1]) ||
+                !ProjectPoint(scene, object, scene.mesh[i + 2], p2D[2]))
+                continue;
+
+            if (!Math::IsInsideTriangle(glm::vec2(p2D[0]), glm::vec2(p2D[1]), glm::vec2(p2D[2]), mouse))
+                continue;
+
+            float dist = (p2D[0].z + p2D[1].z + p2D[2].z) / 3.0f;
+            if (dist < min)
+            {
+                min = dist;
+                nearest = object;
+            }
+        }
+    }
+    return nearest;
+}
+
+//! Current implementation: ray in object space against the bounding box and the hierarchy
+int PickRay(const PickScene& scene, const Gfx::CTriangleBVH& bvh, const glm::vec2& mouse)
+{
+    glm::mat4 viewInverse = glm::inverse(scene.view);
+    glm::vec3 origin = Math::Transform(viewInverse, glm::vec3(0.0f, 0.0f, 0.0f));
+    glm::vec3 dir = glm::mat3(viewInverse) * glm::vec3((mouse.x * 2.0f - 1.0f) / scene.proj[0][0],
+                                                       (mouse.y * 2.0f - 1.0f) / scene.proj[1][1], 1.0f);
+
+    float tMax = 1000000.0f;
+    int nearest = -1;
+    for (int object = 0; object < static_cast<int>(scene.transforms.size()); object++)
+    {
+        glm::mat4 worldInverse = glm::inverse(scene.transforms[object]);
+        glm::vec3 objOrigin = Math::Transform(worldInverse, origin);
+        glm::vec3 objDir = glm::mat3(worldInverse) * dir;
+
+        float boxMin = 2.0f, boxMax = tMax;
+        if (!Math::IntersectRayBox(objOrigin, 1.0f / objDir, scene.bboxMin, scene.bboxMax, boxMin, boxMax))
+            continue;
+
+        if (bvh.Intersect(objOrigin, objDir, 2.0f, tMax))
+            nearest = object;
+    }
+    return nearest;
+}
+
+void BenchmarkPicking()
+{
+    PickScene scene = CreatePickScene();
+    std::cout << "Mouse picking, " << PICK_OBJECT_COUNT << " objects of " << scene.mesh.size() / 3
+              << " triangles, " << PICK_MOUSE_COUNT << " mouse positions" << std::endl;
+
+    std::vector<glm::vec2> mouse;
+    for (int i = 0; i < PICK_MOUSE_COUNT; i++)
+        mouse.emplace_back(0.1f + 0.8f * ((i * 37) % 100) / 100.0f, 0.1f + 0.8f * ((i * 61) % 100) / 100.0f);
+
+    std::vector<int> before, after;
+    Measure("Projected triangles", [&]()
+    {
+        for (const auto& position : mouse)
+            before.push_back(PickProjected(scene, position));
+    });
+
+    std::unique_ptr<Gfx::CTriangleBVH> bvh;
+    Measure("Hierarchy build", [&]()
+    {
+        bvh = std::make_unique<Gfx::CTriangleBVH>(scene.mesh);
+    });
+    Measure("Ray cast", [&]()
+    {
+        for (const auto& position : mouse)
+            after.push_back(PickRay(scene, *bvh, position));
+    });
+
+    // the old code sorts by the average depth of triangles, so it may disagree on silhouettes
+    int same = 0;
+    for (int i = 0; i < PICK_MOUSE_COUNT; i++)
+    {
+        if (before[i] == after[i])
+            same++;
+    }
+    std::cout << "  Same object picked: " << same << "/" << PICK_MOUSE_COUNT << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::map<std::string, std::function<void()>> benchmarks = {
+        { "crashspheres", BenchmarkCrashSpheres },
+        { "picking", BenchmarkPicking },
+        { "registries", BenchmarkRegistries },
+        { "transforms", BenchmarkTransforms },
+    };
+
+    if (argc == 1)
+    {
+        for (const auto& [name, run] : benchmarks)
+            run();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        auto it = benchmarks.find(argv[i]);
+        if (it == benchmarks.end())
+        {
+            std::cerr << "Unknown benchmark: " << argv[i] << std::endl;
+            return 1;
+        }
+        it->second();
+    }
+    return 0;
+}